@@ -12,6 +12,7 @@ option(BUILD_METRICS        "Build Metrics, generate data for Grafana" OFF)
 option(BUILD_RECASTDEMOMOD  "Build map/vmap/mmap viewer"            OFF)
 option(BUILD_GIT_ID         "Build git_id"                          OFF)
 option(BUILD_DOCS           "Build documentation with doxygen"      OFF)
+option(BUILD_BENCHMARKS     "Build benchmarks and add them as tests" OFF)
 option(CMAKE_INTERPROCEDURAL_OPTIMIZATION "Enable link-time optimizations" OFF)
 
 # TODO: options that should be checked/created:
@@ -39,6 +40,7 @@ message(STATUS
     BUILD_RECASTDEMOMOD     Build map/vmap/mmap viewer
     BUILD_GIT_ID            Build git_id
     BUILD_DOCS              Build documentation with doxygen
+    BUILD_BENCHMARKS        Build benchmarks and add them as tests (run with ctest)
 
   To set an option simply type -D<OPTION>=<VALUE> after 'cmake <srcs>'.
   Also, you can specify the generator with -G. see 'cmake --help' for more details
@@ -91,6 +91,12 @@ else()
   message(STATUS "Build documentation   : No  (default)")
 endif()
 
+if(BUILD_BENCHMARKS)
+  message(STATUS "Build benchmarks      : Yes")
+else()
+  message(STATUS "Build benchmarks      : No  (default)")
+endif()
+
 # if(SQL)
 #   message(STATUS "Install SQL-files     : Yes")
 # else()
@@ -21,7 +21,7 @@
 
 DROP TABLE IF EXISTS `character_db_version`;
 CREATE TABLE `character_db_version` (
-  `required_14061_01_characters_fishingSteps` bit(1) DEFAULT NULL
+  `required_14081_01_characters_number_list_blobs` bit(1) DEFAULT NULL
 ) ENGINE=MyISAM DEFAULT CHARSET=utf8 ROW_FORMAT=DYNAMIC COMMENT='Last applied sql update to DB';
 
 --
@@ -1022,7 +1022,7 @@ CREATE TABLE `characters` (
   `map` int(11) unsigned NOT NULL DEFAULT '0' COMMENT 'Map Identifier',
   `dungeon_difficulty` tinyint(1) unsigned NOT NULL DEFAULT '0',
   `orientation` float NOT NULL DEFAULT '0',
-  `taximask` longtext,
+  `taximask` longblob,
   `online` tinyint(3) unsigned NOT NULL DEFAULT '0',
   `cinematic` tinyint(3) unsigned NOT NULL DEFAULT '0',
   `totaltime` int(11) unsigned NOT NULL DEFAULT '0',
@@ -1064,10 +1064,10 @@ CREATE TABLE `characters` (
   `power7` int(10) unsigned NOT NULL DEFAULT '0',
   `specCount` tinyint(3) unsigned NOT NULL DEFAULT '1',
   `activeSpec` tinyint(3) unsigned NOT NULL DEFAULT '0',
-  `exploredZones` longtext,
-  `equipmentCache` longtext,
+  `exploredZones` longblob,
+  `equipmentCache` longblob,
   `ammoId` int(10) unsigned NOT NULL DEFAULT '0',
-  `knownTitles` longtext,
+  `knownTitles` longblob,
   `actionBars` tinyint(3) unsigned NOT NULL DEFAULT '0',
   `grantableLevels` INT UNSIGNED DEFAULT '0',
   `fishingSteps` TINYINT UNSIGNED NOT NULL DEFAULT '0',
@@ -1640,7 +1640,7 @@ CREATE TABLE `item_instance` (
   `duration` int(10) unsigned NOT NULL default '0',
   `charges` text NOT NULL,
   `flags` int(8) unsigned NOT NULL default '0',
-  `enchantments` text NOT NULL,
+  `enchantments` blob NOT NULL,
   `randomPropertyId` smallint(5) NOT NULL default '0',
   `durability` int(5) unsigned NOT NULL default '0',
   `playedTime` int(10) unsigned NOT NULL default '0',
@@ -0,0 +1,10 @@
+ALTER TABLE character_db_version CHANGE COLUMN required_14061_01_characters_fishingSteps required_14081_01_characters_number_list_blobs bit;
+
+-- binary number lists (PlayerSave.BinaryNumberLists) are not valid utf8, the text lists keep their bytes
+ALTER TABLE characters
+  MODIFY COLUMN `taximask` longblob,
+  MODIFY COLUMN `exploredZones` longblob,
+  MODIFY COLUMN `equipmentCache` longblob,
+  MODIFY COLUMN `knownTitles` longblob;
+
+ALTER TABLE item_instance MODIFY COLUMN `enchantments` blob NOT NULL;
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MicroBenchmark.h"
+#include "Util/AliasTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// AHBot item pool: thousands of candidates with drop chance weights, most of them rare
+namespace
+{
+    uint32 const ALIAS_ITEMS = 20000;
+    uint64 const ALIAS_SAMPLES = 10000000;
+    uint32 const ALIAS_LINEAR_DIVISOR = 100;                // the linear pick is far slower, use fewer samples for it
+
+    std::vector<double> BuildItemWeights()
+    {
+        // drop chances spread like loot tables: few common items, a long tail of rare ones
+        std::mt19937 random(1);
+        std::exponential_distribution<double> chance(0.5);
+        std::vector<double> weights(ALIAS_ITEMS);
+        for (double& weight : weights)
+            weight = std::min(100.0, chance(random) * chance(random) * 10.0);
+        return weights;
+    }
+
+    // the pick an item pool needs without a precomputed table: walk the weights until the roll is used up
+    uint32 LinearPick(std::vector<double> const& weights, double total)
+    {
+        double roll = rand_norm() * total;
+        for (uint32 i = 0; i < weights.size(); ++i)
+        {
+            if (roll < weights[i])
+                return i;
+            roll -= weights[i];
+        }
+        return uint32(weights.size() - 1);
+    }
+
+    // same with a cumulative table and a binary search
+    uint32 CumulativePick(std::vector<double> const& cumulative)
+    {
+        double roll = rand_norm() * cumulative.back();
+        return uint32(std::upper_bound(cumulative.begin(), cumulative.end(), roll) - cumulative.begin());
+    }
+}
+
+MICRO_BENCHMARK(alias_table, "AliasTable against linear and binary search weighted picks")
+{
+    uint64 const samples = MicroBenchmark::Scaled(options, ALIAS_SAMPLES);
+    uint64 const linearSamples = MicroBenchmark::Scaled(options, ALIAS_SAMPLES / ALIAS_LINEAR_DIVISOR);
+    std::vector<double> const weights = BuildItemWeights();
+
+    AliasTable table;
+    MicroBenchmark::Measure("AliasTable build", ALIAS_ITEMS, [&]() { table.Build(weights); });
+
+    std::vector<double> cumulative(weights.size());
+    double total = 0.0;
+    for (uint32 i = 0; i < weights.size(); ++i)
+        cumulative[i] = total += weights[i];
+
+    std::vector<uint32> counts(weights.size(), 0);
+    double aliasTime = MicroBenchmark::Measure("AliasTable sample", samples, [&]()
+    {
+        for (uint64 i = 0; i < samples; ++i)
+            ++counts[table.Sample()];
+    });
+
+    uint64 sum = 0;
+    double cumulativeTime = MicroBenchmark::Measure("cumulative binary search pick", samples, [&]()
+    {
+        for (uint64 i = 0; i < samples; ++i)
+            sum += CumulativePick(cumulative);
+    });
+    double linearTime = MicroBenchmark::Measure("linear weighted pick", linearSamples, [&]()
+    {
+        for (uint64 i = 0; i < linearSamples; ++i)
+            sum += LinearPick(weights, total);
+    });
+    MicroBenchmark::sink += sum;
+
+    MicroBenchmark::PrintSpeedup("AliasTable speedup over binary search", cumulativeTime, aliasTime);
+    MicroBenchmark::PrintSpeedup("AliasTable speedup over linear pick", linearTime, aliasTime);
+
+    // the heaviest item must come up with its weight, too few samples for a check in quick runs
+    if (samples < 1000000)
+        return 0;
+
+    uint32 heaviest = uint32(std::max_element(weights.begin(), weights.end()) - weights.begin());
+    double expected = samples * weights[heaviest] / total;
+    if (std::abs(counts[heaviest] - expected) > expected * 0.1)
+    {
+        printf("  heaviest item sampled %u times, expected %.0f\n", counts[heaviest], expected);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MicroBenchmark.h"
+#include "Entities/GuidFlatSet.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+// Player client guid set during visibility updates: per tick every object around is looked up
+// (HasAtClient), a few objects enter and leave and the set is walked once
+namespace
+{
+    uint32 const GUID_CLIENT_OBJECTS = 1000;                // objects at client
+    uint32 const GUID_CANDIDATES = 2000;                    // objects checked per tick, half of them at client
+    uint32 const GUID_CHURN = 50;                           // objects entering and leaving per tick
+    uint64 const GUID_LOOKUPS = 20000000;
+
+    struct GuidSequence
+    {
+        GuidSequence()
+        {
+            // players, creatures and gameobjects with sequential counters like in a real world
+            for (uint32 i = 1; i <= GUID_CANDIDATES + GUID_CHURN; ++i)
+            {
+                switch (i % 3)
+                {
+                    case 0: guids.push_back(ObjectGuid(HIGHGUID_PLAYER, i)); break;
+                    case 1: guids.push_back(ObjectGuid(HIGHGUID_UNIT, 1000 + i % 50, 100000 + i)); break;
+                    default: guids.push_back(ObjectGuid(HIGHGUID_GAMEOBJECT, 2000 + i % 20, 200000 + i)); break;
+                }
+            }
+            std::mt19937 random(1);
+            std::shuffle(guids.begin(), guids.end(), random);
+        }
+
+        std::vector<ObjectGuid> guids;
+    };
+
+    template<typename Set>
+    uint64 RunGuidSetWorkload(GuidSequence const& sequence, uint64 lookups)
+    {
+        std::vector<ObjectGuid> const& guids = sequence.guids;
+        Set set;
+        for (uint32 i = 0; i < GUID_CLIENT_OBJECTS; ++i)
+            set.insert(guids[i]);
+
+        uint64 hits = 0;
+        uint32 leaving = 0;
+        uint32 entering = GUID_CLIENT_OBJECTS;
+        for (uint64 done = 0; done < lookups; done += GUID_CANDIDATES)
+        {
+            for (uint32 i = 0; i < GUID_CANDIDATES; ++i)
+                hits += set.count(guids[i]);
+
+            // the oldest objects leave, the next ones enter, so the set size stays the same
+            for (uint32 i = 0; i < GUID_CHURN; ++i)
+            {
+                set.erase(guids[leaving]);
+                set.insert(guids[entering]);
+                leaving = (leaving + 1) % guids.size();
+                entering = (entering + 1) % guids.size();
+            }
+
+            for (ObjectGuid const& guid : set)
+                hits += guid.GetCounter() & 1;
+        }
+        return hits;
+    }
+}
+
+MICRO_BENCHMARK(guid_set, "GuidFlatSet against std::set for the client guid set")
+{
+    uint64 const lookups = MicroBenchmark::Scaled(options, GUID_LOOKUPS);
+    GuidSequence sequence;
+    uint64 flatHits = 0, setHits = 0;
+
+    double flatTime = MicroBenchmark::Measure("GuidFlatSet lookup/churn/iterate", lookups, [&]()
+    {
+        flatHits = RunGuidSetWorkload<GuidFlatSet>(sequence, lookups);
+    });
+    double setTime = MicroBenchmark::Measure("std::set lookup/churn/iterate", lookups, [&]()
+    {
+        setHits = RunGuidSetWorkload<GuidSet>(sequence, lookups);
+    });
+
+    MicroBenchmark::PrintSpeedup("GuidFlatSet speedup", setTime, flatTime);
+    MicroBenchmark::sink += flatHits;
+
+    if (flatHits != setHits)
+    {
+        printf("  lookup results differ between the sets\n");
+        return 1;
+    }
+    return 0;
+}
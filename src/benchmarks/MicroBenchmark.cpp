@@ -0,0 +1,139 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MicroBenchmark.h"
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+volatile uint64 MicroBenchmark::sink = 0;
+
+namespace
+{
+    struct MicroBenchmarkEntry
+    {
+        std::string description;
+        MicroBenchmarkFunc func;
+    };
+
+    // function local so registrars in other translation units can use it during static initialization
+    std::map<std::string, MicroBenchmarkEntry>& GetMicroBenchmarks()
+    {
+        static std::map<std::string, MicroBenchmarkEntry> benchmarks;
+        return benchmarks;
+    }
+}
+
+MicroBenchmarkRegistrar::MicroBenchmarkRegistrar(char const* name, char const* description, MicroBenchmarkFunc func)
+{
+    GetMicroBenchmarks()[name] = { description, func };
+}
+
+/// Launch the benchmarks given on the command line, all of them by default
+int main(int argc, char* argv[])
+{
+    MicroBenchmarkOptions options;
+    std::vector<std::string> names;
+
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+    ("help,h", "print usage message")
+    ("list,l", "list the benchmarks")
+    ("scale,s", boost::program_options::value<double>(&options.scale)->default_value(1.0), "multiply the operation counts, e.g. 0.1 for a quick run")
+    ("data,d", boost::program_options::value<std::string>(&options.dataDir), "server data directory for the benchmarks on client data")
+    ("map,m", boost::program_options::value<uint32>(&options.mapId)->default_value(0), "map of the vmap benchmarks")
+    ("tile-x,x", boost::program_options::value<uint32>(&options.tileX)->default_value(32), "grid x of the vmap benchmarks")
+    ("tile-y,y", boost::program_options::value<uint32>(&options.tileY)->default_value(48), "grid y of the vmap benchmarks");
+
+    boost::program_options::options_description hidden;
+    hidden.add_options()
+    ("benchmark", boost::program_options::value<std::vector<std::string>>(&names));
+
+    boost::program_options::options_description all;
+    all.add(desc).add(hidden);
+
+    boost::program_options::positional_options_description positional;
+    positional.add("benchmark", -1);
+
+    boost::program_options::variables_map vm;
+
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv).options(all).positional(positional).run(), vm);
+        boost::program_options::notify(vm);
+    }
+    catch (boost::program_options::error const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    if (vm.count("help"))
+    {
+        std::cout << "Usage: " << argv[0] << " [options] [benchmark ...]" << std::endl << desc << std::endl;
+        return 0;
+    }
+
+    std::map<std::string, MicroBenchmarkEntry> const& benchmarks = GetMicroBenchmarks();
+
+    if (vm.count("list"))
+    {
+        for (auto const& benchmark : benchmarks)
+            printf("%-24s %s\n", benchmark.first.c_str(), benchmark.second.description.c_str());
+        return 0;
+    }
+
+    if (names.empty())
+        for (auto const& benchmark : benchmarks)
+            names.push_back(benchmark.first);
+
+    int result = 0;
+    uint32 skipped = 0;
+    for (std::string const& name : names)
+    {
+        auto itr = benchmarks.find(name);
+        if (itr == benchmarks.end())
+        {
+            std::cerr << "Unknown benchmark " << name << ", see --list" << std::endl;
+            return 1;
+        }
+
+        printf("%s: %s\n", name.c_str(), itr->second.description.c_str());
+        int benchmarkResult = itr->second.func(options);
+        if (benchmarkResult == MICRO_BENCHMARK_SKIPPED)
+        {
+            printf("  skipped\n");
+            ++skipped;
+        }
+        else if (benchmarkResult != 0)
+        {
+            printf("  FAILED\n");
+            result = 1;
+        }
+        printf("\n");
+    }
+
+    // only report a skip when nothing else ran, a single skipped benchmark in a full run is not an error
+    if (!result && skipped && skipped == names.size())
+        return MICRO_BENCHMARK_SKIPPED;
+    return result;
+}
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MICRO_BENCHMARK_H
+#define _MICRO_BENCHMARK_H
+
+#include "Common.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// Exit code of a benchmark that cannot run here (e.g. missing client data), ctest reports it as skipped
+#define MICRO_BENCHMARK_SKIPPED 77
+
+struct MicroBenchmarkOptions
+{
+    MicroBenchmarkOptions() : scale(1.0), mapId(0), tileX(32), tileY(48) {}
+
+    double scale;                                           // multiplies the operation counts, < 1 for quick runs
+    std::string dataDir;                                    // server data dir (vmaps/ ...) for benchmarks on real data
+    uint32 mapId;
+    uint32 tileX, tileY;                                    // grid of the vmap tile used by the vmap benchmarks
+};
+
+// returns 0 on success, MICRO_BENCHMARK_SKIPPED or any other value for failure
+typedef int (*MicroBenchmarkFunc)(MicroBenchmarkOptions const& options);
+
+// registers a benchmark from a static object in its translation unit
+struct MicroBenchmarkRegistrar
+{
+    MicroBenchmarkRegistrar(char const* name, char const* description, MicroBenchmarkFunc func);
+};
+
+#define MICRO_BENCHMARK(name, description) \
+    static int MicroBenchmark_##name(MicroBenchmarkOptions const& options); \
+    static MicroBenchmarkRegistrar microBenchmarkRegistrar_##name(#name, description, &MicroBenchmark_##name); \
+    static int MicroBenchmark_##name(MicroBenchmarkOptions const& options)
+
+namespace MicroBenchmark
+{
+    // results are added here so the compiler cannot drop the measured work
+    extern volatile uint64 sink;
+
+    inline uint64 Scaled(MicroBenchmarkOptions const& options, uint64 count)
+    {
+        uint64 scaled = uint64(count * options.scale);
+        return scaled ? scaled : 1;
+    }
+
+    // runs func once and prints the time per operation, returns ns per operation
+    template<typename Func>
+    double Measure(char const* name, uint64 operations, Func&& func)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        func();
+        double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        double perOp = ns / double(operations);
+        printf("  %-44s %12.2f ns/op %10.1f ms  (%llu ops)\n", name, perOp, ns / 1000000.0, (unsigned long long)operations);
+        return perOp;
+    }
+
+    inline void PrintSpeedup(char const* what, double before, double after)
+    {
+        printf("  %-44s %12.2fx\n", what, after > 0.0 ? before / after : 0.0);
+    }
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MicroBenchmark.h"
+#include "Entities/Item.h"
+#include "Entities/Player.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Login and save of the number list columns (PlayerSave.BinaryNumberLists) for a population of characters
+namespace
+{
+    uint32 const LIST_CHARACTERS = 10000;
+    uint32 const LIST_ITEMS_PER_CHARACTER = 60;             // equipped, bags and bank
+
+    uint32 const EQUIPMENT_CACHE_SIZE = EQUIPMENT_SLOT_END * 2 + 2;
+    uint32 const ENCHANTMENTS_SIZE = MAX_ENCHANTMENT_SLOT * MAX_ENCHANTMENT_OFFSET;
+
+    struct CharacterLists
+    {
+        uint32 taximask[TaxiMaskSize];
+        uint32 exploredZones[PLAYER_EXPLORED_ZONES_SIZE];
+        uint32 equipmentCache[EQUIPMENT_CACHE_SIZE];
+        uint32 knownTitles[KNOWN_TITLES_SIZE * 2];
+        uint32 enchantments[LIST_ITEMS_PER_CHARACTER][ENCHANTMENTS_SIZE];
+    };
+
+    uint32 RandomBits(std::mt19937& random, float chance)
+    {
+        std::bernoulli_distribution bit(chance);
+        uint32 value = 0;
+        for (uint32 i = 0; i < 32; ++i)
+            if (bit(random))
+                value |= 1u << i;
+        return value;
+    }
+
+    // levelled characters: a third of the world explored, some flight paths, few titles, most items without enchantments
+    void FillCharacter(std::mt19937& random, CharacterLists& lists)
+    {
+        std::uniform_int_distribution<uint32> itemId(2000, 50000);
+        std::uniform_int_distribution<uint32> enchantId(1, 3900);
+        std::uniform_int_distribution<uint32> duration(0, 3600000);
+        std::bernoulli_distribution enchanted(0.3);
+
+        for (uint32& value : lists.taximask)
+            value = RandomBits(random, 0.2f);
+        for (uint32& value : lists.exploredZones)
+            value = RandomBits(random, 0.35f);
+        for (uint32 i = 0; i < EQUIPMENT_CACHE_SIZE; i += 2)
+        {
+            lists.equipmentCache[i] = enchanted(random) ? 0 : itemId(random);
+            lists.equipmentCache[i + 1] = enchanted(random) ? enchantId(random) : 0;
+        }
+        for (uint32& value : lists.knownTitles)
+            value = RandomBits(random, 0.02f);
+        for (auto& item : lists.enchantments)
+        {
+            std::fill(std::begin(item), std::end(item), 0);
+            if (enchanted(random))
+                item[PERM_ENCHANTMENT_SLOT * MAX_ENCHANTMENT_OFFSET + ENCHANTMENT_ID_OFFSET] = enchantId(random);
+            if (enchanted(random))
+            {
+                item[TEMP_ENCHANTMENT_SLOT * MAX_ENCHANTMENT_OFFSET + ENCHANTMENT_ID_OFFSET] = enchantId(random);
+                item[TEMP_ENCHANTMENT_SLOT * MAX_ENCHANTMENT_OFFSET + ENCHANTMENT_DURATION_OFFSET] = duration(random);
+            }
+        }
+    }
+
+    // the column strings of one character, as the database returns them at login
+    struct CharacterRow
+    {
+        std::string taximask;
+        std::string exploredZones;
+        std::string equipmentCache;
+        std::string knownTitles;
+        std::vector<std::string> enchantments;
+    };
+
+    void SaveCharacter(CharacterLists const& lists, CharacterRow& row, bool binary)
+    {
+        row.taximask.clear();
+        AppendUInt32List(row.taximask, lists.taximask, TaxiMaskSize, binary);
+        row.exploredZones.clear();
+        AppendUInt32List(row.exploredZones, lists.exploredZones, PLAYER_EXPLORED_ZONES_SIZE, binary);
+        row.equipmentCache.clear();
+        AppendUInt32List(row.equipmentCache, lists.equipmentCache, EQUIPMENT_CACHE_SIZE, binary);
+        row.knownTitles.clear();
+        AppendUInt32List(row.knownTitles, lists.knownTitles, KNOWN_TITLES_SIZE * 2, binary);
+        row.enchantments.resize(LIST_ITEMS_PER_CHARACTER);
+        for (uint32 i = 0; i < LIST_ITEMS_PER_CHARACTER; ++i)
+        {
+            row.enchantments[i].clear();
+            AppendUInt32List(row.enchantments[i], lists.enchantments[i], ENCHANTMENTS_SIZE, binary);
+        }
+    }
+
+    bool LoadCharacter(CharacterRow const& row, CharacterLists& lists)
+    {
+        bool valid = ParseUInt32List(row.taximask.c_str(), lists.taximask, TaxiMaskSize) == TaxiMaskSize;
+        valid &= ParseUInt32List(row.exploredZones.c_str(), lists.exploredZones, PLAYER_EXPLORED_ZONES_SIZE) == PLAYER_EXPLORED_ZONES_SIZE;
+        valid &= ParseUInt32List(row.equipmentCache.c_str(), lists.equipmentCache, EQUIPMENT_CACHE_SIZE) == EQUIPMENT_CACHE_SIZE;
+        valid &= ParseUInt32List(row.knownTitles.c_str(), lists.knownTitles, KNOWN_TITLES_SIZE * 2) == KNOWN_TITLES_SIZE * 2;
+        for (uint32 i = 0; i < LIST_ITEMS_PER_CHARACTER; ++i)
+            valid &= ParseUInt32List(row.enchantments[i].c_str(), lists.enchantments[i], ENCHANTMENTS_SIZE) == ENCHANTMENTS_SIZE;
+        return valid;
+    }
+
+    uint64 RowSize(CharacterRow const& row)
+    {
+        uint64 size = row.taximask.size() + row.exploredZones.size() + row.equipmentCache.size() + row.knownTitles.size();
+        for (std::string const& enchantments : row.enchantments)
+            size += enchantments.size();
+        return size;
+    }
+}
+
+MICRO_BENCHMARK(number_lists, "login/save replay of the number list columns, text against binary")
+{
+    uint32 const characters = uint32(MicroBenchmark::Scaled(options, LIST_CHARACTERS));
+    std::mt19937 random(1);
+
+    std::vector<CharacterLists> population(characters);
+    for (CharacterLists& lists : population)
+        FillCharacter(random, lists);
+
+    bool valid = true;
+    double times[2][2];
+    for (uint32 binary = 0; binary < 2; ++binary)
+    {
+        std::vector<CharacterRow> rows(characters);
+        std::string const name = binary ? "binary" : "text";
+
+        times[binary][0] = MicroBenchmark::Measure((name + " save").c_str(), characters, [&]()
+        {
+            for (uint32 i = 0; i < characters; ++i)
+                SaveCharacter(population[i], rows[i], binary != 0);
+        });
+
+        CharacterLists loaded;
+        times[binary][1] = MicroBenchmark::Measure((name + " login").c_str(), characters, [&]()
+        {
+            for (uint32 i = 0; i < characters; ++i)
+            {
+                valid &= LoadCharacter(rows[i], loaded);
+                MicroBenchmark::sink += loaded.exploredZones[i % PLAYER_EXPLORED_ZONES_SIZE];
+            }
+        });
+
+        // every list must come back unchanged
+        for (uint32 i = 0; i < characters && valid; ++i)
+            valid = LoadCharacter(rows[i], loaded) && memcmp(&loaded, &population[i], sizeof(loaded)) == 0;
+
+        uint64 size = 0;
+        for (CharacterRow const& row : rows)
+            size += RowSize(row);
+        printf("  %-44s %12.0f bytes/character\n", (name + " size").c_str(), double(size) / characters);
+    }
+
+    MicroBenchmark::PrintSpeedup("binary save speedup", times[0][0], times[1][0]);
+    MicroBenchmark::PrintSpeedup("binary login speedup", times[0][1], times[1][1]);
+
+    if (!valid)
+    {
+        printf("  lists differ after a save and login\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MicroBenchmark.h"
+#include "Utilities/TimerWheel.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+// Steady state event queue like the map script schedule: a fixed population of timers, every expired
+// timer is scheduled again and some pending ones are moved (cancel + schedule) every tick
+namespace
+{
+    uint32 const TIMER_POPULATION = 100000;
+    uint64 const TIMER_EXPIRATIONS = 1000000;
+    uint32 const TIMER_TICK = 50;                           // ms per world tick
+    uint32 const TIMER_MAX_DELAY = 60000;
+    uint32 const TIMER_MOVES_PER_TICK = 20;
+
+    struct WheelEvent : public TimerWheelNode
+    {
+        uint32 id;
+    };
+
+    struct MapEvent
+    {
+        typedef std::multimap<uint64, MapEvent*> Queue;
+
+        uint32 id;
+        Queue::iterator itr;
+    };
+
+    // same delays and moved timers for both queues
+    struct TimerSequence
+    {
+        explicit TimerSequence(uint32 size) : delays(size), moves(size), next(0)
+        {
+            std::mt19937 random(1);
+            std::uniform_int_distribution<uint32> delay(1, TIMER_MAX_DELAY);
+            std::uniform_int_distribution<uint32> event(0, TIMER_POPULATION - 1);
+            for (uint32 i = 0; i < size; ++i)
+            {
+                delays[i] = delay(random);
+                moves[i] = event(random);
+            }
+        }
+
+        uint32 NextDelay() { return delays[next++ % delays.size()]; }
+        uint32 NextMove() { return moves[next++ % moves.size()]; }
+
+        std::vector<uint32> delays;
+        std::vector<uint32> moves;
+        size_t next;
+    };
+}
+
+MICRO_BENCHMARK(timer_wheel, "TimerWheel against std::multimap as event queue")
+{
+    uint64 const expirations = MicroBenchmark::Scaled(options, TIMER_EXPIRATIONS);
+    uint64 wheelSum = 0, mapSum = 0;
+
+    double wheelTime = MicroBenchmark::Measure("TimerWheel schedule/advance/pop", expirations, [&]()
+    {
+        TimerSequence sequence(1 << 16);
+        std::vector<WheelEvent> events(TIMER_POPULATION);
+        TimerWheel wheel;
+        for (uint32 i = 0; i < TIMER_POPULATION; ++i)
+        {
+            events[i].id = i;
+            wheel.Schedule(&events[i], sequence.NextDelay());
+        }
+
+        uint64 now = 0;
+        uint64 fired = 0;
+        while (fired < expirations)
+        {
+            now += TIMER_TICK;
+            for (uint32 i = 0; i < TIMER_MOVES_PER_TICK; ++i)
+            {
+                WheelEvent& event = events[sequence.NextMove()];
+                wheel.Cancel(&event);
+                wheel.Schedule(&event, now + sequence.NextDelay());
+            }
+
+            wheel.Advance(now);
+            while (WheelEvent* event = static_cast<WheelEvent*>(wheel.PopExpired(now)))
+            {
+                wheelSum += event->id * now;
+                ++fired;
+                wheel.Schedule(event, now + sequence.NextDelay());
+            }
+        }
+    });
+
+    double mapTime = MicroBenchmark::Measure("std::multimap insert/erase", expirations, [&]()
+    {
+        TimerSequence sequence(1 << 16);
+        std::vector<MapEvent> events(TIMER_POPULATION);
+        MapEvent::Queue queue;
+        for (uint32 i = 0; i < TIMER_POPULATION; ++i)
+        {
+            events[i].id = i;
+            events[i].itr = queue.emplace(sequence.NextDelay(), &events[i]);
+        }
+
+        uint64 now = 0;
+        uint64 fired = 0;
+        while (fired < expirations)
+        {
+            now += TIMER_TICK;
+            for (uint32 i = 0; i < TIMER_MOVES_PER_TICK; ++i)
+            {
+                MapEvent& event = events[sequence.NextMove()];
+                queue.erase(event.itr);
+                event.itr = queue.emplace(now + sequence.NextDelay(), &event);
+            }
+
+            while (!queue.empty() && queue.begin()->first <= now)
+            {
+                MapEvent* event = queue.begin()->second;
+                queue.erase(queue.begin());
+                mapSum += event->id * now;
+                ++fired;
+                event->itr = queue.emplace(now + sequence.NextDelay(), event);
+            }
+        }
+    });
+
+    MicroBenchmark::PrintSpeedup("TimerWheel speedup", mapTime, wheelTime);
+    MicroBenchmark::sink += wheelSum;
+
+    // both queues must fire the same timers at the same ticks
+    if (wheelSum != mapSum)
+    {
+        printf("  expiry order differs between the queues\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MicroBenchmark.h"
+#include "Vmap/VMapManager2.h"
+#include "Vmap/VMapSimd.h"
+#include "Vmap/WorldModel.h"
+#include "Maps/GridDefines.h"
+
+#include <random>
+#include <vector>
+
+using namespace VMAP;
+
+namespace
+{
+    uint64 const VMAP_KERNEL_QUERIES = 20000000;
+    uint64 const VMAP_LOS_QUERIES = 1000000;
+    uint32 const VMAP_TRIANGLES = 1024;
+    uint32 const VMAP_BOXES = 1024;
+
+    G3D::Vector3 RandomPoint(std::mt19937& random, float size)
+    {
+        std::uniform_real_distribution<float> coord(-size, size);
+        return G3D::Vector3(coord(random), coord(random), coord(random));
+    }
+
+    G3D::Ray RandomRay(std::mt19937& random, float size)
+    {
+        G3D::Vector3 origin = RandomPoint(random, size);
+        G3D::Vector3 target = RandomPoint(random, size);
+        return G3D::Ray::fromOriginAndDirection(origin, (target - origin).direction());
+    }
+}
+
+// Kernels on synthetic geometry, against the scalar code they replaced in the BIH leaves and model bounds
+MICRO_BENCHMARK(vmap_kernels, "SIMD ray/box and ray/triangle kernels against the scalar tests")
+{
+    uint64 const queries = MicroBenchmark::Scaled(options, VMAP_KERNEL_QUERIES);
+    std::mt19937 random(1);
+
+    std::vector<G3D::AABox> boxes;
+    for (uint32 i = 0; i < VMAP_BOXES; ++i)
+    {
+        G3D::Vector3 corner = RandomPoint(random, 50.f);
+        G3D::Vector3 size = RandomPoint(random, 10.f);
+        boxes.push_back(G3D::AABox(corner.min(corner + size), corner.max(corner + size)));
+    }
+
+    std::vector<G3D::Vector3> vertices;
+    std::vector<MeshTriangle> triangles;
+    for (uint32 i = 0; i < VMAP_TRIANGLES; ++i)
+    {
+        G3D::Vector3 corner = RandomPoint(random, 50.f);
+        uint32 first = uint32(vertices.size());
+        vertices.push_back(corner);
+        vertices.push_back(corner + RandomPoint(random, 20.f));
+        vertices.push_back(corner + RandomPoint(random, 20.f));
+        triangles.push_back(MeshTriangle(first, first + 1, first + 2));
+    }
+
+    std::vector<G3D::Ray> rays;
+    for (uint32 i = 0; i < 4096; ++i)
+        rays.push_back(RandomRay(random, 60.f));
+
+    uint32 scalarBoxHits = 0, simdBoxHits = 0;
+    double scalarBoxTime = MicroBenchmark::Measure("G3D::Ray::intersectionTime box", queries, [&]()
+    {
+        for (uint64 i = 0; i < queries; ++i)
+        {
+            float time = rays[i % rays.size()].intersectionTime(boxes[i % boxes.size()]);
+            scalarBoxHits += time != G3D::inf() && time <= 100.f;
+        }
+    });
+    double simdBoxTime = MicroBenchmark::Measure("IntersectRayBox", queries, [&]()
+    {
+        for (uint64 i = 0; i < queries; ++i)
+        {
+            G3D::Ray const& ray = rays[i % rays.size()];
+            simdBoxHits += IntersectRayBox(ray.origin(), ray.invDirection(), boxes[i % boxes.size()], 100.f) >= 0.f;
+        }
+    });
+
+    // one leaf of SIMD_TRIANGLES triangles per query, like GModelRayCallback::IntersectLeaf
+    uint64 const leaves = queries / SIMD_TRIANGLES;
+    float scalarDistance = 0.f, simdDistance = 0.f;
+    double scalarTriangleTime = MicroBenchmark::Measure("IntersectTriangle leaf", leaves, [&]()
+    {
+        for (uint64 i = 0; i < leaves; ++i)
+        {
+            G3D::Ray const& ray = rays[i % rays.size()];
+            uint32 const first = uint32(i * SIMD_TRIANGLES % VMAP_TRIANGLES);
+            float distance = 100.f;
+            for (uint32 j = 0; j < SIMD_TRIANGLES; ++j)
+                IntersectTriangle(triangles[first + j], vertices.begin(), ray, distance);
+            scalarDistance += distance;
+        }
+    });
+    double simdTriangleTime = MicroBenchmark::Measure("IntersectTriangles leaf", leaves, [&]()
+    {
+        G3D::Vector3 const* corners[SIMD_TRIANGLES][3];
+        for (uint64 i = 0; i < leaves; ++i)
+        {
+            G3D::Ray const& ray = rays[i % rays.size()];
+            uint32 const first = uint32(i * SIMD_TRIANGLES % VMAP_TRIANGLES);
+            for (uint32 j = 0; j < SIMD_TRIANGLES; ++j)
+            {
+                MeshTriangle const& tri = triangles[first + j];
+                corners[j][0] = &vertices[tri.idx0];
+                corners[j][1] = &vertices[tri.idx1];
+                corners[j][2] = &vertices[tri.idx2];
+            }
+            float distance = 100.f;
+            IntersectTriangles(ray.origin(), ray.direction(), corners, SIMD_TRIANGLES, distance);
+            simdDistance += distance;
+        }
+    });
+
+#ifdef VMAP_SIMD_SSE
+    printf("  kernels built with SSE\n");
+#else
+    printf("  kernels built without SSE, both sides are scalar\n");
+#endif
+    MicroBenchmark::PrintSpeedup("ray/box speedup", scalarBoxTime, simdBoxTime);
+    MicroBenchmark::PrintSpeedup("ray/triangle leaf speedup", scalarTriangleTime, simdTriangleTime);
+    MicroBenchmark::sink += simdBoxHits;
+
+    if (scalarBoxHits != simdBoxHits || scalarDistance != simdDistance)
+    {
+        printf("  kernel results differ from the scalar tests\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Line of sight on a real vmap tile between random points at eye height above the ground
+MICRO_BENCHMARK(vmap_los, "line of sight queries on a vmap tile (needs --data)")
+{
+    if (options.dataDir.empty())
+        return MICRO_BENCHMARK_SKIPPED;
+
+    VMapManager2 manager;
+    std::string vmapDir = options.dataDir + "/vmaps";
+    if (manager.loadMap(vmapDir.c_str(), options.mapId, options.tileX, options.tileY) != VMAP_LOAD_RESULT_OK)
+    {
+        printf("  no vmap tile %u [%u,%u] in %s\n", options.mapId, options.tileX, options.tileY, vmapDir.c_str());
+        return MICRO_BENCHMARK_SKIPPED;
+    }
+
+    // grid gx covers world x in ((31 - gx), (32 - gx)] * SIZE_OF_GRIDS, see Map::GetGrid
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> x((31.f - options.tileX) * SIZE_OF_GRIDS, (32.f - options.tileX) * SIZE_OF_GRIDS);
+    std::uniform_real_distribution<float> y((31.f - options.tileY) * SIZE_OF_GRIDS, (32.f - options.tileY) * SIZE_OF_GRIDS);
+
+    // tiles without any model give no height, they have nothing to test either
+    std::vector<G3D::Vector3> points;
+    for (uint32 attempt = 0; attempt < 100000 && points.size() < 4096; ++attempt)
+    {
+        G3D::Vector3 point(x(random), y(random), 0.f);
+        float height = manager.getHeight(options.mapId, point.x, point.y, 1000.f, 2000.f);
+        if (height < VMAP_INVALID_HEIGHT)
+            continue;
+        point.z = height + 2.f;
+        points.push_back(point);
+    }
+
+    if (points.size() < 2)
+    {
+        printf("  no model geometry on vmap tile %u [%u,%u]\n", options.mapId, options.tileX, options.tileY);
+        return MICRO_BENCHMARK_SKIPPED;
+    }
+
+    uint64 const queries = MicroBenchmark::Scaled(options, VMAP_LOS_QUERIES);
+    uint64 visible = 0;
+    MicroBenchmark::Measure("VMapManager2::isInLineOfSight", queries, [&]()
+    {
+        for (uint64 i = 0; i < queries; ++i)
+        {
+            G3D::Vector3 const& from = points[i % points.size()];
+            G3D::Vector3 const& to = points[(i * 7 + 1) % points.size()];
+            visible += manager.isInLineOfSight(options.mapId, from.x, from.y, from.z, to.x, to.y, to.z, false);
+        }
+    });
+    printf("  %.1f%% of the queries in line of sight\n", 100.0 * visible / queries);
+    MicroBenchmark::sink += visible;
+    return 0;
+}
@@ -0,0 +1,47 @@
+-- Synthetic players for mangosd --benchmark, load into the characters database
+-- Creates 1000 level 10 human priests and mages with guids 900001 .. 901000 on accounts of the same number
+-- Every character lists the next 10 as friends, so logins and logouts also run the friend broadcasts
+-- Scenario files pick their players from this range with first_guid and players
+
+DROP PROCEDURE IF EXISTS benchmark_fixture;
+
+DELIMITER //
+CREATE PROCEDURE benchmark_fixture(IN firstGuid INT UNSIGNED, IN total INT UNSIGNED)
+BEGIN
+  DECLARE i INT UNSIGNED DEFAULT 0;
+  DECLARE j INT UNSIGNED;
+
+  DELETE FROM character_social WHERE guid BETWEEN firstGuid AND firstGuid + total - 1;
+  DELETE FROM character_homebind WHERE guid BETWEEN firstGuid AND firstGuid + total - 1;
+  DELETE FROM character_spell WHERE guid BETWEEN firstGuid AND firstGuid + total - 1;
+  DELETE FROM character_skills WHERE guid BETWEEN firstGuid AND firstGuid + total - 1;
+  DELETE FROM character_action WHERE guid BETWEEN firstGuid AND firstGuid + total - 1;
+  DELETE FROM character_aura WHERE guid BETWEEN firstGuid AND firstGuid + total - 1;
+  DELETE FROM characters WHERE guid BETWEEN firstGuid AND firstGuid + total - 1;
+
+  WHILE i < total DO
+    -- names are Bench followed by three letters, at_login 2 learns the class spells on the first login
+    INSERT INTO characters (guid, account, name, race, class, gender, level, map, position_x, position_y, position_z, orientation,
+                            taximask, at_login, health, power1, exploredZones, equipmentCache, knownTitles)
+    VALUES (firstGuid + i, firstGuid + i,
+            CONCAT('Bench', CHAR(97 + (i DIV 676) MOD 26), CHAR(97 + (i DIV 26) MOD 26), CHAR(97 + i MOD 26)),
+            1, IF(i MOD 2 = 0, 5, 8), i MOD 2, 10, 0, -9460, 50, 56, 0,
+            '', 2, 1000, 1000, '', '', '');
+
+    INSERT INTO character_homebind (guid, map, zone, position_x, position_y, position_z)
+    VALUES (firstGuid + i, 0, 12, -9460, 50, 56);
+
+    SET j = 1;
+    WHILE j <= 10 DO
+      INSERT INTO character_social (guid, friend, flags, note)
+      VALUES (firstGuid + i, firstGuid + (i + j) MOD total, 1, '');
+      SET j = j + 1;
+    END WHILE;
+
+    SET i = i + 1;
+  END WHILE;
+END //
+DELIMITER ;
+
+CALL benchmark_fixture(900001, 1000);
+DROP PROCEDURE benchmark_fixture;
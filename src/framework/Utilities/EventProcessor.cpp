@@ -33,14 +33,13 @@ void EventProcessor::Update(uint32 p_time)
 {
     // update time
     m_time += p_time;
+    m_events.Advance(m_time);
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (TimerWheelNode* node = m_events.PopExpired(m_time))
     {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        // event is already removed from queue
+        BasicEvent* Event = static_cast<BasicEvent*>(node);
 
         if (!Event->to_Abort)
         {
@@ -64,38 +63,27 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    m_events.ForEach([this, force](TimerWheelNode* node)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        BasicEvent* Event = static_cast<BasicEvent*>(node);
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
         {
-            delete i_old->second;
-
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
+            m_events.Cancel(Event);
+            delete Event;
         }
-    }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    });
 }
 
 void EventProcessor::KillEvent(BasicEvent* event)
 {
-    for (EventList::iterator iter = m_events.begin(); iter != m_events.end();)
-    {
-        if (iter->second == event)
-        {
-            delete iter->second;
-            iter = m_events.erase(iter);
-        }
-        else ++iter;
-    }
+    if (!event->IsScheduled())
+        return;
+
+    m_events.Cancel(event);
+    delete event;
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -104,21 +92,16 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    m_events.Schedule(Event, e_time);
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 msTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != Event)
-            continue;
+    if (!Event->IsScheduled())
+        return;
 
-        Event->m_execTime = msTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(msTime, Event));
-        break;
-    }
+    Event->m_execTime = msTime;
+    m_events.Schedule(Event, msTime);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -0,0 +1,236 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(uint32 tickShift) : m_tickShift(tickShift), m_tick(0), m_nextSeq(0), m_size(0), m_levelSize(0),
+    m_expired(nullptr), m_expiredSorted(true), m_overflow(nullptr)
+{
+    for (uint64& occupied : m_occupied)
+        occupied = 0;
+}
+
+void TimerWheel::Schedule(TimerWheelNode* node, uint64 when)
+{
+    if (node->IsScheduled())
+        Unlink(node);
+
+    node->m_when = when;
+    node->m_seq = m_nextSeq++;
+    Insert(node);
+}
+
+void TimerWheel::Cancel(TimerWheelNode* node)
+{
+    if (node->IsScheduled())
+        Unlink(node);
+}
+
+void TimerWheel::Insert(TimerWheelNode* node)
+{
+    uint64 tick = node->m_when >> m_tickShift;
+    if (tick <= m_tick)
+    {
+        Link(m_expired, node, LEVEL_EXPIRED, 0);
+        m_expiredSorted = false;
+        return;
+    }
+
+    // level is given by the highest digit in which the tick differs from the current one
+    uint64 diff = tick ^ m_tick;
+    uint32 level = 0;
+    while (level < LEVELS && (diff >> (SLOT_BITS * (level + 1))))
+        ++level;
+
+    if (level == LEVELS)
+    {
+        Link(m_overflow, node, LEVEL_OVERFLOW, 0);
+        return;
+    }
+
+    if (!m_slots[level])
+    {
+        m_slots[level].reset(new TimerWheelNode*[SLOTS]);
+        std::fill(m_slots[level].get(), m_slots[level].get() + SLOTS, nullptr);
+    }
+
+    uint32 slot = uint32(tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+    Link(m_slots[level][slot], node, uint8(level), uint8(slot));
+    m_occupied[level] |= uint64(1) << slot;
+    ++m_levelSize;
+}
+
+void TimerWheel::Link(TimerWheelNode*& head, TimerWheelNode* node, uint8 level, uint8 slot)
+{
+    node->m_next = head;
+    if (head)
+        head->m_prevNext = &node->m_next;
+    head = node;
+    node->m_prevNext = &head;
+    node->m_level = level;
+    node->m_slot = slot;
+    ++m_size;
+}
+
+void TimerWheel::Unlink(TimerWheelNode* node)
+{
+    *node->m_prevNext = node->m_next;
+    if (node->m_next)
+        node->m_next->m_prevNext = node->m_prevNext;
+
+    if (node->m_level < LEVELS)
+    {
+        if (!m_slots[node->m_level][node->m_slot])
+            m_occupied[node->m_level] &= ~(uint64(1) << node->m_slot);
+        --m_levelSize;
+    }
+
+    node->m_next = nullptr;
+    node->m_prevNext = nullptr;
+    --m_size;
+}
+
+void TimerWheel::CollectSlot(uint32 level, uint32 slot)
+{
+    TimerWheelNode* node = m_slots[level][slot];
+    while (node)
+    {
+        TimerWheelNode* next = node->m_next;
+        Unlink(node);
+        Insert(node);
+        node = next;
+    }
+}
+
+void TimerWheel::Cascade()
+{
+    // m_tick just entered a new level 0 rotation, redistribute every higher slot which starts now
+    // highest level first, its nodes may land in the lower slots handled after it
+    uint32 top = 1;
+    while (top < LEVELS && ((m_tick >> (SLOT_BITS * top)) & (SLOTS - 1)) == 0)
+        ++top;
+
+    if (top == LEVELS)
+    {
+        TimerWheelNode* node = m_overflow;
+        while (node)
+        {
+            TimerWheelNode* next = node->m_next;
+            Unlink(node);
+            Insert(node);
+            node = next;
+        }
+        --top;
+    }
+
+    for (uint32 level = top; level > 0; --level)
+    {
+        if (!m_slots[level])
+            continue;
+
+        uint32 slot = uint32(m_tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+        if (m_occupied[level] & (uint64(1) << slot))
+            CollectSlot(level, slot);
+    }
+}
+
+void TimerWheel::Advance(uint64 now)
+{
+    uint64 newTick = now >> m_tickShift;
+
+    while (m_tick < newTick)
+    {
+        // nothing left in the levels, jump straight to the target
+        if (!m_levelSize)
+        {
+            m_tick = newTick;
+            TimerWheelNode* node = m_overflow;
+            while (node)
+            {
+                TimerWheelNode* next = node->m_next;
+                Unlink(node);
+                Insert(node);
+                node = next;
+            }
+            break;
+        }
+
+        // expire level 0 slots up to the target or the end of the current rotation
+        uint64 last = std::min(newTick, m_tick | (SLOTS - 1));
+        uint32 first = uint32(m_tick & (SLOTS - 1)) + 1;
+        uint32 end = uint32(last & (SLOTS - 1));
+        m_tick = last;
+
+        if (m_occupied[0])
+            for (uint32 slot = first; slot <= end; ++slot)
+                if (m_occupied[0] & (uint64(1) << slot))
+                    CollectSlot(0, slot);
+
+        if (m_tick == newTick)
+            break;
+
+        ++m_tick;
+        Cascade();
+    }
+}
+
+void TimerWheel::SortExpired()
+{
+    if (m_expiredSorted)
+        return;
+
+    m_sortBuffer.clear();
+    for (TimerWheelNode* node = m_expired; node; node = node->m_next)
+        m_sortBuffer.push_back(node);
+
+    std::sort(m_sortBuffer.begin(), m_sortBuffer.end(), [](TimerWheelNode const* lhs, TimerWheelNode const* rhs)
+    {
+        return lhs->m_when != rhs->m_when ? lhs->m_when < rhs->m_when : lhs->m_seq < rhs->m_seq;
+    });
+
+    // relink in order, the nodes stay in the expired list so no size bookkeeping
+    TimerWheelNode** prevNext = &m_expired;
+    for (TimerWheelNode* node : m_sortBuffer)
+    {
+        *prevNext = node;
+        node->m_prevNext = prevNext;
+        prevNext = &node->m_next;
+    }
+    *prevNext = nullptr;
+
+    m_expiredSorted = true;
+}
+
+TimerWheelNode* TimerWheel::PeekExpired(uint64 now)
+{
+    if (!m_expired)
+        return nullptr;
+
+    SortExpired();
+    return m_expired->m_when <= now ? m_expired : nullptr;
+}
+
+TimerWheelNode* TimerWheel::PopExpired(uint64 now)
+{
+    TimerWheelNode* node = PeekExpired(now);
+    if (node)
+        Unlink(node);
+    return node;
+}
@@ -0,0 +1,128 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TIMERWHEEL_H
+#define MANGOS_TIMERWHEEL_H
+
+#include "Platform/Define.h"
+
+#include <memory>
+#include <vector>
+
+// Note. All times are in milliseconds here.
+
+// Intrusive hook for objects scheduled in a TimerWheel, the wheel never owns or allocates them
+class TimerWheelNode
+{
+        friend class TimerWheel;
+
+    public:
+        TimerWheelNode() : m_next(nullptr), m_prevNext(nullptr), m_when(0), m_seq(0), m_level(0), m_slot(0) {}
+        // copies are never scheduled
+        TimerWheelNode(TimerWheelNode const&) : TimerWheelNode() {}
+        TimerWheelNode& operator=(TimerWheelNode const&) { return *this; }
+
+        bool IsScheduled() const { return m_prevNext != nullptr; }
+        uint64 GetScheduledTime() const { return m_when; }
+
+    private:
+        TimerWheelNode* m_next;
+        TimerWheelNode** m_prevNext;                        // pointer which points to this node, null if not scheduled
+        uint64 m_when;
+        uint64 m_seq;                                       // keeps nodes with the same time in schedule order
+        uint8 m_level;
+        uint8 m_slot;
+};
+
+// Hierarchical timing wheel
+// Schedule and Cancel are O(1), Advance only touches slots which hold nodes
+// Expired nodes are handed out ordered by time and then by schedule order, like a multimap would
+class TimerWheel
+{
+    public:
+        // granularity of the lowest level is 2^tickShift ms, expiry order is still exact to the ms
+        explicit TimerWheel(uint32 tickShift = 4);
+        TimerWheel(TimerWheel const&) = delete;
+        TimerWheel& operator=(TimerWheel const&) = delete;
+
+        void Schedule(TimerWheelNode* node, uint64 when);
+        void Cancel(TimerWheelNode* node);
+
+        // moves every node due at or before now into the expired list
+        void Advance(uint64 now);
+        // first expired node due at or before now, stays scheduled until cancelled
+        TimerWheelNode* PeekExpired(uint64 now);
+        // same as PeekExpired but unschedules the node
+        TimerWheelNode* PopExpired(uint64 now);
+
+        size_t Size() const { return m_size; }
+        bool Empty() const { return m_size == 0; }
+
+        // calls func for every scheduled node, func may cancel the node it was called with
+        template<typename Func>
+        void ForEach(Func&& func)
+        {
+            ForEachInList(m_expired, func);
+            for (uint32 level = 0; level < LEVELS; ++level)
+                if (m_slots[level])
+                    for (uint32 slot = 0; slot < SLOTS; ++slot)
+                        ForEachInList(m_slots[level][slot], func);
+            ForEachInList(m_overflow, func);
+        }
+
+    private:
+        static uint32 constexpr SLOT_BITS = 6;
+        static uint32 constexpr SLOTS = 1 << SLOT_BITS;
+        static uint32 constexpr LEVELS = 4;
+        static uint8 constexpr LEVEL_EXPIRED = LEVELS;
+        static uint8 constexpr LEVEL_OVERFLOW = LEVELS + 1;
+
+        template<typename Func>
+        static void ForEachInList(TimerWheelNode* node, Func& func)
+        {
+            while (node)
+            {
+                TimerWheelNode* next = node->m_next;
+                func(node);
+                node = next;
+            }
+        }
+
+        void Insert(TimerWheelNode* node);
+        void Link(TimerWheelNode*& head, TimerWheelNode* node, uint8 level, uint8 slot);
+        void Unlink(TimerWheelNode* node);
+        void Cascade();
+        void CollectSlot(uint32 level, uint32 slot);
+        void SortExpired();
+
+        uint32 const m_tickShift;
+        uint64 m_tick;                                      // all nodes in the levels are due after this tick
+        uint64 m_nextSeq;
+        size_t m_size;
+        size_t m_levelSize;                                 // nodes in the levels, without expired and overflow
+
+        std::unique_ptr<TimerWheelNode*[]> m_slots[LEVELS]; // allocated on first use, most owners only ever need level 0
+        uint64 m_occupied[LEVELS];                          // bit per non empty slot
+        TimerWheelNode* m_expired;
+        bool m_expiredSorted;
+        TimerWheelNode* m_overflow;                         // further away than the levels cover
+
+        std::vector<TimerWheelNode*> m_sortBuffer;
+};
+
+#endif
@@ -468,6 +468,7 @@ void AchievementMgr::Reset()
 
     m_completedAchievements.clear();
     m_criteriaProgress.clear();
+    m_closedCriteria.clear();
     DeleteFromDB(m_player->GetObjectGuid());
 
     // re-fill data
@@ -569,16 +570,60 @@ void AchievementMgr::DeleteFromDB(ObjectGuid guid)
     CharacterDatabase.CommitTransaction();
 }
 
-void AchievementMgr::SaveToDB()
+namespace
 {
-    static SqlStatementID delComplAchievements ;
-    static SqlStatementID insComplAchievements ;
-    static SqlStatementID delProgress ;
-    static SqlStatementID insProgress ;
+    // rows per statement, keeps generated queries well below MAX_QUERY_LEN
+    uint32 const ACHIEVEMENT_SAVE_ROWS_PER_QUERY = 200;
+
+    // replaces changed rows of one character table with a DELETE ... IN and a multi-row INSERT per chunk
+    class AchievementRowBatch
+    {
+        public:
+            AchievementRowBatch(char const* table, char const* keyColumn, char const* columns, uint32 lowGuid) :
+                m_table(table), m_keyColumn(keyColumn), m_columns(columns), m_lowGuid(lowGuid), m_keyCount(0), m_rowCount(0) {}
+            ~AchievementRowBatch() { Flush(); }
+
+            // delete row of key and insert values (without guid) if not empty
+            void Replace(uint32 key, std::string const& values)
+            {
+                m_keys << (m_keyCount++ ? "," : "") << key;
+                if (!values.empty())
+                    m_rows << (m_rowCount++ ? "," : "") << "(" << m_lowGuid << "," << values << ")";
+
+                if (m_keyCount >= ACHIEVEMENT_SAVE_ROWS_PER_QUERY)
+                    Flush();
+            }
+
+            void Flush()
+            {
+                if (m_keyCount)
+                    CharacterDatabase.PExecute("DELETE FROM %s WHERE guid = %u AND %s IN (%s)", m_table, m_lowGuid, m_keyColumn, m_keys.str().c_str());
+                if (m_rowCount)
+                    CharacterDatabase.PExecute("INSERT INTO %s (%s) VALUES %s", m_table, m_columns, m_rows.str().c_str());
 
+                m_keys.str("");
+                m_rows.str("");
+                m_keyCount = 0;
+                m_rowCount = 0;
+            }
+
+        private:
+            char const* m_table;
+            char const* m_keyColumn;
+            char const* m_columns;
+            uint32 m_lowGuid;
+            std::ostringstream m_keys;
+            std::ostringstream m_rows;
+            uint32 m_keyCount;
+            uint32 m_rowCount;
+    };
+}
+
+void AchievementMgr::SaveToDB()
+{
     if (!m_completedAchievements.empty())
     {
-        // delete existing achievements in the loop
+        AchievementRowBatch batch("character_achievement", "achievement", "guid, achievement, date", GetPlayer()->GetGUIDLow());
         for (auto& m_completedAchievement : m_completedAchievements)
         {
             if (!m_completedAchievement.second.changed)
@@ -587,17 +632,15 @@ void AchievementMgr::SaveToDB()
             /// mark as saved in db
             m_completedAchievement.second.changed = false;
 
-            SqlStatement stmt = CharacterDatabase.CreateStatement(delComplAchievements, "DELETE FROM character_achievement WHERE guid = ? AND achievement = ?");
-            stmt.PExecute(GetPlayer()->GetGUIDLow(), m_completedAchievement.first);
-
-            stmt = CharacterDatabase.CreateStatement(insComplAchievements, "INSERT INTO character_achievement (guid, achievement, date) VALUES (?, ?, ?)");
-            stmt.PExecute(GetPlayer()->GetGUIDLow(), m_completedAchievement.first, uint64(m_completedAchievement.second.date));
+            std::ostringstream values;
+            values << m_completedAchievement.first << "," << uint64(m_completedAchievement.second.date);
+            batch.Replace(m_completedAchievement.first, values.str());
         }
     }
 
     if (!m_criteriaProgress.empty())
     {
-        // insert achievements
+        AchievementRowBatch batch("character_achievement_progress", "criteria", "guid, criteria, counter, date", GetPlayer()->GetGUIDLow());
         for (auto& m_criteriaProgres : m_criteriaProgress)
         {
             if (!m_criteriaProgres.second.changed)
@@ -606,10 +649,6 @@ void AchievementMgr::SaveToDB()
             /// mark as updated in db
             m_criteriaProgres.second.changed = false;
 
-            // new/changed record data
-            SqlStatement stmt = CharacterDatabase.CreateStatement(delProgress, "DELETE FROM character_achievement_progress WHERE guid = ? AND criteria = ?");
-            stmt.PExecute(GetPlayer()->GetGUIDLow(), m_criteriaProgres.first);
-
             bool needSave = m_criteriaProgres.second.counter != 0;
             if (!needSave)
             {
@@ -617,11 +656,11 @@ void AchievementMgr::SaveToDB()
                 needSave = criteria && criteria->timeLimit > 0;
             }
 
+            // new/changed record data, zero counters are only deleted
+            std::ostringstream values;
             if (needSave)
-            {
-                stmt = CharacterDatabase.CreateStatement(insProgress, "INSERT INTO character_achievement_progress (guid, criteria, counter, date) VALUES (?, ?, ?, ?)");
-                stmt.PExecute(GetPlayer()->GetGUIDLow(), m_criteriaProgres.first, m_criteriaProgres.second.counter, uint64(m_criteriaProgres.second.date));
-            }
+                values << m_criteriaProgres.first << "," << m_criteriaProgres.second.counter << "," << uint64(m_criteriaProgres.second.date);
+            batch.Replace(m_criteriaProgres.first, values.str());
         }
     }
 }
@@ -849,6 +888,7 @@ void AchievementMgr::StartTimedAchievementCriteria(AchievementCriteriaTypes type
 
         progress->changed = true;
         progress->counter = 0;
+        SetClosedCriteria(achievementCriteria->ID, false);
 
         // Start with given startTime or now
         progress->date = startTime ? startTime : time(nullptr);
@@ -899,6 +939,7 @@ void AchievementMgr::DoFailedTimedAchievementCriterias()
 
             // Remove failed progress
             m_criteriaProgress.erase(pro_iter);
+            SetClosedCriteria(criteria->ID, false);
         }
 
         m_criteriaFailTimes.erase(iter++);
@@ -915,9 +956,15 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (!sWorld.getConfig(CONFIG_BOOL_GM_ALLOW_ACHIEVEMENT_GAINS) && m_player->GetSession()->GetSecurity() > SEC_PLAYER)
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type);
+    // with miscvalue1 set these types only ever match criteria for that asset (login calls pass 0 and check all)
+    AchievementCriteriaEntryList const& achievementCriteriaList = miscvalue1 && AchievementGlobalMgr::IsAssetIndexedCriteriaType(type)
+            ? sAchievementMgr.GetAchievementCriteriaByTypeAndAsset(type, miscvalue1)
+            : sAchievementMgr.GetAchievementCriteriaByType(type);
     for (auto achievementCriteria : achievementCriteriaList)
     {
+        if (IsClosedCriteria(achievementCriteria->ID))
+            continue;
+
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
         // Checked in LoadAchievementCriteriaList
 
@@ -927,7 +974,12 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
 
         // don't update already completed criteria
         if (IsCompletedCriteria(achievementCriteria, achievement))
+        {
+            // realm first state changes outside of this player, everything else only reopens with a progress change
+            if (!(achievement->flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL)))
+                SetClosedCriteria(achievementCriteria->ID, true);
             continue;
+        }
 
         // init values, real set in switch
         uint32 change = 0;
@@ -1888,6 +1940,18 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     }
 }
 
+void AchievementMgr::SetClosedCriteria(uint32 criteriaId, bool closed)
+{
+    if (criteriaId >= m_closedCriteria.size())
+    {
+        if (!closed)
+            return;
+        m_closedCriteria.resize(sAchievementCriteriaStore.GetNumRows());
+    }
+
+    m_closedCriteria[criteriaId] = closed;
+}
+
 CriteriaProgress* AchievementMgr::GetCriteriaProgress(AchievementCriteriaEntry const* entry)
 {
     auto itr = m_criteriaProgress.find(entry->ID);
@@ -2256,6 +2320,7 @@ void AchievementMgr::SetCriteriaProgress(AchievementCriteriaEntry const* criteri
 
     progress->counter = newValue;
     progress->changed = true;
+    SetClosedCriteria(criteria->ID, false);
 
     // update client side value
     SendCriteriaUpdate(criteria->ID, progress);
@@ -2458,6 +2523,56 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
     return m_AchievementCriteriasByType[type];
 }
 
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaByTypeAndAsset(AchievementCriteriaTypes type, uint32 asset) const
+{
+    static AchievementCriteriaEntryList const emptyList;
+
+    AchievementCriteriaListByAsset::const_iterator itr = m_AchievementCriteriasByAsset[type].find(asset);
+    return itr != m_AchievementCriteriasByAsset[type].end() ? itr->second : emptyList;
+}
+
+/**
+ * types for which AchievementMgr::UpdateAchievementCriteria skips every criteria with raw.value != miscvalue1 when miscvalue1 is set
+ * keep in sync with the switch there
+ */
+bool AchievementGlobalMgr::IsAssetIndexedCriteriaType(AchievementCriteriaTypes type)
+{
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+            return true;
+        default:
+            return false;
+    }
+}
+
 AchievementCriteriaEntryList const* AchievementGlobalMgr::GetAchievementCriteriaByAchievement(uint32 id)
 {
     AchievementCriteriaListByAchievement::const_iterator itr = m_AchievementCriteriaListByAchievement.find(id);
@@ -2540,6 +2655,8 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         }
 
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
+        if (IsAssetIndexedCriteriaType(AchievementCriteriaTypes(criteria->requiredType)))
+            m_AchievementCriteriasByAsset[criteria->requiredType][criteria->raw.value].push_back(criteria);
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
         ++count;
     }
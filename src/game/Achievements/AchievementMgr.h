@@ -33,6 +33,7 @@ typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
+typedef std::unordered_map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAsset;
 typedef std::map<uint32, AchievementEntryList>         AchievementListByReferencedId;
 typedef std::map<uint32, time_t>                       AchievementCriteriaFailTimeMap;
 
@@ -319,8 +320,13 @@ class AchievementMgr
         bool IsCompletedAchievement(AchievementEntry const* entry);
         void BuildAllDataPacket(WorldPacket& data);
 
+        // criteria known to be completed since their last progress change, skipped without any lookup
+        bool IsClosedCriteria(uint32 criteriaId) const { return criteriaId < m_closedCriteria.size() && m_closedCriteria[criteriaId]; }
+        void SetClosedCriteria(uint32 criteriaId, bool closed);
+
         Player* m_player;
         CriteriaProgressMap m_criteriaProgress;
+        std::vector<bool> m_closedCriteria;
         CompletedAchievementMap m_completedAchievements;
         AchievementCriteriaFailTimeMap m_criteriaFailTimes;
 };
@@ -329,6 +335,9 @@ class AchievementGlobalMgr
 {
     public:
         AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type) const;
+        // criteria of type with given asset (creature, item, spell, ...), only for IsAssetIndexedCriteriaType types
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByTypeAndAsset(AchievementCriteriaTypes type, uint32 asset) const;
+        static bool IsAssetIndexedCriteriaType(AchievementCriteriaTypes type);
         AchievementCriteriaEntryList const* GetAchievementCriteriaByAchievement(uint32 id);
         AchievementEntryList const* GetAchievementByReferencedId(uint32 id) const;
         AchievementReward const* GetAchievementReward(AchievementEntry const* achievement, uint8 gender) const;
@@ -350,6 +359,8 @@ class AchievementGlobalMgr
 
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // store achievement criterias by type and asset id for types where update events always carry the asset
+        AchievementCriteriaListByAsset m_AchievementCriteriasByAsset[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
@@ -30,7 +30,7 @@
 
 INSTANTIATE_SINGLETON_1(AuctionHouseBot);
 
-AuctionHouseBot::AuctionHouseBot() : m_configFileName(_AUCTIONHOUSEBOT_CONFIG), m_houseAction(-1)
+AuctionHouseBot::AuctionHouseBot() : m_configFileName(_AUCTIONHOUSEBOT_CONFIG), m_houseAction(-1), m_professionItemsAcceptChance(0.0f)
 {
 }
 
@@ -149,6 +149,8 @@ void AuctionHouseBot::Initialize()
             while (result->NextRow());
             delete result;
         }
+
+        BuildItemPools();
     }
 }
 
@@ -164,34 +166,31 @@ void AuctionHouseBot::Update()
         // Sell items
         std::unordered_map<uint32, uint32> itemMap;
 
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootNormalConfig, m_creatureLootNormalTemplates, itemMap);       // normal creature loot
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootEliteConfig, m_creatureLootEliteTemplates, itemMap);         // elite creature loot
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootRareEliteConfig, m_creatureLootRareEliteTemplates, itemMap); // rare elite creature loot
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootWorldBossConfig, m_creatureLootWorldBossTemplates, itemMap); // world boss creature loot
-        AddLootToItemMap(&LootTemplates_Creature, m_creatureLootRareConfig, m_creatureLootRareTemplates, itemMap);           // rare creature loot
+        AddLootToItemMap(m_creatureLootNormalPool, m_creatureLootNormalConfig, itemMap);       // normal creature loot
+        AddLootToItemMap(m_creatureLootElitePool, m_creatureLootEliteConfig, itemMap);         // elite creature loot
+        AddLootToItemMap(m_creatureLootRareElitePool, m_creatureLootRareEliteConfig, itemMap); // rare elite creature loot
+        AddLootToItemMap(m_creatureLootWorldBossPool, m_creatureLootWorldBossConfig, itemMap); // world boss creature loot
+        AddLootToItemMap(m_creatureLootRarePool, m_creatureLootRareConfig, itemMap);           // rare creature loot
 
-        AddLootToItemMap(&LootTemplates_Disenchant, m_disenchantLootConfig, m_disenchantLootTemplates, itemMap);             // disenchant loot
-        AddLootToItemMap(&LootTemplates_Fishing, m_fishingLootConfig, m_fishingLootTemplates, itemMap);                      // fishing loot
-        AddLootToItemMap(&LootTemplates_Gameobject, m_gameobjectLootConfig, m_gameobjectLootTemplates, itemMap);             // gameobject loot
-        AddLootToItemMap(&LootTemplates_Skinning, m_skinningLootConfig, m_skinningLootTemplates, itemMap);                   // skinning loot
+        AddLootToItemMap(m_disenchantLootPool, m_disenchantLootConfig, itemMap);               // disenchant loot
+        AddLootToItemMap(m_fishingLootPool, m_fishingLootConfig, itemMap);                     // fishing loot
+        AddLootToItemMap(m_gameobjectLootPool, m_gameobjectLootConfig, itemMap);               // gameobject loot
+        AddLootToItemMap(m_skinningLootPool, m_skinningLootConfig, itemMap);                   // skinning loot
 
         // profession items are a bit different (not looted)
-        if (m_professionItemsConfig[1] > 0 && m_professionItemsConfig[3] > 0 && m_professionItems.size() > 0)
+        if (m_professionItemsConfig[1] > 0 && m_professionItemsConfig[3] > 0 && !m_professionItemsPool.Sampler.Empty())
         {
             int32 maxTemplates = m_professionItemsConfig[0] < 0 ? urand(0, m_professionItemsConfig[1] - m_professionItemsConfig[0]) + m_professionItemsConfig[0] : urand(m_professionItemsConfig[0], m_professionItemsConfig[1]);
-            if (maxTemplates > 0)
+            for (int32 templateCounter = 0; templateCounter < maxTemplates; ++templateCounter)
             {
-                for (int32 templateCounter = 0; templateCounter < maxTemplates; ++templateCounter)
-                {
-                    uint32 item = m_professionItems[urand(0, m_professionItems.size() - 1)];
-                    ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(item);
-                    if (!prototype || prototype->Quality == 0 || urand(0, (1 << (prototype->Quality - 1)) - 1) > 0)
-                        continue; // make it decreasingly likely that crafted items of higher quality is added to the auction house (white: 100%, green: 50%, blue: 25%, purple: 12.5%, ...)
-                    uint32 count = (uint32) round((uint64)prototype->GetMaxStackSize() * urand(m_professionItemsConfig[2], m_professionItemsConfig[3]) / 100.0);
-                    if (count <= 0)
-                        count = 1;
-                    itemMap[item] += count;
-                }
+                if (rand_norm() >= m_professionItemsAcceptChance)
+                    continue; // same odds as picking any profession item and then dropping it by quality
+                uint32 item = m_professionItemsPool.Candidates[m_professionItemsPool.Sampler.Sample()].itemid;
+                ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(item);
+                uint32 count = (uint32) round((uint64)prototype->GetMaxStackSize() * urand(m_professionItemsConfig[2], m_professionItemsConfig[3]) / 100.0);
+                if (count <= 0)
+                    count = 1;
+                itemMap[item] += count;
             }
         }
 
@@ -210,17 +209,9 @@ void AuctionHouseBot::Update()
             auto iterator = m_itemData.find(prototype->ItemId);
             if (iterator != m_itemData.end() && iterator->second.Value == 0)
                 continue; // item is blacklisted
-            if (iterator == m_itemData.end() || iterator->second.AddChance == 0)
-            {
-                if (prototype->Bonding == BIND_WHEN_PICKED_UP || prototype->Bonding == BIND_QUEST_ITEM)
-                    continue; // no BoP and quest items
-                if (prototype->Flags & ITEM_FLAG_HAS_LOOT)
-                    continue; // nor items containing loot
-                if (m_itemValue[prototype->Quality][prototype->Class] == 0)
-                    continue; // item class is filtered out
-            }
+            // pooled items passed IsSellable when the pools were built, overridden items skip that check
 
-            uint32 itemValue = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : CalculateBuyoutPrice(prototype));
+            uint32 itemValue = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : GetBuyoutPrice(prototype));
             for (uint32 stackCounter = 0; stackCounter < itemEntry.second; stackCounter += prototype->GetMaxStackSize())
             {
                 uint32 count = itemEntry.second - stackCounter > prototype->GetMaxStackSize() ? prototype->GetMaxStackSize() : itemEntry.second - stackCounter;
@@ -253,7 +244,7 @@ void AuctionHouseBot::Update()
             if (iterator != m_itemData.end() && iterator->second.Value == 0)
                 continue; // item is blacklisted
 
-            uint32 buyItemCheck = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : CalculateBuyoutPrice(prototype));
+            uint32 buyItemCheck = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : GetBuyoutPrice(prototype));
             buyItemCheck *= item->GetCount();
             uint32 bidPrice = auction->bid + auction->GetAuctionOutBid();
             if (auction->startbid > bidPrice)
@@ -460,26 +451,122 @@ void AuctionHouseBot::ParseItemValueConfig(char const* fieldname, std::vector<ui
     }
 }
 
-void AuctionHouseBot::AddLootToItemMap(LootStore* store, std::vector<int32>& lootConfig, std::vector<uint32>& lootTemplates, std::unordered_map<uint32, uint32>& itemMap)
+bool AuctionHouseBot::IsSellable(ItemPrototype const* prototype) const
 {
-    if (lootConfig[1] <= 0 || lootConfig[3] <= 0 || lootTemplates.size() <= 0)
+    if (!prototype || prototype->GetMaxStackSize() == 0)
+        return false;
+    if (prototype->Bonding == BIND_WHEN_PICKED_UP || prototype->Bonding == BIND_QUEST_ITEM)
+        return false; // no BoP and quest items
+    if (prototype->Flags & ITEM_FLAG_HAS_LOOT)
+        return false; // nor items containing loot
+    if (m_itemValue[prototype->Quality][prototype->Class] == 0)
+        return false; // item class is filtered out
+    return true;
+}
+
+void AuctionHouseBot::BuildLootPool(LootStore const& store, std::vector<uint32> const& lootTemplates, AuctionHouseBotItemPool& pool)
+{
+    pool = AuctionHouseBotItemPool();
+
+    LootDropChanceList drops;
+    for (uint32 entry : lootTemplates)
+    {
+        if (LootTemplate const* lootTable = store.GetLootFor(entry))
+            lootTable->CollectDropChances(drops, store.IsRatesAllowed());
+    }
+
+    // merge the same item and count range dropped by different templates into one candidate
+    std::unordered_map<uint64, uint32> candidateIndex;
+    std::vector<double> weights;
+    double totalChance = 0.0;
+    for (LootDropChance const& drop : drops)
+    {
+        ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(drop.itemid);
+        if (!IsSellable(prototype))
+            continue;
+
+        uint64 key = (uint64(drop.itemid) << 16) | (uint64(drop.mincount) << 8) | drop.maxcount;
+        auto itr = candidateIndex.find(key);
+        if (itr == candidateIndex.end())
+        {
+            itr = candidateIndex.emplace(key, uint32(pool.Candidates.size())).first;
+            pool.Candidates.push_back(drop);
+            weights.push_back(0.0);
+            m_buyoutPrices.emplace(drop.itemid, CalculateBuyoutPrice(prototype));
+        }
+        weights[itr->second] += drop.chance;
+        totalChance += drop.chance;
+    }
+
+    pool.Sampler.Build(weights);
+    // templates are picked uniformly, so a single roll drops the average of all of them
+    pool.DropsPerRoll = lootTemplates.empty() ? 0.0f : float(totalChance / lootTemplates.size());
+}
+
+void AuctionHouseBot::BuildProfessionPool()
+{
+    m_professionItemsPool = AuctionHouseBotItemPool();
+    m_professionItemsAcceptChance = 0.0f;
+
+    std::vector<double> weights;
+    double totalWeight = 0.0;
+    for (uint32 item : m_professionItems)
+    {
+        ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(item);
+        if (!prototype || prototype->Quality == 0 || !IsSellable(prototype))
+            continue;
+        // make it decreasingly likely that crafted items of higher quality is added to the auction house (white: 100%, green: 50%, blue: 25%, purple: 12.5%, ...)
+        double weight = 1.0 / (1 << (prototype->Quality - 1));
+        m_professionItemsPool.Candidates.push_back({ item, 1.0f, 1, 1 });
+        weights.push_back(weight);
+        totalWeight += weight;
+        m_buyoutPrices.emplace(item, CalculateBuyoutPrice(prototype));
+    }
+
+    m_professionItemsPool.Sampler.Build(weights);
+    if (!m_professionItems.empty())
+        m_professionItemsAcceptChance = float(totalWeight / m_professionItems.size());
+}
+
+void AuctionHouseBot::BuildItemPools()
+{
+    m_buyoutPrices.clear();
+
+    BuildLootPool(LootTemplates_Creature, m_creatureLootNormalTemplates, m_creatureLootNormalPool);
+    BuildLootPool(LootTemplates_Creature, m_creatureLootEliteTemplates, m_creatureLootElitePool);
+    BuildLootPool(LootTemplates_Creature, m_creatureLootRareEliteTemplates, m_creatureLootRareElitePool);
+    BuildLootPool(LootTemplates_Creature, m_creatureLootWorldBossTemplates, m_creatureLootWorldBossPool);
+    BuildLootPool(LootTemplates_Creature, m_creatureLootRareTemplates, m_creatureLootRarePool);
+    BuildLootPool(LootTemplates_Disenchant, m_disenchantLootTemplates, m_disenchantLootPool);
+    BuildLootPool(LootTemplates_Fishing, m_fishingLootTemplates, m_fishingLootPool);
+    BuildLootPool(LootTemplates_Gameobject, m_gameobjectLootTemplates, m_gameobjectLootPool);
+    BuildLootPool(LootTemplates_Skinning, m_skinningLootTemplates, m_skinningLootPool);
+    BuildProfessionPool();
+
+    sLog.outString("AHBot item pools built for %u items", uint32(m_buyoutPrices.size()));
+}
+
+void AuctionHouseBot::AddLootToItemMap(AuctionHouseBotItemPool const& pool, std::vector<int32> const& lootConfig, std::unordered_map<uint32, uint32>& itemMap) const
+{
+    if (lootConfig[1] <= 0 || lootConfig[3] <= 0 || pool.Sampler.Empty())
         return;
     int32 maxTemplates = lootConfig[0] < 0 ? urand(0, lootConfig[1] - lootConfig[0]) + lootConfig[0] : urand(lootConfig[0], lootConfig[1]);
     if (maxTemplates <= 0)
         return;
+    uint32 rolls = 0;
     for (int32 templateCounter = 0; templateCounter < maxTemplates; ++templateCounter)
-    {
-        uint32 lootTemplate = urand(0, lootTemplates.size() - 1);
-        LootTemplate const* lootTable = store->GetLootFor(lootTemplates[lootTemplate]);
-        if (!lootTable)
-            continue;
-        std::unique_ptr<Loot> loot = std::unique_ptr<Loot>(new Loot(LOOT_DEBUG));
-        for (uint32 repeat = urand(lootConfig[2], lootConfig[3]); repeat > 0; --repeat)
-            lootTable->Process(*loot, nullptr, *store, store->IsRatesAllowed());
+        rolls += urand(lootConfig[2], lootConfig[3]);
 
-        LootItem* lootItem;
-        for (uint32 slot = 0; (lootItem = loot->GetLootItemInSlot(slot)); ++slot)
-            itemMap[lootItem->itemId] += lootItem->count;
+    // draw as many items as the rolls would drop on average, the fraction decides one extra drop
+    double expectedDrops = rolls * double(pool.DropsPerRoll);
+    uint32 drops = uint32(expectedDrops);
+    if (rand_norm() < expectedDrops - drops)
+        ++drops;
+
+    for (; drops > 0; --drops)
+    {
+        LootDropChance const& candidate = pool.Candidates[pool.Sampler.Sample()];
+        itemMap[candidate.itemid] += urand(candidate.mincount, candidate.maxcount);
     }
 }
 
@@ -496,3 +583,9 @@ uint32 AuctionHouseBot::CalculateBuyoutPrice(ItemPrototype const* prototype)
     buyoutPrice /= 100; // since we multiplied with m_itemValue
     return buyoutPrice;
 }
+
+uint32 AuctionHouseBot::GetBuyoutPrice(ItemPrototype const* prototype)
+{
+    auto itr = m_buyoutPrices.find(prototype->ItemId);
+    return itr != m_buyoutPrices.end() ? itr->second : CalculateBuyoutPrice(prototype);
+}
@@ -24,6 +24,7 @@
 #include "Entities/ItemPrototype.h"
 #include "Globals/SharedDefines.h"
 #include "Loot/LootMgr.h"
+#include "Util/AliasTable.h"
 #include "Util/Util.h"
 
 struct AuctionHouseBotItemData
@@ -42,6 +43,14 @@ struct AuctionHouseBotStatusInfoPerType
 
 typedef AuctionHouseBotStatusInfoPerType AuctionHouseBotStatusInfo[MAX_AUCTION_HOUSE_TYPE];
 
+// items a loot source can put up for sale, weighted by how often they drop
+struct AuctionHouseBotItemPool
+{
+    std::vector<LootDropChance> Candidates;
+    AliasTable Sampler;
+    float DropsPerRoll = 0.0f;                              // expected sellable drops per template roll
+};
+
 class AuctionHouseBot
 {
     public:
@@ -64,8 +73,13 @@ class AuctionHouseBot
         void ParseLootConfig(char const* fieldname, std::vector<int32>& lootConfig);
         void FillUintVectorFromQuery(char const* query, std::vector<uint32>& lootTemplates);
         void ParseItemValueConfig(char const* fieldname, std::vector<uint32>& itemValues);
-        void AddLootToItemMap(LootStore* store, std::vector<int32>& lootConfig, std::vector<uint32>& lootTemplates, std::unordered_map<uint32, uint32>& itemMap);
+        bool IsSellable(ItemPrototype const* prototype) const;
+        void BuildLootPool(LootStore const& store, std::vector<uint32> const& lootTemplates, AuctionHouseBotItemPool& pool);
+        void BuildProfessionPool();
+        void BuildItemPools();
+        void AddLootToItemMap(AuctionHouseBotItemPool const& pool, std::vector<int32> const& lootConfig, std::unordered_map<uint32, uint32>& itemMap) const;
         uint32 CalculateBuyoutPrice(ItemPrototype const* prototype);
+        uint32 GetBuyoutPrice(ItemPrototype const* prototype);
         uint32 ValueWithVariance(uint32 itemValue) { return (uint32) (itemValue + ((int32) urand(0, m_valueVariance * 2 + 1) - (int32) m_valueVariance) * (int32) (itemValue / 100)); };
 
         std::string m_configFileName;
@@ -109,6 +123,20 @@ class AuctionHouseBot
 
         std::unordered_set<uint32> m_vendorItems;
 
+        AuctionHouseBotItemPool m_creatureLootNormalPool;
+        AuctionHouseBotItemPool m_creatureLootRarePool;
+        AuctionHouseBotItemPool m_creatureLootElitePool;
+        AuctionHouseBotItemPool m_creatureLootRareElitePool;
+        AuctionHouseBotItemPool m_creatureLootWorldBossPool;
+        AuctionHouseBotItemPool m_disenchantLootPool;
+        AuctionHouseBotItemPool m_fishingLootPool;
+        AuctionHouseBotItemPool m_gameobjectLootPool;
+        AuctionHouseBotItemPool m_skinningLootPool;
+        AuctionHouseBotItemPool m_professionItemsPool;
+        float m_professionItemsAcceptChance;
+
+        std::unordered_map<uint32, uint32> m_buyoutPrices;  // base buyout price of every pooled item
+
         std::unordered_map<uint32, AuctionHouseBotItemData> m_itemData;
 };
 
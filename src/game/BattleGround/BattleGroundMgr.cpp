@@ -2315,19 +2315,13 @@ void BattleGroundMgr::RewardArenaSeason(uint32 seasonId)
             {
                 uint32 titleValueCount = 2;
                 uint32 titleValues[2];
-                std::string titlesData = result->Fetch()[0].GetCppString();
-                Tokens tokens = StrSplit(titlesData, " ");
-                if (tokens.size() != titleValueCount)
+                if (ParseUInt32List(result->Fetch()[0].GetString(), titleValues, titleValueCount) != titleValueCount)
                     return;
 
-                Tokens::iterator iter;
-                uint32 index;
-                for (iter = tokens.begin(), index = 0; index < titleValueCount; ++iter, ++index)
-                    titleValues[index] = std::stoul((*iter).c_str());
-
                 SetTitleValues(titleValues[0], titleValues[1], titles[data.second]);
 
-                std::string newTitleData = std::to_string(titleValues[0]) + " " + std::to_string(titleValues[1]) + " ";
+                std::string newTitleData;
+                AppendUInt32List(newTitleData, titleValues, titleValueCount, sWorld.getConfig(CONFIG_BOOL_SAVE_BINARY_NUMBER_LISTS));
                 CharacterDatabase.PExecute("UPDATE characters SET knownTitles='%s' WHERE guid = '%u'", newTitleData.data(), data.first.GetCounter());
                 delete result;
             }
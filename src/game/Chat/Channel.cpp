@@ -120,6 +120,7 @@ void Channel::Join(Player* player, const char* password)
 
     PlayerInfo& pinfo = m_players[guid];
     pinfo.player = guid;
+    pinfo.session = player->GetSession();
     pinfo.flags = MEMBER_FLAG_NONE;
 
     MakeYouJoined(data, m_name, *this);
@@ -519,7 +520,7 @@ void Channel::SendChannelListResponse(Player* player, bool display/*= false*/)
     uint32 count = 0;
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
     {
-        if (Player* member = sObjectMgr.GetPlayer(i->first))
+        if (Player* member = i->second.session ? i->second.session->GetPlayer() : nullptr)
         {
             if (visibilityCheck && (member->GetSession()->GetSecurity() > visibilityThreshold || !member->IsVisibleGloballyFor(player)))
                 continue;
@@ -740,22 +741,29 @@ void Channel::Invite(Player* player, const char* targetName)
 
 void Channel::SendToOne(WorldPacket const& data, ObjectGuid receiver) const
 {
-    if (Player* player = sObjectMgr.GetPlayer(receiver))
+    PlayerList::const_iterator itr = m_players.find(receiver);
+    if (itr != m_players.end() && itr->second.session)
+        itr->second.session->SendPacket(data);
+    else if (Player* player = sObjectMgr.GetPlayer(receiver))
         player->GetSession()->SendPacket(data);
 }
 
 void Channel::SendToAll(WorldPacket const& data) const
 {
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        SendToOne(data, i->first);
+        if (i->second.session && i->second.session->GetPlayer())
+            i->second.session->SendPacket(data);
 }
 
 void Channel::SendMessage(WorldPacket const& data, ObjectGuid sender) const
 {
+    // one lookup for the sender instead of an ignore list check per member
+    std::set<uint32> const* ignoredBy = sender ? sSocialMgr.GetIgnoreListers(sender) : nullptr;
+
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        if (Player* plr = sObjectMgr.GetPlayer(i->first))
-            if (!sender || !plr->GetSocial()->HasIgnore(sender))
-                plr->GetSession()->SendPacket(data);
+        if (i->second.session && i->second.session->GetPlayer())
+            if (!ignoredBy || ignoredBy->find(i->first.GetCounter()) == ignoredBy->end())
+                i->second.session->SendPacket(data);
 }
 
 void Channel::Voice(ObjectGuid /*guid1*/, ObjectGuid /*guid2*/) const
@@ -122,6 +122,7 @@ class Channel
         struct PlayerInfo
         {
             ObjectGuid player;
+            WorldSession* session;                          // resolved at join, members leave all channels before logout
             uint8 flags;
 
             inline bool HasFlag(uint8 flag) const { return (flags & flag) != 0; }
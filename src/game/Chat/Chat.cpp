@@ -172,6 +172,7 @@ ChatCommand* ChatHandler::getCommandTable()
     static ChatCommand characterCommandTable[] =
     {
         { "achievements",   SEC_GAMEMASTER,     true,  &ChatHandler::HandleCharacterAchievementsCommand, "", nullptr },
+        { "convertlists",   SEC_CONSOLE,        true,  &ChatHandler::HandleCharacterConvertListsCommand, "", nullptr },
         { "customize",      SEC_GAMEMASTER,     true,  &ChatHandler::HandleCharacterCustomizeCommand,  "", nullptr },
         { "deleted",        SEC_GAMEMASTER,     true,  nullptr,                                           "", characterDeletedCommandTable},
         { "erase",          SEC_CONSOLE,        true,  &ChatHandler::HandleCharacterEraseCommand,      "", nullptr },
@@ -246,6 +247,13 @@ ChatCommand* ChatHandler::getCommandTable()
     {
         { "tempspawn",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleShowTemporarySpawnList,          "", nullptr },
         { "gridsloaded",    SEC_ADMINISTRATOR,  false, &ChatHandler::HandleGridsLoadedCount,                "", nullptr },
+        { "areacache",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleAreaCacheStats,                  "", nullptr },
+        { "visibility",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleVisibilityStats,                 "", nullptr },
+        { "updatebuffers",  SEC_ADMINISTRATOR,  false, &ChatHandler::HandleUpdateBufferStats,               "", nullptr },
+        { "creatureupdates", SEC_ADMINISTRATOR, false, &ChatHandler::HandleCreatureUpdateStats,             "", nullptr },
+        { "opcodes",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleOpcodeLatencyStats,              "", nullptr },
+        { "sessions",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleSessionHandlerTimeStats,         "", nullptr },
+        { "trace",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleTraceDump,                       "", nullptr },
         { nullptr,          0,                  false, nullptr,                                             "", nullptr }
     };
 
@@ -247,6 +247,7 @@ class ChatHandler
         bool HandleCastTargetCommand(char* args);
 
         bool HandleCharacterAchievementsCommand(char* args);
+        bool HandleCharacterConvertListsCommand(char* args);
         bool HandleCharacterCustomizeCommand(char* args);
         bool HandleCharacterDeletedDeleteCommand(char* args);
         bool HandleCharacterDeletedListCommand(char* args);
@@ -297,6 +298,13 @@ class ChatHandler
 
         bool HandleShowTemporarySpawnList(char* args);
         bool HandleGridsLoadedCount(char* args);
+        bool HandleAreaCacheStats(char* args);
+        bool HandleVisibilityStats(char* args);
+        bool HandleUpdateBufferStats(char* args);
+        bool HandleCreatureUpdateStats(char* args);
+        bool HandleOpcodeLatencyStats(char* args);
+        bool HandleSessionHandlerTimeStats(char* args);
+        bool HandleTraceDump(char* args);
 
         bool HandleDebugPlayCinematicCommand(char* args);
         bool HandleDebugPlayMovieCommand(char* args);
@@ -5451,6 +5451,14 @@ bool ChatHandler::HandleMmapStatsCommand(char* /*args*/)
     PSendSysMessage(" %u triangles (%u vertices)", triCount, triVertCount);
     PSendSysMessage(" %.2f MB of data (not including pointers)", ((float)dataSize / sizeof(unsigned char)) / 1048576);
 
+    if (MMAP::PolyPathCache const* pathCache = manager->GetPolyPathCache(m_session->GetPlayer()->GetMapId(), m_session->GetPlayer()->GetInstanceId()))
+    {
+        uint64 lookups = pathCache->GetHits() + pathCache->GetMisses();
+        PSendSysMessage("Path cache on current map:");
+        PSendSysMessage(" %u corridors cached", pathCache->GetSize());
+        PSendSysMessage(" " UI64FMTD " lookups, %.1f%% hits", lookups, lookups ? float(pathCache->GetHits()) * 100.0f / lookups : 0.0f);
+    }
+
     return true;
 }
 
@@ -36,6 +36,8 @@
 #include "Cinematics/M2Stores.h"
 #include "Entities/Transports.h"
 #include "World/World.h"
+#include "Server/OpcodeProfiler.h"
+#include "Util/Trace.h"
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1465,6 +1467,145 @@ bool ChatHandler::HandleGridsLoadedCount(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleAreaCacheStats(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    if (!player)
+        return false;
+
+    TerrainInfo const* terrain = player->GetTerrain();
+    uint64 hits = terrain->GetAreaCacheHits();
+    uint64 lookups = hits + terrain->GetAreaCacheMisses();
+    PSendSysMessage("Area cache of map %u: " UI64FMTD " lookups, %.1f%% hits.", terrain->GetMapId(), lookups, lookups ? float(hits) * 100.0f / lookups : 0.0f);
+
+    hits = terrain->GetLosCacheHits();
+    lookups = hits + terrain->GetLosCacheMisses();
+    PSendSysMessage("LOS cache of map %u: " UI64FMTD " lookups, %.1f%% hits.", terrain->GetMapId(), lookups, lookups ? float(hits) * 100.0f / lookups : 0.0f);
+    return true;
+}
+
+bool ChatHandler::HandleVisibilityStats(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    if (!player)
+        return false;
+
+    Map* map = player->GetMap();
+    Map::VisibilityStats const& stats = map->GetVisibilityStats();
+    uint64 objects = stats.checkedObjects + stats.skippedObjects;
+    PSendSysMessage("Visibility of map %u instance %u: " UI64FMTD " full and " UI64FMTD " move passes, " UI64FMTD " objects, %.1f%% skipped as stable, " UI64FMTD " ms total.",
+                    map->GetId(), map->GetInstanceId(), stats.fullPasses, stats.movePasses, objects, objects ? float(stats.skippedObjects) * 100.0f / objects : 0.0f, stats.totalTime / 1000);
+    return true;
+}
+
+bool ChatHandler::HandleUpdateBufferStats(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    if (!player)
+        return false;
+
+    Map* map = player->GetMap();
+    Map::UpdateBufferStats const& stats = map->GetUpdateBufferStats();
+    uint64 buffers = stats.reusedBuffers + stats.newBuffers;
+    PSendSysMessage("Object updates of map %u instance %u: " UI64FMTD " ticks, " UI64FMTD " packets (" UI64FMTD " compressed), " UI64FMTD " bytes built, " UI64FMTD " bytes sent.",
+                    map->GetId(), map->GetInstanceId(), stats.ticks, stats.packets, stats.compressedPackets, stats.rawBytes, stats.sentBytes);
+    PSendSysMessage("Player update buffers: " UI64FMTD " used, %.1f%% reused from previous ticks.",
+                    buffers, buffers ? float(stats.reusedBuffers) * 100.0f / buffers : 0.0f);
+    return true;
+}
+
+bool ChatHandler::HandleCreatureUpdateStats(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    if (!player)
+        return false;
+
+    Map* map = player->GetMap();
+    Map::CreatureUpdateStats const& stats = map->GetCreatureUpdateStats();
+    uint64 ticks = stats.fullUpdates + stats.idleUpdates + stats.skippedUpdates;
+    PSendSysMessage("Creature updates of map %u instance %u: " UI64FMTD " full, " UI64FMTD " idle, " UI64FMTD " skipped (%.1f%% of creature ticks).",
+                    map->GetId(), map->GetInstanceId(), stats.fullUpdates, stats.idleUpdates, stats.skippedUpdates, ticks ? float(stats.skippedUpdates) * 100.0f / ticks : 0.0f);
+    return true;
+}
+
+bool ChatHandler::HandleOpcodeLatencyStats(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        sOpcodeProfiler.Reset();
+        SendSysMessage("Opcode handler latency stats reset.");
+        return true;
+    }
+
+    uint32 count = 10;
+    ExtractOptUInt32(&args, count, 10);
+
+    if (!sWorld.getConfig(CONFIG_UINT32_OPCODE_PROFILER_SAMPLE_RATE))
+        SendSysMessage("Opcode profiler is disabled (OpcodeProfiler.SampleRate = 0), showing old samples only.");
+
+    std::vector<OpcodeLatencyReport> report = sOpcodeProfiler.GetReport();
+    PSendSysMessage("Slowest opcode handlers by sampled total time (%u of " SIZEFMTD "):", std::min(count, uint32(report.size())), report.size());
+    for (uint32 i = 0; i < report.size() && i < count; ++i)
+    {
+        OpcodeLatencyReport const& stats = report[i];
+        PSendSysMessage("%s: %u samples, avg %u us, p50 <= %u us, p99 <= %u us, max %u us", LookupOpcodeName(stats.opcode), stats.samples,
+                        uint32(stats.totalTime / stats.samples), stats.p50, stats.p99, stats.maxTime);
+    }
+    return true;
+}
+
+bool ChatHandler::HandleSessionHandlerTimeStats(char* args)
+{
+    uint32 count = 10;
+    ExtractOptUInt32(&args, count, 10);
+
+    std::vector<WorldSession const*> sessions;
+    sWorld.ExecuteForAllSessions([&sessions](WorldSession const& session)
+    {
+        if (session.GetHandlerTime())
+            sessions.push_back(&session);
+    });
+
+    std::sort(sessions.begin(), sessions.end(), [](WorldSession const* a, WorldSession const* b) { return a->GetHandlerTime() > b->GetHandlerTime(); });
+
+    PSendSysMessage("Sessions by estimated packet handler time (%u of " SIZEFMTD "):", std::min(count, uint32(sessions.size())), sessions.size());
+    for (uint32 i = 0; i < sessions.size() && i < count; ++i)
+    {
+        WorldSession const* session = sessions[i];
+        std::ostringstream recent;
+        for (auto const& sample : session->GetRecentHandlerSamples())
+            recent << " " << LookupOpcodeName(sample.first) << "(" << sample.second << ")";
+
+        PSendSysMessage("Account %u (%s): " UI64FMTD " ms, recent us:%s", session->GetAccountId(), session->GetPlayerName(),
+                        session->GetHandlerTime() / IN_MILLISECONDS, recent.str().c_str());
+    }
+    return true;
+}
+
+bool ChatHandler::HandleTraceDump(char* args)
+{
+    uint32 seconds = 10;
+    ExtractOptUInt32(&args, seconds, 10);
+
+    if (!Trace::IsEnabled())
+    {
+        SendSysMessage("Tracing is disabled, set Trace.Enable = 1 to record trace events.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    std::string const path = sWorld.DumpTrace(seconds);
+    if (path.empty())
+    {
+        SendSysMessage("The previous trace dump is still being written, try again later.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PSendSysMessage("Writing the trace events of the last %u seconds to %s", seconds, path.c_str());
+    return true;
+}
+
 bool ChatHandler::HandleDebugWaypoint(char* args)
 {
     Creature* target = getSelectedCreature();
@@ -22,6 +22,7 @@
 #include "Log.h"
 #include "Util/Errors.h"
 #include "Entities/Player.h"
+#include "World/World.h"
 
 Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl)
 {
@@ -143,11 +144,32 @@ template void Camera::UpdateVisibilityOf(Corpse*, UpdateData&, WorldObjectSet&);
 template void Camera::UpdateVisibilityOf(GameObject*, UpdateData&, WorldObjectSet&);
 template void Camera::UpdateVisibilityOf(DynamicObject*, UpdateData&, WorldObjectSet&);
 
-void Camera::UpdateVisibilityForOwner(bool addToWorld)
+void Camera::UpdateVisibilityForOwnerOnMove(float moved)
 {
-    MaNGOS::VisibleNotifier notifier(*this);
+    // positions seen between two relocation notifies differ by up to the relocation limit,
+    // so an object's last visibility check may have been done that much further away
+    float stableMargin = sqrt(World::GetRelocationLowerLimitSq()) + moved + 1.0f;
+
+    // long jumps leave almost nothing stable, skip the per object filter
+    if (stableMargin * 2 >= m_source->GetMap()->GetVisibilityDistance())
+        stableMargin = 0.0f;
+
+    VisibilityPass(false, stableMargin);
+}
+
+void Camera::VisibilityPass(bool addToWorld, float stableMargin)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    MaNGOS::VisibleNotifier notifier(*this, stableMargin);
     Cell::VisitAllObjects(m_source, notifier, addToWorld ? MAX_VISIBILITY_DISTANCE : m_source->GetVisibilityData().GetVisibilityDistance(), false);
     notifier.Notify();
+
+    Map::VisibilityStats& stats = m_source->GetMap()->GetVisibilityStats();
+    ++(stableMargin ? stats.movePasses : stats.fullPasses);
+    stats.checkedObjects += notifier.i_checked;
+    stats.skippedObjects += notifier.i_skipped;
+    stats.totalTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 }
 
 //////////////////
@@ -55,7 +55,9 @@ class Camera
 
         // updates visibility of worldobjects around viewpoint for camera's owner
         void UpdateVisibilityForOwner() { UpdateVisibilityForOwner(false); }
-        void UpdateVisibilityForOwner(bool addToWorld);
+        void UpdateVisibilityForOwner(bool addToWorld) { VisibilityPass(addToWorld, 0.0f); }
+        // after viewpoint relocation by moved yards only objects near the view distance edge can change visibility
+        void UpdateVisibilityForOwnerOnMove(float moved);
 
     private:
         // called when viewpoint changes visibility state
@@ -68,6 +70,8 @@ class Camera
         WorldObject* m_source;
 
         void UpdateForCurrentViewPoint();
+        // stableMargin 0 rechecks every object in view range
+        void VisibilityPass(bool addToWorld, float stableMargin);
 
     public:
         GridReference<Camera>& GetGridRef() { return m_gridRef; }
@@ -136,6 +140,15 @@ class ViewPoint
         {
             CameraCall(&Camera::UpdateVisibilityForOwner);
         }
+
+        void Call_UpdateVisibilityForOwnerOnMove(float moved)
+        {
+            for (CameraList::iterator itr = m_cameras.begin(); itr != m_cameras.end();)
+            {
+                Camera* c = *(itr++);
+                c->UpdateVisibilityForOwnerOnMove(moved);
+            }
+        }
 };
 
 #endif
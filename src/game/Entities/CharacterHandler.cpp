@@ -40,6 +40,7 @@
 #include "Calendar/Calendar.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Tools/Benchmark.h"
 
 #ifdef BUILD_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotMgr.h"
@@ -110,6 +111,11 @@ bool LoginQueryHolder::Initialize()
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILS,           "SELECT id,messageType,sender,receiver,subject,body,expire_time,deliver_time,money,cod,checked,stationery,mailTemplateId,has_items FROM mail WHERE receiver = '%u' ORDER BY id DESC", m_guid.GetCounter());
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS,     "SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, playedTime, text, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u'", m_guid.GetCounter());
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADRANDOMBATTLEGROUND, "SELECT guid FROM character_battleground_random WHERE guid = '%u'", m_guid.GetCounter());
+    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADPETS,            "SELECT id, entry, owner, modelid, level, exp, Reactstate, slot, name, renamed, curhealth, curmana, curhappiness, abdata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' ORDER BY id", m_guid.GetCounter());
+    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADPETDECLINEDNAMES, "SELECT id, genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = '%u'", m_guid.GetCounter());
+    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADPETSPELLS,       "SELECT guid, spell, active FROM pet_spell JOIN character_pet ON pet_spell.guid = character_pet.id WHERE character_pet.owner = '%u'", m_guid.GetCounter());
+    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADPETSPELLCOOLDOWNS, "SELECT guid, spell, time FROM pet_spell_cooldown JOIN character_pet ON pet_spell_cooldown.guid = character_pet.id WHERE character_pet.owner = '%u'", m_guid.GetCounter());
+    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADPETAURAS,        "SELECT guid, caster_guid, item_guid, spell, stackcount, remaincharges, basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask FROM pet_aura JOIN character_pet ON pet_aura.guid = character_pet.id WHERE character_pet.owner = '%u'", m_guid.GetCounter());
 
     return res;
 }
@@ -161,10 +167,26 @@ class CharacterHandler
             // The bot's WorldSession is deleted by PlayerbotMgr::LogoutPlayerBot
             WorldSession* botSession = new WorldSession(lqh->GetAccountId(), nullptr, SEC_PLAYER, masterSession->GetExpansion(), 0, DEFAULT_LOCALE, masterSession->GetAccountName(), 0, masterSession->GetRecruitingFriendId(), false);
             botSession->SetNoAnticheat();
+            botSession->SetOpcodeInterest(PlayerbotAI::GetOutgoingPacketInterest());
             botSession->HandlePlayerLogin(lqh); // will delete lqh
             masterSession->GetPlayer()->GetPlayerbotMgr()->OnBotLogin(botSession->GetPlayer());
         }
 #endif
+
+        // Benchmark players get a socketless session like bots, but without a master
+        // The session is owned and deleted by BenchmarkMgr
+        void HandleBenchmarkLoginCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder)
+        {
+            if (!holder)
+                return;
+
+            LoginQueryHolder* lqh = (LoginQueryHolder*) holder;
+
+            WorldSession* session = new WorldSession(lqh->GetAccountId(), nullptr, SEC_PLAYER, sWorld.getConfig(CONFIG_UINT32_EXPANSION), 0, DEFAULT_LOCALE, "", 0, 0, false);
+            session->SetNoAnticheat();
+            session->HandlePlayerLogin(lqh); // will delete lqh
+            sBenchmarkMgr.OnPlayerLogin(session);
+        }
 } chrHandler;
 
 void WorldSession::HandleCharEnum(QueryResult* result)
@@ -673,6 +695,17 @@ void PlayerbotMgr::LoginPlayerBot(ObjectGuid playerGuid)
 }
 #endif
 
+void BenchmarkMgr::LoginPlayer(uint32 accountId, ObjectGuid guid)
+{
+    LoginQueryHolder* holder = new LoginQueryHolder(accountId, guid);
+    if (!holder->Initialize())
+    {
+        delete holder;                                      // delete all unprocessed queries
+        return;
+    }
+    CharacterDatabase.DelayQueryHolder(&chrHandler, &CharacterHandler::HandleBenchmarkLoginCallback, holder);
+}
+
 void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
 {
     ObjectGuid playerGuid = holder->GetGuid();
@@ -773,6 +806,7 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
 
             guild->DisplayGuildBankTabsInfo(this);
 
+            guild->MemberLoggedIn(pCurrChar);
             guild->BroadcastEvent(GE_SIGNED_ON, pCurrChar->GetObjectGuid(), pCurrChar->GetName());
         }
         else
@@ -1016,6 +1050,7 @@ void WorldSession::HandlePlayerReconnect()
             SendPacket(data);
             DEBUG_LOG("WORLD: Sent guild-motd (SMSG_GUILD_EVENT)");
 
+            guild->MemberLoggedIn(_player);
             guild->BroadcastEvent(GE_SIGNED_ON, _player->GetObjectGuid(), _player->GetName());
         }
         else
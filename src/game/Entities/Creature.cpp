@@ -45,6 +45,7 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "Grids/CellImpl.h"
 #include "Movement/MoveSplineInit.h"
+#include "Movement/MoveSpline.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "Entities/Transports.h"
 #include "Maps/SpawnManager.h"
@@ -141,7 +142,8 @@ Creature::Creature(CreatureSubtype subtype) : Unit(),
     m_lootStatus(CREATURE_LOOT_STATUS_NONE),
     m_corpseAccelerationDecayDelay(MINIMUM_LOOTING_TIME),
     m_respawnTime(0), m_respawnDelay(25), m_respawnOverriden(false), m_respawnOverrideOnce(false), m_corpseDelay(60), m_canAggro(false),
-    m_respawnradius(5.0f), m_interactionPauseTimer(0), m_subtype(subtype), m_defaultMovementType(IDLE_MOTION_TYPE),
+    m_respawnradius(5.0f), m_interactionPauseTimer(0),
+    m_idleUpdateDiff(0), m_idlePlayerCheckTimer(0), m_idlePlayerNear(false), m_subtype(subtype), m_defaultMovementType(IDLE_MOTION_TYPE),
     m_equipmentId(0), m_detectionRange(20.f), m_AlreadyCallAssistance(false), m_canCallForAssistance(true),
     m_temporaryFactionFlags(TEMPFACTION_NONE),
     m_originalEntry(0), m_gameEventVendorId(0),
@@ -716,8 +718,70 @@ uint32 Creature::ChooseDisplayId(const CreatureInfo* cinfo, const CreatureData*
     return display_id;
 }
 
-void Creature::Update(const uint32 diff)
+bool Creature::IsIdleForUpdate() const
 {
+    if (IsInCombat() || GetCombatManager().IsInEvadeMode())
+        return false;
+
+    // controlled, scripted to stay active or carrying something which needs smooth updates
+    if (isActiveObject() || GetMasterGuid() || IsVehicle() || IsBoarded())
+        return false;
+
+    if (!movespline->Finalized() || IsNonMeleeSpellCasted(false) || m_events.HasEvents())
+        return false;
+
+    return true;
+}
+
+bool Creature::SkipIdleUpdate(uint32 diff)
+{
+    uint32 interval = sWorld.getConfig(CONFIG_UINT32_CREATURE_IDLE_UPDATE_INTERVAL);
+    if (!interval || m_deathState != ALIVE || !IsIdleForUpdate())
+    {
+        m_idlePlayerCheckTimer = 0;                         // search again as soon as it becomes idle
+        return false;
+    }
+
+    // players around are searched at most once per interval
+    if (m_idlePlayerCheckTimer <= diff)
+    {
+        Player* player = nullptr;
+        MaNGOS::AnyPlayerInObjectRangeCheck check(this, sWorld.getConfig(CONFIG_FLOAT_CREATURE_IDLE_UPDATE_PLAYER_DISTANCE));
+        MaNGOS::PlayerSearcher<MaNGOS::AnyPlayerInObjectRangeCheck> searcher(player, check);
+        Cell::VisitWorldObjects(this, searcher, sWorld.getConfig(CONFIG_FLOAT_CREATURE_IDLE_UPDATE_PLAYER_DISTANCE));
+
+        m_idlePlayerNear = player != nullptr;
+        m_idlePlayerCheckTimer = interval;
+    }
+    else
+        m_idlePlayerCheckTimer -= diff;
+
+    if (m_idlePlayerNear || m_idleUpdateDiff + diff >= interval)
+        return false;
+
+    m_idleUpdateDiff += diff;
+    return true;
+}
+
+void Creature::Update(const uint32 tickDiff)
+{
+    Map::CreatureUpdateStats& stats = GetMap()->GetCreatureUpdateStats();
+    if (SkipIdleUpdate(tickDiff))
+    {
+        ++stats.skippedUpdates;
+        return;
+    }
+
+    // timers advance by the whole time since the last real update
+    uint32 const diff = tickDiff + m_idleUpdateDiff;
+    if (m_idleUpdateDiff)
+    {
+        ++stats.idleUpdates;
+        m_idleUpdateDiff = 0;
+    }
+    else
+        ++stats.fullUpdates;
+
     switch (m_deathState)
     {
         case JUST_ALIVED:
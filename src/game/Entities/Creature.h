@@ -892,6 +892,10 @@ class Creature : public Unit
 
         bool IsCorpseExpired() const;
 
+        // idle creatures far from players are updated at CONFIG_UINT32_CREATURE_IDLE_UPDATE_INTERVAL
+        bool IsIdleForUpdate() const;
+        bool SkipIdleUpdate(uint32 diff);
+
         // vendor items
         VendorItemCounts m_vendorItemCounts;
 
@@ -914,6 +918,9 @@ class Creature : public Unit
         bool m_checkForHelp;                                // controls checkforhelp in ai
         float m_respawnradius;
         uint32 m_interactionPauseTimer;                     // (msecs) waypoint pause time when interacted with
+        uint32 m_idleUpdateDiff;                            // (msecs) time skipped by idle updates, added to the next real one
+        uint32 m_idlePlayerCheckTimer;                      // (msecs) until players around are searched again
+        bool m_idlePlayerNear;
 
         CreatureSubtype m_subtype;                          // set in Creatures subclasses for fast it detect without dynamic_cast use
         void RegeneratePower(float timerMultiplier);
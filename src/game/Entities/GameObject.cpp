@@ -615,7 +615,7 @@ void GameObject::Update(const uint32 diff)
             switch (GetGoType())
             {
                 case GAMEOBJECT_TYPE_TRAP:
-                    if (m_events.GetEvents().size() > 0)
+                    if (m_events.HasEvents())
                     {
                         preventDespawn = true;
                         break;
@@ -2865,6 +2865,31 @@ bool GameObject::_IsWithinDist(WorldObject const* obj, float dist2compare, bool
     return IsAtInteractDistance(obj->GetPosition(), obj->GetCombatReach() + dist2compare, is3D);
 }
 
+void GameObject::GetVisibilityBounds(float dist2compare, float& inner, float& outer) const
+{
+    if (GetGoType() == GAMEOBJECT_TYPE_TRAP && GetGOInfo()->GetLockId() == 12)
+    {
+        inner = outer = dist2compare;
+        return;
+    }
+
+    GameObjectDisplayInfoEntry const* displayInfo = m_displayInfo;
+    if (!displayInfo)
+    {
+        inner = outer = dist2compare;
+        return;
+    }
+
+    // interact box is rotated freely, so use the spheres inside and around it
+    float scale = GetObjectScale();
+    float minExtent = std::min({ -displayInfo->minX, displayInfo->maxX, -displayInfo->minY, displayInfo->maxY, -displayInfo->minZ, displayInfo->maxZ }) * scale;
+    float dx = std::max(-displayInfo->minX, displayInfo->maxX) * scale + dist2compare;
+    float dy = std::max(-displayInfo->minY, displayInfo->maxY) * scale + dist2compare;
+    float dz = std::max(-displayInfo->minZ, displayInfo->maxZ) * scale + dist2compare;
+    inner = dist2compare + minExtent;
+    outer = sqrt(dx * dx + dy * dy + dz * dz);
+}
+
 bool GameObject::IsAtInteractDistance(Position const& pos, float radius, bool is3D) const
 {
     if (GameObjectDisplayInfoEntry const* displayInfo = m_displayInfo)
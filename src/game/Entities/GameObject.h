@@ -933,6 +933,8 @@ class GameObject : public WorldObject
         void UpdateModelPosition();
 
         bool _IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D) const override;
+        // 2d distances from the object position within which _IsWithinDist with dist2compare is always true, beyond outer always false
+        void GetVisibilityBounds(float dist2compare, float& inner, float& outer) const;
 
         bool IsAtInteractDistance(Position const& pos, float radius, bool is3D = true) const;
         bool IsAtInteractDistance(Player const* player, uint32 maxRange = 0) const;
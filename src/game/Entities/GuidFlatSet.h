@@ -0,0 +1,236 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_GUID_FLAT_SET_H
+#define MANGOS_GUID_FLAT_SET_H
+
+#include "Entities/ObjectGuid.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+// Open addressing (linear probing) hash set of ObjectGuid stored in one contiguous array
+// Meant for hot lookup paths like Player::HasAtClient where std::set does a tree walk per call
+// Erased slots are marked deleted so erasing while iterating is safe, like with std::set
+// Iteration order is unspecified
+class GuidFlatSet
+{
+    private:
+        static uint64 constexpr EMPTY_SLOT = 0;             // empty guid is never stored
+        static uint64 constexpr DELETED_SLOT = ~uint64(0);
+        static size_t constexpr MIN_CAPACITY = 16;
+
+    public:
+        class const_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef ObjectGuid value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef ObjectGuid const* pointer;
+                typedef ObjectGuid const& reference;
+
+                const_iterator() : m_slot(nullptr), m_end(nullptr) {}
+                const_iterator(ObjectGuid const* slot, ObjectGuid const* end) : m_slot(slot), m_end(end) { SkipFree(); }
+
+                reference operator*() const { return *m_slot; }
+                pointer operator->() const { return m_slot; }
+
+                const_iterator& operator++() { ++m_slot; SkipFree(); return *this; }
+                const_iterator operator++(int) { const_iterator tmp = *this; ++*this; return tmp; }
+
+                bool operator==(const_iterator const& other) const { return m_slot == other.m_slot; }
+                bool operator!=(const_iterator const& other) const { return m_slot != other.m_slot; }
+
+            private:
+                friend class GuidFlatSet;
+
+                void SkipFree()
+                {
+                    while (m_slot != m_end && (m_slot->GetRawValue() == EMPTY_SLOT || m_slot->GetRawValue() == DELETED_SLOT))
+                        ++m_slot;
+                }
+
+                ObjectGuid const* m_slot;
+                ObjectGuid const* m_end;
+        };
+        typedef const_iterator iterator;
+
+        GuidFlatSet() : m_size(0), m_deleted(0) {}
+
+        const_iterator begin() const { return const_iterator(m_slots.data(), m_slots.data() + m_slots.size()); }
+        const_iterator end() const { return const_iterator(m_slots.data() + m_slots.size(), m_slots.data() + m_slots.size()); }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        const_iterator find(ObjectGuid guid) const
+        {
+            size_t slot;
+            if (!FindSlot(guid.GetRawValue(), slot))
+                return end();
+            return const_iterator(m_slots.data() + slot, m_slots.data() + m_slots.size());
+        }
+
+        size_t count(ObjectGuid guid) const
+        {
+            size_t slot;
+            return FindSlot(guid.GetRawValue(), slot) ? 1 : 0;
+        }
+
+        bool insert(ObjectGuid guid)
+        {
+            uint64 raw = guid.GetRawValue();
+            MANGOS_ASSERT(raw != EMPTY_SLOT && raw != DELETED_SLOT);
+
+            if ((m_size + m_deleted + 1) * 4 > m_slots.size() * 3)
+                Rehash(m_size + 1);
+
+            size_t mask = m_slots.size() - 1;
+            size_t firstDeleted = m_slots.size();
+            for (size_t slot = Hash(raw) & mask;; slot = (slot + 1) & mask)
+            {
+                uint64 current = m_slots[slot].GetRawValue();
+                if (current == raw)
+                    return false;
+
+                if (current == DELETED_SLOT)
+                {
+                    if (firstDeleted == m_slots.size())
+                        firstDeleted = slot;
+                    continue;
+                }
+
+                if (current == EMPTY_SLOT)
+                {
+                    if (firstDeleted != m_slots.size())
+                    {
+                        slot = firstDeleted;
+                        --m_deleted;
+                    }
+
+                    m_slots[slot] = guid;
+                    ++m_size;
+                    return true;
+                }
+            }
+        }
+
+        template<class InputIterator>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+
+        size_t erase(ObjectGuid guid)
+        {
+            size_t slot;
+            if (!FindSlot(guid.GetRawValue(), slot))
+                return 0;
+
+            EraseSlot(slot);
+            return 1;
+        }
+
+        // returns iterator to the next element, other iterators stay valid
+        const_iterator erase(const_iterator itr)
+        {
+            EraseSlot(size_t(itr.m_slot - m_slots.data()));
+            return ++itr;
+        }
+
+        void clear()
+        {
+            m_slots.clear();
+            m_size = 0;
+            m_deleted = 0;
+        }
+
+        void reserve(size_t count) { if ((count + m_deleted) * 4 > m_slots.size() * 3) Rehash(count); }
+
+    private:
+        static size_t Hash(uint64 raw)
+        {
+            // 64 bit finalizer of murmur3, guid counters are sequential so low bits need mixing
+            raw ^= raw >> 33;
+            raw *= 0xff51afd7ed558ccdULL;
+            raw ^= raw >> 33;
+            raw *= 0xc4ceb9fe1a85ec53ULL;
+            raw ^= raw >> 33;
+            return size_t(raw);
+        }
+
+        bool FindSlot(uint64 raw, size_t& slot) const
+        {
+            if (m_slots.empty() || raw == EMPTY_SLOT)
+                return false;
+
+            size_t mask = m_slots.size() - 1;
+            for (slot = Hash(raw) & mask;; slot = (slot + 1) & mask)
+            {
+                uint64 current = m_slots[slot].GetRawValue();
+                if (current == raw)
+                    return true;
+                if (current == EMPTY_SLOT)
+                    return false;
+            }
+        }
+
+        void EraseSlot(size_t slot)
+        {
+            m_slots[slot] = ObjectGuid(DELETED_SLOT);
+            --m_size;
+            ++m_deleted;
+
+            // no live elements left - drop all tombstones at once
+            if (!m_size)
+            {
+                std::fill(m_slots.begin(), m_slots.end(), ObjectGuid());
+                m_deleted = 0;
+            }
+        }
+
+        void Rehash(size_t count)
+        {
+            // at most half full afterwards, so the next rehash is at least a quarter of the table away
+            size_t capacity = MIN_CAPACITY;
+            while (capacity < count * 2)
+                capacity <<= 1;
+
+            // only shrink once below a quarter load, churn around one size then only purges tombstones
+            if (capacity < m_slots.size() && count * 4 >= m_slots.size())
+                capacity = m_slots.size();
+
+            std::vector<ObjectGuid> oldSlots(capacity);
+            oldSlots.swap(m_slots);
+            m_size = 0;
+            m_deleted = 0;
+
+            for (ObjectGuid const& guid : oldSlots)
+                if (guid.GetRawValue() != EMPTY_SLOT && guid.GetRawValue() != DELETED_SLOT)
+                    insert(guid);
+        }
+
+        std::vector<ObjectGuid> m_slots;                    // size is always 0 or power of 2
+        size_t m_size;
+        size_t m_deleted;
+};
+
+#endif
@@ -24,6 +24,7 @@
 #include "Entities/ItemEnchantmentMgr.h"
 #include "Server/SQLStorages.h"
 #include "Loot/LootMgr.h"
+#include "World/World.h"
 #include "Spells/SpellTargetDefines.h"
 #include "Spells/SpellEffectDefines.h"
 
@@ -310,14 +311,10 @@ void Item::SaveToDB()
 
             stmt->addUInt32(GetUInt32Value(ITEM_FIELD_FLAGS));
 
-            std::ostringstream ssEnchants;
-            for (uint8 i = 0; i < MAX_ENCHANTMENT_SLOT; ++i)
-            {
-                ssEnchants << GetEnchantmentId(EnchantmentSlot(i)) << ' ';
-                ssEnchants << GetEnchantmentDuration(EnchantmentSlot(i)) << ' ';
-                ssEnchants << GetEnchantmentCharges(EnchantmentSlot(i)) << ' ';
-            }
-            stmt->addString(ssEnchants.str());
+            // id, duration and charges of every slot, in field order
+            std::string enchants;
+            AppendUInt32List(enchants, &m_uint32Values[ITEM_FIELD_ENCHANTMENT_1_1], MAX_ENCHANTMENT_SLOT * MAX_ENCHANTMENT_OFFSET, sWorld.getConfig(CONFIG_BOOL_SAVE_BINARY_NUMBER_LISTS));
+            stmt->addString(enchants);
 
             stmt->addInt16(GetItemRandomPropertyId());
             stmt->addUInt16(GetUInt32Value(ITEM_FIELD_DURABILITY));
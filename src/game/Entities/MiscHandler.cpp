@@ -41,6 +41,7 @@
 #include "OutdoorPvP/OutdoorPvP.h"
 #include "Entities/Pet.h"
 #include "Social/SocialMgr.h"
+#include "Social/WhoListIndex.h"
 #include "Server/DBCEnums.h"
 #include "GMTickets/GMTicketMgr.h"
 
@@ -152,117 +153,88 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recv_data)
     data << uint32(matchcount);                             // placeholder, count of players matching criteria
     data << uint32(displaycount);                           // placeholder, count of players displayed
 
-    // TODO: Guard Player map
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    // with a match cap the scan can stop once the cap and the display limit are reached
+    uint32 matchLimit = sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS);
+    if (matchLimit)
+        matchLimit = std::max<uint32>(matchLimit, 49);
+
+    sWhoListIndex.Visit(level_min, level_max, zoneids, zones_count, [&](WhoListEntry const& entry)
     {
-        Player* pl = itr->second;
+        Player* pl = entry.player;
 
         if (security == SEC_PLAYER)
         {
             // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
             if (pl->GetTeam() != team && !allowTwoSideWhoList)
-                continue;
+                return true;
 
             // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
             if (pl->GetSession()->GetSecurity() > gmLevelInWhoList)
-                continue;
+                return true;
         }
 
-        // do not process players which are not in world
-        if (!pl->IsInWorld())
-            continue;
-
-        // check if target is globally visible for player
-        if (!pl->IsVisibleGloballyFor(_player))
-            continue;
-
-        // check if target's level is in level range
-        uint32 lvl = pl->GetLevel();
-        if (lvl < level_min || lvl > level_max)
-            continue;
-
         // check if class matches classmask
-        uint32 class_ = pl->getClass();
-        if (!(classmask & (1 << class_)))
-            continue;
+        if (!(classmask & (1 << entry.playerClass)))
+            return true;
 
         // check if race matches racemask
-        uint32 race = pl->getRace();
-        if (!(racemask & (1 << race)))
-            continue;
+        if (!(racemask & (1 << entry.race)))
+            return true;
 
-        uint32 pzoneid = pl->GetZoneId();
-        uint8 gender = pl->getGender();
-
-        bool z_show = true;
-        for (uint32 i = 0; i < zones_count; ++i)
-        {
-            if (zoneids[i] == pzoneid)
-            {
-                z_show = true;
-                break;
-            }
+        if (!(wplayer_name.empty() || entry.lowerName.find(wplayer_name) != std::wstring::npos))
+            return true;
 
-            z_show = false;
-        }
-        if (!z_show)
-            continue;
+        if (!(wguild_name.empty() || entry.lowerGuildName.find(wguild_name) != std::wstring::npos))
+            return true;
 
-        std::string pname = pl->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname, wpname))
-            continue;
-        wstrToLower(wpname);
-
-        if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
-            continue;
-
-        std::string gname = sGuildMgr.GetGuildNameById(pl->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname, wgname))
-            continue;
-        wstrToLower(wgname);
-
-        if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
-            continue;
-
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(pzoneid))
-            aname = areaEntry->area_name[GetSessionDbcLocale()];
-
-        bool s_show = true;
-        for (uint32 i = 0; i < str_count; ++i)
+        if (str_count)
         {
-            if (!str[i].empty())
+            std::string aname;
+            if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(entry.zoneId))
+                aname = areaEntry->area_name[GetSessionDbcLocale()];
+
+            bool s_show = true;
+            for (uint32 i = 0; i < str_count; ++i)
             {
-                if (wgname.find(str[i]) != std::wstring::npos ||
-                        wpname.find(str[i]) != std::wstring::npos ||
-                        Utf8FitTo(aname, str[i]))
+                if (!str[i].empty())
                 {
-                    s_show = true;
-                    break;
+                    if (entry.lowerGuildName.find(str[i]) != std::wstring::npos ||
+                            entry.lowerName.find(str[i]) != std::wstring::npos ||
+                            Utf8FitTo(aname, str[i]))
+                    {
+                        s_show = true;
+                        break;
+                    }
+                    s_show = false;
                 }
-                s_show = false;
             }
+            if (!s_show)
+                return true;
         }
-        if (!s_show)
-            continue;
+
+        // do not process players which are not in world
+        if (!pl->IsInWorld())
+            return true;
+
+        // check if target is globally visible for player
+        if (!pl->IsVisibleGloballyFor(_player))
+            return true;
 
         // 49 is maximum player count sent to client
         if (++matchcount > 49)
-            continue;
+            return !matchLimit || matchcount < matchLimit;
 
         ++displaycount;
 
-        data << pname;                                      // player name
-        data << gname;                                      // guild name
-        data << uint32(lvl);                                // player level
-        data << uint32(class_);                             // player class
-        data << uint32(race);                               // player race
-        data << uint8(gender);                              // player gender
-        data << uint32(pzoneid);                            // player zone id
-    }
+        data << entry.name;                                 // player name
+        data << entry.guildName;                            // guild name
+        data << uint32(entry.level);                        // player level
+        data << uint32(entry.playerClass);                  // player class
+        data << uint32(entry.race);                         // player race
+        data << uint8(entry.gender);                        // player gender
+        data << uint32(entry.zoneId);                       // player zone id
+        return true;
+    });
 
     if (sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS) && matchcount > sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS))
         matchcount = sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS);
@@ -528,50 +528,40 @@ void WorldSession::SendStablePet(ObjectGuid guid) const
             firstSlot = PET_SAVE_AS_CURRENT;
         else
         {
-            QueryResult* result = CharacterDatabase.PQuery("SELECT owner, id, entry, level, name FROM character_pet WHERE owner = '%u' AND slot = '%u' ORDER BY slot",
-                _player->GetGUIDLow(), uint32(PET_SAVE_NOT_IN_SLOT));
-
-            if (result) // dismissed pet
+            // dismissed pet
+            for (auto const& itr : _player->GetPetCache().GetEntries())
             {
-                do
-                {
-                    Field* fields = result->Fetch();
-
-                    data << uint32(fields[1].GetUInt32());          // petnumber
-                    data << uint32(fields[2].GetUInt32());          // creature entry
-                    data << uint32(fields[3].GetUInt32());          // level
-                    data << fields[4].GetString();                  // name
-                    data << uint8(0x01);                            // active
+                PetCacheEntry const& petData = itr.second;
+                if (petData.slot != uint32(PET_SAVE_NOT_IN_SLOT))
+                    continue;
 
-                    ++num;
-                } while (result->NextRow());
+                data << uint32(petData.petNumber);          // petnumber
+                data << uint32(petData.entry);              // creature entry
+                data << uint32(petData.level);              // level
+                data << petData.name;                       // name
+                data << uint8(0x01);                        // active
 
-                delete result;
+                ++num;
             }
         }
     }
 
-    //                                                     0      1     2   3      4      5
-    QueryResult* result = CharacterDatabase.PQuery("SELECT owner, slot, id, entry, level, name FROM character_pet WHERE owner = '%u' AND slot >= '%u' AND slot <= '%u' ORDER BY slot",
-                          _player->GetGUIDLow(), uint32(firstSlot), uint32(PET_SAVE_LAST_STABLE_SLOT));
-
-    if (result)
+    for (uint32 slot = firstSlot; slot <= uint32(PET_SAVE_LAST_STABLE_SLOT); ++slot)
     {
-        do
+        for (auto const& itr : _player->GetPetCache().GetEntries())
         {
-            Field* fields = result->Fetch();
+            PetCacheEntry const& petData = itr.second;
+            if (petData.slot != slot)
+                continue;
 
-            data << uint32(fields[2].GetUInt32());          // petnumber
-            data << uint32(fields[3].GetUInt32());          // creature entry
-            data << uint32(fields[4].GetUInt32());          // level
-            data << fields[5].GetString();                  // name
+            data << uint32(petData.petNumber);              // petnumber
+            data << uint32(petData.entry);                  // creature entry
+            data << uint32(petData.level);                  // level
+            data << petData.name;                           // name
             data << uint8(0x3);                             // inactive - stabled
 
             ++num;
         }
-        while (result->NextRow());
-
-        delete result;
     }
 
     data.put<uint8>(wpos, num);                             // set real data to placeholder
@@ -669,29 +659,9 @@ void WorldSession::HandleStablePet(WorldPacket& recv_data)
         }
     }
 
-    uint32 free_slot = 1;
-
-    QueryResult* result = CharacterDatabase.PQuery("SELECT owner,slot,id FROM character_pet WHERE owner = '%u'  AND slot >= '%u' AND slot <= '%u' ORDER BY slot ",
-                          _player->GetGUIDLow(), PET_SAVE_FIRST_STABLE_SLOT, PET_SAVE_LAST_STABLE_SLOT);
-    if (result)
-    {
-        do
-        {
-            Field* fields = result->Fetch();
-
-            uint32 slot = fields[1].GetUInt32();
-
-            // slots ordered in query, and if not equal then free
-            if (slot != free_slot)
-                break;
-
-            // this slot not free, skip
-            ++free_slot;
-        }
-        while (result->NextRow());
-
-        delete result;
-    }
+    uint32 free_slot = uint32(PET_SAVE_FIRST_STABLE_SLOT);
+    while (free_slot <= uint32(PET_SAVE_LAST_STABLE_SLOT) && _player->GetPetCache().FindEntryBySlot(free_slot))
+        ++free_slot;
 
     if (free_slot > 0 && free_slot <= GetPlayer()->m_stableSlots)
     {
@@ -705,6 +675,7 @@ void WorldSession::HandleStablePet(WorldPacket& recv_data)
             SqlStatement ChangePetSlot = CharacterDatabase.CreateStatement(ChangePetSlot_ID, "UPDATE character_pet SET slot = ? WHERE owner = ? AND slot = ? ");
             ChangePetSlot.PExecute(free_slot, _player->GetObjectGuid().GetCounter(), uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT));
             CharacterDatabase.CommitTransaction();
+            _player->GetPetCache().ChangeSlot(uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT), free_slot);
         }
         SendStableResult(STABLE_SUCCESS_STABLE);
         _player->SetTemporaryUnsummonedPetNumber(0);
@@ -730,14 +701,11 @@ void WorldSession::HandleUnstablePet(WorldPacket& recv_data)
     uint32 creature_id = 0;
     uint32 slot = 0;
 
-    QueryResult* result = CharacterDatabase.PQuery("SELECT entry, slot FROM character_pet WHERE owner = '%u' AND id = '%u' AND slot >='%u' AND slot <= '%u'",
-                          _player->GetGUIDLow(), petnumber, PET_SAVE_FIRST_STABLE_SLOT, PET_SAVE_LAST_STABLE_SLOT);
-    if (result)
+    PetCacheEntry const* petData = _player->GetPetCache().GetEntry(petnumber);
+    if (petData && petData->slot >= uint32(PET_SAVE_FIRST_STABLE_SLOT) && petData->slot <= uint32(PET_SAVE_LAST_STABLE_SLOT))
     {
-        Field* fields = result->Fetch();
-        creature_id   = fields[0].GetUInt32();
-        slot          = fields[1].GetUInt32();
-        delete result;
+        creature_id   = petData->entry;
+        slot          = petData->slot;
     }
 
     if (!creature_id)
@@ -815,6 +783,7 @@ void WorldSession::HandleUnstablePet(WorldPacket& recv_data)
             SqlStatement ChangePetSlot = CharacterDatabase.CreateStatement(ChangePetSlot_ID, "UPDATE character_pet SET slot = ? WHERE owner = ? AND slot = ? ");
             ChangePetSlot.PExecute(slot, _player->GetObjectGuid().GetCounter(), uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT));
             CharacterDatabase.CommitTransaction();
+            _player->GetPetCache().ChangeSlot(uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT), slot);
             _player->SetTemporaryUnsummonedPetNumber(0);
         }
     }
@@ -924,19 +893,15 @@ void WorldSession::HandleStableSwapPet(WorldPacket& recv_data)
     }
 
     // find swapped pet slot in stable
-    QueryResult* result = CharacterDatabase.PQuery("SELECT slot,entry FROM character_pet WHERE owner = '%u' AND id = '%u'",
-                          _player->GetGUIDLow(), pet_number);
-    if (!result)
+    PetCacheEntry const* petData = _player->GetPetCache().GetEntry(pet_number);
+    if (!petData)
     {
         SendStableResult(STABLE_ERR_STABLE);
         return;
     }
 
-    Field* fields = result->Fetch();
-
-    uint32 slot        = fields[0].GetUInt32();
-    uint32 creature_id = fields[1].GetUInt32();
-    delete result;
+    uint32 slot        = petData->slot;
+    uint32 creature_id = petData->entry;
 
     if (!creature_id)
     {
@@ -962,6 +927,7 @@ void WorldSession::HandleStableSwapPet(WorldPacket& recv_data)
         SqlStatement ChangePetSlot = CharacterDatabase.CreateStatement(ChangePetSlot_ID, "UPDATE character_pet SET slot = ? WHERE owner = ? AND slot = ? ");
         ChangePetSlot.PExecute(slot, _player->GetObjectGuid().GetCounter(), uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT));
         CharacterDatabase.CommitTransaction();
+        _player->GetPetCache().ChangeSlot(uint32(_player->GetTemporaryUnsummonedPetNumber() ? PET_SAVE_AS_CURRENT : PET_SAVE_NOT_IN_SLOT), slot);
     }
 
     // summon unstabled pet
@@ -48,6 +48,49 @@
 #include "MotionGenerators/PathFinder.h"
 #include "Movement/MoveSpline.h"
 
+namespace
+{
+    // scratch masks, reused by every update built on this thread instead of allocating a new one each time
+    thread_local UpdateMask t_createUpdateMask;
+    thread_local UpdateMask t_valuesUpdateMask;
+
+    // scratch block, every block is copied into its UpdateData right after being built
+    thread_local ByteBuffer t_updateBlock(500);
+
+    ByteBuffer& GetUpdateBlockBuffer()
+    {
+        t_updateBlock.clear();
+        return t_updateBlock;
+    }
+
+    // values update blocks of the object currently processed by WorldObject::BuildUpdateData
+    // built once per observer class (see Object::GetValuesUpdateClassForTarget) and reused for all its observers
+    struct ValuesUpdateBlockCache
+    {
+        struct Entry
+        {
+            uint32 updateClass;
+            ByteBuffer block;                               // empty - nothing visible changed for this class
+        };
+
+        Object const* owner = nullptr;
+        std::vector<Entry> entries;                         // kept allocated between objects
+        size_t used = 0;
+    };
+
+    thread_local ValuesUpdateBlockCache t_valuesBlockCache;
+
+    struct ValuesUpdateBlockCacheScope
+    {
+        explicit ValuesUpdateBlockCacheScope(Object const* owner)
+        {
+            t_valuesBlockCache.owner = owner;
+            t_valuesBlockCache.used = 0;
+        }
+        ~ValuesUpdateBlockCacheScope() { t_valuesBlockCache.owner = nullptr; }
+    };
+}
+
 Object::Object(): m_updateFlag(0), m_itsNewObject(false), m_dbGuid(0)
 {
     m_objectTypeId      = TYPEID_OBJECT;
@@ -132,7 +175,7 @@ void Object::SendForcedObjectUpdate()
 
 void Object::BuildMovementUpdateBlock(UpdateData* data, uint16 flags) const
 {
-    ByteBuffer buf(500);
+    ByteBuffer& buf = GetUpdateBlockBuffer();
 
     buf << uint8(UPDATETYPE_MOVEMENT);
     buf << GetPackGUID();
@@ -180,15 +223,16 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
 
     // DEBUG_LOG("BuildCreateUpdate: update-type: %u, object-type: %u got updateFlags: %X", updatetype, m_objectTypeId, updateFlags);
 
-    ByteBuffer buf(500);
+    ByteBuffer& buf = GetUpdateBlockBuffer();
     buf << uint8(updatetype);
     buf << GetPackGUID();
     buf << uint8(m_objectTypeId);
 
     BuildMovementUpdate(&buf, updateFlags);
 
-    UpdateMask updateMask;
+    UpdateMask& updateMask = t_createUpdateMask;
     updateMask.SetCount(m_valuesCount);
+    updateMask.Clear();
     _SetCreateBits(updateMask, target);
     BuildValuesUpdate(updatetype, &buf, &updateMask, target);
     data->AddUpdateBlock(buf);
@@ -196,6 +240,9 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
 
 void Object::SendCreateUpdateToPlayer(Player* player) const
 {
+    if (!player->GetSession()->IsInterestedIn(SMSG_UPDATE_OBJECT))
+        return;
+
     // send create update to player
     UpdateData updateData;
     BuildCreateUpdateBlockForPlayer(&updateData, player);
@@ -209,14 +256,94 @@ void Object::SendCreateUpdateToPlayer(Player* player) const
 
 void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const
 {
-    UpdateMask updateMask;
+    UpdateMask& updateMask = t_valuesUpdateMask;
+
+    uint32 updateClass;
+    if (t_valuesBlockCache.owner == this && GetValuesUpdateClassForTarget(target, updateClass))
+    {
+        ValuesUpdateBlockCache& cache = t_valuesBlockCache;
+        for (size_t i = 0; i < cache.used; ++i)
+        {
+            if (cache.entries[i].updateClass == updateClass)
+            {
+                if (!cache.entries[i].block.empty())
+                    data.AddUpdateBlock(cache.entries[i].block);
+                return;
+            }
+        }
+
+        if (cache.used == cache.entries.size())
+            cache.entries.emplace_back();
+
+        ValuesUpdateBlockCache::Entry& entry = cache.entries[cache.used++];
+        entry.updateClass = updateClass;
+        entry.block.clear();
+
+        updateMask.SetCount(m_valuesCount);
+        updateMask.Clear();
+        _SetUpdateBits(updateMask, target);
+        if (updateMask.HasData())
+        {
+            BuildValuesUpdateBlock(entry.block, updateMask, target);
+            data.AddUpdateBlock(entry.block);
+        }
+        return;
+    }
+
     updateMask.SetCount(m_valuesCount);
+    updateMask.Clear();
 
     _SetUpdateBits(updateMask, target);
     if (updateMask.HasData())
         BuildValuesUpdateBlockForPlayer(data, updateMask, target);
 }
 
+// Observers whose values update block is byte-identical share one update class
+// Mask only depends on the visible field flags, values depend on the target only for the fields handled in BuildValuesUpdate
+// return false if the changed fields make the block specific to this target
+bool Object::GetValuesUpdateClassForTarget(Player const* target, uint32& updateClass) const
+{
+    if (target == this)
+        return false;
+
+    uint16 const* flags = nullptr;
+    updateClass = GetUpdateFieldFlagsForTarget(target, flags);
+
+    switch (GetTypeId())
+    {
+        case TYPEID_UNIT:
+        case TYPEID_PLAYER:
+        {
+            Unit const* unit = static_cast<Unit const*>(this);
+            if (unit->HasAuraState(AURA_STATE_CONFLAGRATE) || m_changedValues[UNIT_DYNAMIC_FLAGS])
+                return false;
+
+            if (GetTypeId() == TYPEID_UNIT && m_changedValues[UNIT_NPC_FLAGS])
+                return false;
+
+            if (GetTypeId() == TYPEID_PLAYER && m_changedValues[UNIT_FIELD_FACTIONTEMPLATE] && sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
+                return false;
+
+            // health is sent as percentage to targets without fog of war visibility
+            if (m_changedValues[UNIT_FIELD_HEALTH] || m_changedValues[UNIT_FIELD_MAXHEALTH])
+                if (!unit->IsFogOfWarVisibleHealth(target) && !target->CanSeeSpecialInfoOf(unit))
+                    updateClass |= 1 << 16;
+
+            // gamemasters always see units as selectable
+            if (m_changedValues[UNIT_FIELD_FLAGS] && target->IsGameMaster())
+                updateClass |= 1 << 17;
+            return true;
+        }
+        case TYPEID_GAMEOBJECT:
+            // dynamic field is always sent and depends on target quests
+            return static_cast<GameObject const*>(this)->IsDynTransport();
+        case TYPEID_CORPSE:
+            return !m_changedValues[CORPSE_FIELD_BYTES_1];
+        default:
+            return true;
+    }
+}
+
 void Object::BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const
 {
     UpdateMask updateMask;
@@ -228,18 +355,22 @@ void Object::BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player*
 
 void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, UpdateMask& updateMask, Player* target) const
 {
-    ByteBuffer buf(500);
+    ByteBuffer& buf = GetUpdateBlockBuffer();
+    BuildValuesUpdateBlock(buf, updateMask, target);
+    data.AddUpdateBlock(buf);
+}
 
-    buf << uint8(UPDATETYPE_VALUES);
-    buf << GetPackGUID();
+void Object::BuildValuesUpdateBlock(ByteBuffer& block, UpdateMask& updateMask, Player* target) const
+{
+    block << uint8(UPDATETYPE_VALUES);
+    block << GetPackGUID();
 
-    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
-    data.AddUpdateBlock(buf);
+    BuildValuesUpdate(UPDATETYPE_VALUES, &block, &updateMask, target);
 }
 
 void Object::BuildForcedValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
 {
-    ByteBuffer buf(500);
+    ByteBuffer& buf = GetUpdateBlockBuffer();
 
     buf << uint8(UPDATETYPE_VALUES);
     buf << GetPackGUID();
@@ -944,22 +1075,17 @@ uint16 Object::GetUpdateFieldFlagsForTarget(Player const* target, uint16 const*&
     return visibleFlag;
 }
 
-void Object::_LoadIntoDataField(const char* data, uint32 startOffset, uint32 count)
+bool Object::_LoadIntoDataField(const char* data, uint32 startOffset, uint32 count)
 {
     if (!data)
-        return;
-
-    Tokens tokens = StrSplit(data, " ");
+        return false;
 
-    if (tokens.size() != count)
-        return;
+    // leave the fields untouched unless the number count matches
+    if (ParseUInt32List(data, nullptr, 0) != count)
+        return false;
 
-    Tokens::const_iterator iter;
-    uint32 index;
-    for (iter = tokens.begin(), index = 0; index < count; ++iter, ++index)
-    {
-        m_uint32Values[startOffset + index] = atol((*iter).c_str());
-    }
+    ParseUInt32List(data, &m_uint32Values[startOffset], count);
+    return true;
 }
 
 void Object::MarkUpdateFieldsWithFlagForUpdate(UpdateMask& updateMask, uint16 flag) const
@@ -1237,6 +1363,10 @@ bool Object::PrintEntryError(char const* descr) const
 
 void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const
 {
+    // sessions without a client reading object updates, e.g. bots
+    if (!pl->GetSession()->IsInterestedIn(SMSG_UPDATE_OBJECT))
+        return;
+
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
     if (iter == update_players.end())
@@ -2679,6 +2809,7 @@ struct WorldObjectChangeAccumulator
 
 void WorldObject::BuildUpdateData(UpdateDataMapType& update_players)
 {
+    ValuesUpdateBlockCacheScope blockCache(this);
     WorldObjectChangeAccumulator notifier(*this, update_players);
     Cell::VisitWorldObjects(this, notifier, GetVisibilityData().GetVisibilityDistance());
 
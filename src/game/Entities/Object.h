@@ -624,7 +624,7 @@ class Object
 
         void ClearUpdateMask(bool remove);
 
-        void _LoadIntoDataField(const char* data, uint32 startOffset, uint32 count);
+        bool _LoadIntoDataField(const char* data, uint32 startOffset, uint32 count);
 
         uint16 GetValuesCount() const { return m_valuesCount; }
 
@@ -652,6 +652,8 @@ class Object
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
+        void BuildValuesUpdateBlock(ByteBuffer& block, UpdateMask& updateMask, Player* target) const;
+        bool GetValuesUpdateClassForTarget(Player const* target, uint32& updateClass) const;
         void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
 
         uint16 m_objectType;
@@ -1259,7 +1261,7 @@ class WorldObject : public Object
 
         void AddClientIAmAt(Player const* player);
         void RemoveClientIAmAt(Player const* player);
-        GuidSet& GetClientGuidsIAmAt() { return m_clientGUIDsIAmAt; }
+        GuidFlatSet& GetClientGuidsIAmAt() { return m_clientGUIDsIAmAt; }
 
         // Event handler
         EventProcessor m_events;
@@ -1321,7 +1323,7 @@ class WorldObject : public Object
         bool m_isActiveObject;
         uint64 m_debugFlags;
 
-        GuidSet m_clientGUIDsIAmAt;
+        GuidFlatSet m_clientGUIDsIAmAt;
 
         // Spell System compliance
         uint8 m_destLocCounter;
@@ -71,40 +71,206 @@ void Pet::RemoveFromWorld()
     Unit::RemoveFromWorld();
 }
 
-SpellCastResult Pet::TryLoadFromDB(Unit* owner, uint32 petentry /*= 0*/, uint32 petnumber /*= 0*/, bool current /*= false*/, PetType mandatoryPetType /*= MAX_PET_TYPE*/)
+void PetCache::LoadFromDB(QueryResult* pets, QueryResult* declinedNames, QueryResult* spells, QueryResult* cooldowns, QueryResult* auras)
 {
-    uint32 ownerid = owner->GetGUIDLow();
-
-    std::ostringstream request;
-    //                 0      1          2               3
-    request << "SELECT entry, curhealth, CreatedBySpell, PetType ";
-
-    if (petnumber)
-        // known petnumber entry
-        request << "FROM character_pet WHERE owner = '" << ownerid << "' AND id = '" << petnumber << "'";
-    else if (current)
-        // current pet (slot 0)
-        request << "FROM character_pet WHERE owner = '" << ownerid << "' AND slot = '" << uint32(PET_SAVE_AS_CURRENT) << "'";
-    else if (petentry)
-        // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
-        request << "FROM character_pet WHERE owner = '" << ownerid << "' AND entry = '" << petentry << "' AND (slot = '" << uint32(PET_SAVE_AS_CURRENT) << "' OR slot > '" << uint32(PET_SAVE_LAST_STABLE_SLOT) << "')";
-    else
-        // any current or other non-stabled pet (for hunter "call pet")
-        request << "FROM character_pet WHERE owner = '" << ownerid << "' AND (slot = '" << uint32(PET_SAVE_AS_CURRENT) << "' OR slot > '" << uint32(PET_SAVE_LAST_STABLE_SLOT) << "')";
+    m_entries.clear();
+
+    if (pets)
+    {
+        //         0   1      2      3        4      5    6           7     8     9        10         11       12            13      14        15                 16                 17              18
+        // "SELECT id, entry, owner, modelid, level, exp, Reactstate, slot, name, renamed, curhealth, curmana, curhappiness, abdata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet"
+        do
+        {
+            Field* fields = pets->Fetch();
+
+            PetCacheEntry& petData = m_entries[fields[0].GetUInt32()];
+            petData.petNumber = fields[0].GetUInt32();
+            petData.entry = fields[1].GetUInt32();
+            petData.modelId = fields[3].GetUInt32();
+            petData.level = fields[4].GetUInt32();
+            petData.exp = fields[5].GetUInt32();
+            petData.reactState = fields[6].GetUInt8();
+            petData.slot = fields[7].GetUInt32();
+            petData.name = fields[8].GetCppString();
+            petData.renamed = fields[9].GetBool();
+            petData.curHealth = fields[10].GetUInt32();
+            petData.curMana = fields[11].GetUInt32();
+            petData.curHappiness = fields[12].GetUInt32();
+            petData.actionBar = fields[13].GetCppString();
+            petData.saveTime = fields[14].GetUInt64();
+            petData.resetTalentsCost = fields[15].GetUInt32();
+            petData.resetTalentsTime = fields[16].GetUInt64();
+            petData.createdBySpell = fields[17].GetUInt32();
+            petData.petType = fields[18].GetUInt8();
+        }
+        while (pets->NextRow());
+
+        delete pets;
+    }
+
+    if (declinedNames)
+    {
+        // "SELECT id, genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname"
+        do
+        {
+            Field* fields = declinedNames->Fetch();
+            if (PetCacheEntry* petData = GetEntry(fields[0].GetUInt32()))
+            {
+                petData->hasDeclinedName = true;
+                for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+                    petData->declinedName[i] = fields[i + 1].GetCppString();
+            }
+        }
+        while (declinedNames->NextRow());
+
+        delete declinedNames;
+    }
+
+    if (spells)
+    {
+        // "SELECT guid, spell, active FROM pet_spell"
+        do
+        {
+            Field* fields = spells->Fetch();
+            if (PetCacheEntry* petData = GetEntry(fields[0].GetUInt32()))
+                petData->spells.emplace_back(fields[1].GetUInt32(), fields[2].GetUInt8());
+        }
+        while (spells->NextRow());
+
+        delete spells;
+    }
+
+    if (cooldowns)
+    {
+        // "SELECT guid, spell, time FROM pet_spell_cooldown"
+        do
+        {
+            Field* fields = cooldowns->Fetch();
+            if (PetCacheEntry* petData = GetEntry(fields[0].GetUInt32()))
+                petData->cooldowns.emplace_back(fields[1].GetUInt32(), fields[2].GetUInt64());
+        }
+        while (cooldowns->NextRow());
+
+        delete cooldowns;
+    }
+
+    if (auras)
+    {
+        //         0     1            2          3      4           5              6            7            8            9              10             11             12           13          14
+        // "SELECT guid, caster_guid, item_guid, spell, stackcount, remaincharges, basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask FROM pet_aura"
+        do
+        {
+            Field* fields = auras->Fetch();
+            PetCacheEntry* petData = GetEntry(fields[0].GetUInt32());
+            if (!petData)
+                continue;
+
+            PetCacheAura aura;
+            aura.casterGuid = fields[1].GetUInt64();
+            aura.itemLowGuid = fields[2].GetUInt32();
+            aura.spellId = fields[3].GetUInt32();
+            aura.stackCount = fields[4].GetUInt32();
+            aura.remainCharges = fields[5].GetUInt32();
+            for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+            {
+                aura.damage[i] = fields[i + 6].GetInt32();
+                aura.periodicTime[i] = fields[i + 9].GetUInt32();
+            }
+            aura.maxDuration = fields[12].GetInt32();
+            aura.remainTime = fields[13].GetInt32();
+            aura.effIndexMask = fields[14].GetUInt32();
+            petData->auras.push_back(aura);
+        }
+        while (auras->NextRow());
+
+        delete auras;
+    }
+}
+
+PetCacheEntry* PetCache::GetEntry(uint32 petNumber)
+{
+    EntryMap::iterator itr = m_entries.find(petNumber);
+    return itr != m_entries.end() ? &itr->second : nullptr;
+}
+
+PetCacheEntry* PetCache::FindEntry(uint32 petEntry, uint32 petNumber, bool current)
+{
+    // known petnumber entry
+    if (petNumber)
+        return GetEntry(petNumber);
 
-    QueryResult* result = CharacterDatabase.PQuery("%s", request.str().c_str());
+    // current pet (slot 0)
+    if (current)
+        return FindEntryBySlot(PET_SAVE_AS_CURRENT);
 
-    if (!result)
+    for (auto& itr : m_entries)
+    {
+        PetCacheEntry& petData = itr.second;
+
+        // only current or not stabled pets
+        if (petData.slot != PET_SAVE_AS_CURRENT && petData.slot <= PET_SAVE_LAST_STABLE_SLOT)
+            continue;
+
+        // known petentry entry (unique for summoned pet, but non unique for hunter pet) or any for hunter "call pet"
+        if (!petEntry || petData.entry == petEntry)
+            return &petData;
+    }
+
+    return nullptr;
+}
+
+PetCacheEntry* PetCache::FindEntryBySlot(uint32 slot)
+{
+    for (auto& itr : m_entries)
+        if (itr.second.slot == slot)
+            return &itr.second;
+
+    return nullptr;
+}
+
+PetCacheEntry* PetCache::FindEntryByCreature(uint32 entry)
+{
+    for (auto& itr : m_entries)
+        if (itr.second.entry == entry)
+            return &itr.second;
+
+    return nullptr;
+}
+
+void PetCache::ChangeSlot(uint32 fromSlot, uint32 toSlot)
+{
+    for (auto& itr : m_entries)
+        if (itr.second.slot == fromSlot)
+            itr.second.slot = toSlot;
+}
+
+void PetCache::RemoveUnstabledEntries()
+{
+    for (EntryMap::iterator itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        if (itr->second.slot == PET_SAVE_AS_CURRENT || itr->second.slot > PET_SAVE_LAST_STABLE_SLOT)
+            itr = m_entries.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+SpellCastResult Pet::TryLoadFromDB(Unit* owner, uint32 petentry /*= 0*/, uint32 petnumber /*= 0*/, bool current /*= false*/, PetType mandatoryPetType /*= MAX_PET_TYPE*/)
+{
+    // only players have saved pets
+    if (owner->GetTypeId() != TYPEID_PLAYER)
         return SPELL_FAILED_NO_PET;
 
-    Field* fields = result->Fetch();
+    Player* ownerPlayer = static_cast<Player*>(owner);
 
-    petentry = fields[0].GetUInt32();
-    uint32 savedHealth = fields[1].GetUInt32();
-    uint32 summon_spell_id = fields[2].GetUInt32();
-    PetType petType = PetType(fields[3].GetUInt8());
+    PetCacheEntry const* petData = ownerPlayer->GetPetCache().FindEntry(petentry, petnumber, current);
+    if (!petData)
+        return SPELL_FAILED_NO_PET;
 
-    delete result;
+    petentry = petData->entry;
+    uint32 savedHealth = petData->curHealth;
+    uint32 summon_spell_id = petData->createdBySpell;
+    PetType petType = PetType(petData->petType);
 
     // update for case of current pet "slot = 0"
     if (!petentry)
@@ -125,11 +291,7 @@ SpellCastResult Pet::TryLoadFromDB(Unit* owner, uint32 petentry /*= 0*/, uint32
     if (current && isTemporarySummoned)
         return SPELL_FAILED_NO_PET;
 
-    Player const* ownerPlayer = nullptr;
-    if (owner->GetTypeId() == TYPEID_PLAYER)
-        ownerPlayer = static_cast<Player const*>(owner);
-
-    if (petType == HUNTER_PET && !creatureInfo->isTameable(ownerPlayer ? ownerPlayer->CanTameExoticPets() : false))
+    if (petType == HUNTER_PET && !creatureInfo->isTameable(ownerPlayer->CanTameExoticPets()))
         return SPELL_FAILED_NO_PET;
 
     if (!savedHealth)
@@ -145,76 +307,41 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
 {
     m_loading = true;
 
-    uint32 ownerid = owner->GetGUIDLow();
-
-    QueryResult* result;
-
-    if (petnumber)
-        // known petnumber entry                  0   1      2(?)   3        4      5    6           7     8     9        10         11       12            13      14        15                 16                 17              18
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, slot, name, renamed, curhealth, curmana, curhappiness, abdata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType "
-                                          "FROM character_pet WHERE owner = '%u' AND id = '%u'",
-                                          ownerid, petnumber);
-    else if (current)
-        // current pet (slot 0)                   0   1      2(?)   3        4      5    6           7     8     9        10         11       12            13      14        15                 16                 17              18
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, slot, name, renamed, curhealth, curmana, curhappiness, abdata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType "
-                                          "FROM character_pet WHERE owner = '%u' AND slot = '%u'",
-                                          ownerid, PET_SAVE_AS_CURRENT);
-    else if (petentry)
-        // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
-        //                                        0   1      2(?)   3        4      5    6           7     8     9        10         11       12           13       14        15                 16                 17              18
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, slot, name, renamed, curhealth, curmana, curhappiness, abdata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType "
-                                          "FROM character_pet WHERE owner = '%u' AND entry = '%u' AND (slot = '%u' OR slot > '%u') ",
-                                          ownerid, petentry, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT);
-    else
-        // any current or other non-stabled pet (for hunter "call pet")
-        //                                        0   1      2(?)   3        4      5    6           7     8     9        10         11       12            13      14        15                 16                 17              18
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, slot, name, renamed, curhealth, curmana, curhappiness, abdata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType "
-                                          "FROM character_pet WHERE owner = '%u' AND (slot = '%u' OR slot > '%u') ",
-                                          ownerid, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT);
-
-    if (!result)
+    PetCacheEntry const* cachedData = owner->GetPetCache().FindEntry(petentry, petnumber, current);
+    if (!cachedData)
         return false;
 
-    Field* fields = result->Fetch();
+    // copy, the cache entry is replaced by the save at the end of the load
+    PetCacheEntry const petData = *cachedData;
 
     // update for case of current pet "slot = 0"
-    petentry = fields[1].GetUInt32();
+    petentry = petData.entry;
     if (!petentry)
-    {
-        delete result;
         return false;
-    }
 
     CreatureInfo const* creatureInfo = ObjectMgr::GetCreatureTemplate(petentry);
     if (!creatureInfo)
     {
         sLog.outError("Pet entry %u does not exist but used at pet load (owner: %s).", petentry, owner->GetGuidStr().c_str());
-        delete result;
         return false;
     }
 
-    uint32 summon_spell_id = fields[17].GetUInt32();
+    uint32 summon_spell_id = petData.createdBySpell;
     SpellEntry const* spellInfo = sSpellTemplate.LookupEntry<SpellEntry>(summon_spell_id);
 
     if (permanentOnly && spellInfo && GetSpellDuration(spellInfo) > 0)
-    {
-        delete result;
         return false;
-    }
 
-    PetType pet_type = PetType(fields[18].GetUInt8());
+    PetType pet_type = PetType(petData.petType);
     if (pet_type == HUNTER_PET)
     {
         if (!creatureInfo->isTameable(owner->CanTameExoticPets()))
-        {
-            delete result;
             return false;
-        }
     }
 
     m_petType = pet_type;
 
-    uint32 pet_number = fields[0].GetUInt32();
+    uint32 pet_number = petData.petNumber;
 
     if (!forced && owner->IsPetNeedBeTemporaryUnsummoned(nullptr))
     {
@@ -227,8 +354,8 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
         SqlStatement ChangePetSlot = CharacterDatabase.CreateStatement(ChangePetSlot_ID, "UPDATE character_pet SET slot = ? WHERE id = ? ");
         ChangePetSlot.PExecute(uint32(PET_SAVE_AS_CURRENT), pet_number);
         CharacterDatabase.CommitTransaction();
+        owner->GetPetCache().GetEntry(pet_number)->slot = PET_SAVE_AS_CURRENT;
 
-        delete result;
         return false;
     }
     owner->SetTemporaryUnsummonedPetNumber(0);
@@ -239,17 +366,13 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
 
     uint32 guid = pos.GetMap()->GenerateLocalLowGuid(HIGHGUID_PET);
     if (!Create(guid, pos, creatureInfo, pet_number))
-    {
-        delete result;
         return false;
-    }
 
     // DK Permanent ghoul spell
     if (spellInfo->HasAttribute(SPELL_ATTR_EX7_RECAST_ON_RESUMMON) && current && !forced) // must cast through spell in order to trigger correct ghoul CD
     {
         Position pos = Pet::GetPetSpawnPosition(owner);
         owner->CastSpell(pos.x, pos.y, pos.z, summon_spell_id, TRIGGERED_IGNORE_GCD | TRIGGERED_IGNORE_COOLDOWNS);
-        delete result;
         return false;
     }
 
@@ -263,27 +386,26 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
     {
         pos.GetMap()->Add((Creature*)this);
         AIM_Initialize();
-        delete result;
         return true;
     }
 
     m_charmInfo->SetPetNumber(pet_number, isControlled());
 
     SetOwnerGuid(owner->GetObjectGuid());
-    SetDisplayId(fields[3].GetUInt32());
-    SetNativeDisplayId(fields[3].GetUInt32());
-    uint32 petlevel = fields[4].GetUInt32();
+    SetDisplayId(petData.modelId);
+    SetNativeDisplayId(petData.modelId);
+    uint32 petlevel = petData.level;
     SetUInt32Value(UNIT_NPC_FLAGS, UNIT_NPC_FLAG_NONE);
-    SetName(fields[8].GetString());
+    SetName(petData.name);
 
     SetByteValue(UNIT_FIELD_BYTES_2, UNIT_BYTES_2_OFFSET_PVP_FLAG, UNIT_BYTE2_FLAG_AURAS);
     SetUInt32Value(UNIT_FIELD_FLAGS, UNIT_FLAG_PLAYER_CONTROLLED);
 
     if (getPetType() == HUNTER_PET)
     {
-        SetByteFlag(UNIT_FIELD_BYTES_2, UNIT_BYTES_2_OFFSET_PET_FLAGS, fields[9].GetBool() ? UNIT_CAN_BE_ABANDONED : UNIT_CAN_BE_RENAMED | UNIT_CAN_BE_ABANDONED);
+        SetByteFlag(UNIT_FIELD_BYTES_2, UNIT_BYTES_2_OFFSET_PET_FLAGS, petData.renamed ? UNIT_CAN_BE_ABANDONED : UNIT_CAN_BE_RENAMED | UNIT_CAN_BE_ABANDONED);
         SetMaxPower(POWER_HAPPINESS, GetCreatePowers(POWER_HAPPINESS));
-        SetPower(POWER_HAPPINESS, fields[12].GetUInt32());
+        SetPower(POWER_HAPPINESS, petData.curHappiness);
         SetPowerType(POWER_FOCUS);
     }
     else if (getPetType() != SUMMON_PET)
@@ -309,25 +431,25 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
     InitTalentForLevel();                                   // set original talents points before spell loading
 
     SetUInt32Value(UNIT_FIELD_PET_NAME_TIMESTAMP, uint32(time(nullptr)));
-    SetUInt32Value(UNIT_FIELD_PETEXPERIENCE, fields[5].GetUInt32());
+    SetUInt32Value(UNIT_FIELD_PETEXPERIENCE, petData.exp);
 
-    ReactStates reactState = ReactStates(fields[6].GetUInt8());
+    ReactStates reactState = ReactStates(petData.reactState);
 
-    uint32 savedhealth = fields[10].GetUInt32();
-    uint32 savedpower = fields[11].GetUInt32();
+    uint32 savedhealth = petData.curHealth;
+    uint32 savedpower = petData.curMana;
     Powers powerType = GetPowerType();
 
     // load action bar, if data broken will fill later by default spells.
-    m_charmInfo->LoadPetActionBar(fields[13].GetCppString());
+    m_charmInfo->LoadPetActionBar(petData.actionBar);
 
     // since last save (in seconds)
-    uint32 timediff = uint32(time(nullptr) - fields[14].GetUInt64());
+    uint32 timediff = uint32(time(nullptr) - petData.saveTime);
 
-    m_resetTalentsCost = fields[15].GetUInt32();
-    m_resetTalentsTime = fields[16].GetUInt64();
+    m_resetTalentsCost = petData.resetTalentsCost;
+    m_resetTalentsTime = petData.resetTalentsTime;
 
     // load spells/cooldowns/auras
-    _LoadAuras(timediff);
+    _LoadAuras(petData, timediff);
 
     // remove arena auras if in arena - but only DB loaded ones
     if (map->IsBattleArena())
@@ -339,7 +461,7 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
     CastOwnerTalentAuras();
 
     // Those two following call was moved here to fix health is not full after pet invocation (before, they where placed after map->Add())
-    _LoadSpells();
+    _LoadSpells(petData);
     InitLevelupSpellsForLevel();
     // TODO: confirm two line above work in all situation
     InitPetScalingAuras();
@@ -371,7 +493,7 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
 
     CleanupActionBar();                                     // remove unknown spells from action bar after load
 
-    _LoadSpellCooldowns();
+    _LoadSpellCooldowns(petData);
 
     owner->SetPet(this);                                    // in DB stored only full controlled creature
     DEBUG_LOG("New Pet has guid %u", GetGUIDLow());
@@ -383,21 +505,13 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
 
     owner->SendTalentsInfoData(true);
 
-    if (getPetType() == HUNTER_PET)
+    if (getPetType() == HUNTER_PET && petData.hasDeclinedName)
     {
-        result = CharacterDatabase.PQuery("SELECT genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = '%u' AND id = '%u'", owner->GetGUIDLow(), GetCharmInfo()->GetPetNumber());
+        delete m_declinedname;
+        m_declinedname = new DeclinedName;
 
-        if (result)
-        {
-            delete m_declinedname;
-            m_declinedname = new DeclinedName;
-
-            Field* fields2 = result->Fetch();
-            for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
-                m_declinedname->name[i] = fields2[i].GetCppString();
-
-            delete result;
-        }
+        for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+            m_declinedname->name[i] = petData.declinedName[i];
     }
 
     m_loading = false;
@@ -457,11 +571,18 @@ void Pet::SavePetToDB(PetSaveMode mode, Player* owner)
                 RemoveAllAuras();
         }
 
+        PetCache& petCache = owner->GetPetCache();
+
+        // cooldowns and auras of controllable guardians are not saved, keep the cached ones
+        PetCacheEntry petData;
+        if (PetCacheEntry* cachedData = petCache.GetEntry(m_charmInfo->GetPetNumber()))
+            petData = std::move(*cachedData);
+
         // save pet's data as one single transaction
         CharacterDatabase.BeginTransaction();
-        _SaveSpells();
-        _SaveSpellCooldowns();
-        _SaveAuras();
+        _SaveSpells(petData);
+        _SaveSpellCooldowns(petData);
+        _SaveAuras(petData);
 
         uint32 ownerLow = GetOwnerGuid().GetCounter();
         // remove current data
@@ -470,6 +591,7 @@ void Pet::SavePetToDB(PetSaveMode mode, Player* owner)
 
         SqlStatement stmt = CharacterDatabase.CreateStatement(delPet, "DELETE FROM character_pet WHERE owner = ? AND id = ?");
         stmt.PExecute(ownerLow, m_charmInfo->GetPetNumber());
+        petCache.RemoveEntry(m_charmInfo->GetPetNumber());
 
         // prevent duplicate using slot (except PET_SAVE_NOT_IN_SLOT)
         if (mode <= PET_SAVE_LAST_STABLE_SLOT)
@@ -478,6 +600,7 @@ void Pet::SavePetToDB(PetSaveMode mode, Player* owner)
 
             stmt = CharacterDatabase.CreateStatement(updPet, "UPDATE character_pet SET slot = ? WHERE owner = ? AND slot = ?");
             stmt.PExecute(uint32(PET_SAVE_NOT_IN_SLOT), ownerLow, uint32(mode));
+            petCache.ChangeSlot(uint32(mode), uint32(PET_SAVE_NOT_IN_SLOT));
         }
 
         // prevent existence another hunter pet in PET_SAVE_AS_CURRENT and PET_SAVE_NOT_IN_SLOT
@@ -487,6 +610,7 @@ void Pet::SavePetToDB(PetSaveMode mode, Player* owner)
 
             stmt = CharacterDatabase.CreateStatement(del, "DELETE FROM character_pet WHERE owner = ? AND (slot = ? OR slot > ?)");
             stmt.PExecute(ownerLow, uint32(PET_SAVE_AS_CURRENT), uint32(PET_SAVE_LAST_STABLE_SLOT));
+            petCache.RemoveUnstabledEntries();
         }
 
         // save pet
@@ -524,11 +648,32 @@ void Pet::SavePetToDB(PetSaveMode mode, Player* owner)
 
         savePet.Execute();
         CharacterDatabase.CommitTransaction();
+
+        petData.petNumber = m_charmInfo->GetPetNumber();
+        petData.entry = GetEntry();
+        petData.modelId = GetNativeDisplayId();
+        petData.level = GetLevel();
+        petData.exp = GetUInt32Value(UNIT_FIELD_PETEXPERIENCE);
+        petData.reactState = uint8(AI()->GetReactState());
+        petData.slot = uint32(mode);
+        petData.name = m_name;
+        petData.renamed = !HasByteFlag(UNIT_FIELD_BYTES_2, 2, UNIT_CAN_BE_RENAMED);
+        petData.curHealth = curhealth;
+        petData.curMana = curpower;
+        petData.curHappiness = GetPower(POWER_HAPPINESS);
+        petData.actionBar = ss.str();
+        petData.saveTime = uint64(time(nullptr));
+        petData.resetTalentsCost = m_resetTalentsCost;
+        petData.resetTalentsTime = uint64(m_resetTalentsTime);
+        petData.createdBySpell = GetUInt32Value(UNIT_CREATED_BY_SPELL);
+        petData.petType = uint8(getPetType());
+        petCache.SetEntry(std::move(petData));
     }
     else
     {
         RemoveAllAuras(AURA_REMOVE_BY_DELETE);
         DeleteFromDB(m_charmInfo->GetPetNumber());
+        owner->GetPetCache().RemoveEntry(m_charmInfo->GetPetNumber());
     }
 }
 
@@ -571,16 +716,17 @@ void Pet::DeleteFromDB(uint32 guidlow, bool separate_transaction)
 
 void Pet::DeleteFromDB(Unit* owner, PetSaveMode slot)
 {
-    QueryResult* result = CharacterDatabase.PQuery("SELECT id FROM character_pet WHERE owner = '%u'  AND slot = '%u' ", owner->GetGUIDLow(), uint32(slot));
-    if (result)
-    {
-        Field* fields = result->Fetch();
-        uint32 petNumber = fields[0].GetUInt32();
+    if (owner->GetTypeId() != TYPEID_PLAYER)
+        return;
 
+    PetCache& petCache = static_cast<Player*>(owner)->GetPetCache();
+    if (PetCacheEntry const* petData = petCache.FindEntryBySlot(uint32(slot)))
+    {
+        uint32 petNumber = petData->petNumber;
         if (petNumber)
             DeleteFromDB(petNumber);
 
-        delete result;
+        petCache.RemoveEntry(petNumber);
     }
 }
 
@@ -1320,21 +1466,18 @@ uint32 Pet::GetCurrentFoodBenefitLevel(uint32 itemlevel) const
     // food too low level
 }
 
-void Pet::_LoadSpellCooldowns()
+void Pet::_LoadSpellCooldowns(PetCacheEntry const& petData)
 {
-    QueryResult* result = CharacterDatabase.PQuery("SELECT spell,time FROM pet_spell_cooldown WHERE guid = '%u'", m_charmInfo->GetPetNumber());
     ByteBuffer cdData;
     uint32 cdCount = 0;
 
-    if (result)
+    if (!petData.cooldowns.empty())
     {
         auto curTime = GetMap()->GetCurrentClockTime();
-        do
+        for (auto const& cooldown : petData.cooldowns)
         {
-            Field* fields = result->Fetch();
-
-            uint32 spell_id   = fields[0].GetUInt32();
-            uint64 spell_time = fields[1].GetUInt64();
+            uint32 spell_id   = cooldown.first;
+            uint64 spell_time = cooldown.second;
 
             SpellEntry const* spellEntry = sSpellTemplate.LookupEntry<SpellEntry>(spell_id);
             if (!spellEntry)
@@ -1362,9 +1505,6 @@ void Pet::_LoadSpellCooldowns()
             sLog.outDebug("Adding spell cooldown to %s, SpellID(%u), recDuration(%us).", GetGuidStr().c_str(), spell_id, spellCDDuration);
 #endif
         }
-        while (result->NextRow());
-
-        delete result;
 
         if (cdCount && GetOwner() && GetOwner()->GetTypeId() == TYPEID_PLAYER)
         {
@@ -1377,7 +1517,7 @@ void Pet::_LoadSpellCooldowns()
     }
 }
 
-void Pet::_SaveSpellCooldowns()
+void Pet::_SaveSpellCooldowns(PetCacheEntry& petData)
 {
     // controllable guardians only save spells and main entry
     if (m_controllableGuardian)
@@ -1388,6 +1528,7 @@ void Pet::_SaveSpellCooldowns()
 
     SqlStatement stmt = CharacterDatabase.CreateStatement(delSpellCD, "DELETE FROM pet_spell_cooldown WHERE guid = ?");
     stmt.PExecute(m_charmInfo->GetPetNumber());
+    petData.cooldowns.clear();
 
     TimePoint currTime = GetMap()->GetCurrentClockTime();
 
@@ -1402,31 +1543,20 @@ void Pet::_SaveSpellCooldowns()
 
             stmt = CharacterDatabase.CreateStatement(insSpellCD, "INSERT INTO pet_spell_cooldown (guid,spell,time) VALUES (?, ?, ?)");
             stmt.PExecute(m_charmInfo->GetPetNumber(), cdItr.first, spellExpireTime);
+            petData.cooldowns.emplace_back(cdItr.first, spellExpireTime);
         }
     }
 }
 
-bool Pet::_LoadSpells()
+bool Pet::_LoadSpells(PetCacheEntry const& petData)
 {
-    std::unique_ptr<QueryResult> result(CharacterDatabase.PQuery("SELECT spell,active FROM pet_spell WHERE guid = '%u'", m_charmInfo->GetPetNumber()));
-
-    if (result)
-    {
-        do
-        {
-            Field* fields = result->Fetch();
-
-            addSpell(fields[0].GetUInt32(), ActiveStates(fields[1].GetUInt8()), PETSPELL_UNCHANGED);
-        }
-        while (result->NextRow());
+    for (auto const& spell : petData.spells)
+        addSpell(spell.first, ActiveStates(spell.second), PETSPELL_UNCHANGED);
 
-        return true;
-    }
-
-    return false;
+    return !petData.spells.empty();
 }
 
-void Pet::_SaveSpells()
+void Pet::_SaveSpells(PetCacheEntry& petData)
 {
     static SqlStatementID delSpell ;
     static SqlStatementID insSpell ;
@@ -1469,121 +1599,115 @@ void Pet::_SaveSpells()
 
         itr->second.state = PETSPELL_UNCHANGED;
     }
+
+    petData.spells.clear();
+    for (auto const& spell : m_spells)
+        if (spell.second.type != PETSPELL_FAMILY)
+            petData.spells.emplace_back(spell.first, spell.second.active);
 }
 
-bool Pet::_LoadGuardianPetNumber()
+PetCacheEntry const* Pet::_LoadGuardianPetNumber()
 {
-    std::unique_ptr<QueryResult> result(CharacterDatabase.PQuery("SELECT id FROM character_pet WHERE entry='%u' AND owner = '%u'", GetEntry(), GetOwnerGuid().GetCounter()));
-
-    if (result)
-    {
-        Field* fields = result->Fetch();
-		m_charmInfo->SetPetNumber(fields[0].GetUInt32(), false);
+    Unit* owner = GetOwner();
+    if (!owner || owner->GetTypeId() != TYPEID_PLAYER)
+        return nullptr;
 
-        return true;
-    }
+    PetCacheEntry const* petData = static_cast<Player*>(owner)->GetPetCache().FindEntryByCreature(GetEntry());
+    if (petData)
+        m_charmInfo->SetPetNumber(petData->petNumber, false);
 
-    return false;
+    return petData;
 }
 
-void Pet::_LoadAuras(uint32 timediff)
+void Pet::_LoadAuras(PetCacheEntry const& petData, uint32 timediff)
 {
-    QueryResult* result = CharacterDatabase.PQuery("SELECT caster_guid,item_guid,spell,stackcount,remaincharges,basepoints0,basepoints1,basepoints2,periodictime0,periodictime1,periodictime2,maxduration,remaintime,effIndexMask FROM pet_aura WHERE guid = '%u'", m_charmInfo->GetPetNumber());
-
-    if (result)
+    for (PetCacheAura const& savedAura : petData.auras)
     {
-        do
+        ObjectGuid casterGuid = ObjectGuid(savedAura.casterGuid);
+        uint32 item_lowguid = savedAura.itemLowGuid;
+        uint32 spellid = savedAura.spellId;
+        uint32 stackcount = savedAura.stackCount;
+        uint32 remaincharges = savedAura.remainCharges;
+        int32  damage[MAX_EFFECT_INDEX];
+        uint32 periodicTime[MAX_EFFECT_INDEX];
+
+        for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         {
-            Field* fields = result->Fetch();
-            ObjectGuid casterGuid = ObjectGuid(fields[0].GetUInt64());
-            uint32 item_lowguid = fields[1].GetUInt32();
-            uint32 spellid = fields[2].GetUInt32();
-            uint32 stackcount = fields[3].GetUInt32();
-            uint32 remaincharges = fields[4].GetUInt32();
-            int32  damage[MAX_EFFECT_INDEX];
-            uint32 periodicTime[MAX_EFFECT_INDEX];
+            damage[i] = savedAura.damage[i];
+            periodicTime[i] = savedAura.periodicTime[i];
+        }
 
-            for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            {
-                damage[i] = fields[i + 5].GetInt32();
-                periodicTime[i] = fields[i + 8].GetUInt32();
-            }
+        int32 maxduration = savedAura.maxDuration;
+        int32 remaintime = savedAura.remainTime;
+        uint32 effIndexMask = savedAura.effIndexMask;
 
-            int32 maxduration = fields[11].GetInt32();
-            int32 remaintime = fields[12].GetInt32();
-            uint32 effIndexMask = fields[13].GetUInt32();
+        SpellEntry const* spellproto = sSpellTemplate.LookupEntry<SpellEntry>(spellid);
+        if (!spellproto)
+        {
+            sLog.outError("Unknown spell (spellid %u), ignore.", spellid);
+            continue;
+        }
 
-            SpellEntry const* spellproto = sSpellTemplate.LookupEntry<SpellEntry>(spellid);
-            if (!spellproto)
-            {
-                sLog.outError("Unknown spell (spellid %u), ignore.", spellid);
-                continue;
-            }
+        // do not load single target auras (unless they were cast by the player)
+        if (casterGuid != GetObjectGuid() && sSpellMgr.IsSingleTargetSpell(spellproto))
+            continue;
 
-            // do not load single target auras (unless they were cast by the player)
-            if (casterGuid != GetObjectGuid() && sSpellMgr.IsSingleTargetSpell(spellproto))
+        if (remaintime != -1)
+        {
+            if (remaintime / IN_MILLISECONDS <= int32(timediff))
                 continue;
 
-            if (remaintime != -1)
-            {
-                if (remaintime / IN_MILLISECONDS <= int32(timediff))
-                    continue;
-
-                remaintime -= timediff * IN_MILLISECONDS;
-            }
-
-            // prevent wrong values of remaincharges
-            if (spellproto->procCharges == 0)
-                remaincharges = 0;
+            remaintime -= timediff * IN_MILLISECONDS;
+        }
 
-            if (!spellproto->StackAmount)
-                stackcount = 1;
-            else if (spellproto->StackAmount < stackcount)
-                stackcount = spellproto->StackAmount;
-            else if (!stackcount)
-                stackcount = 1;
+        // prevent wrong values of remaincharges
+        if (spellproto->procCharges == 0)
+            remaincharges = 0;
 
-            SpellAuraHolder* holder = CreateSpellAuraHolder(spellproto, this, nullptr);
-            holder->SetLoadedState(casterGuid, ObjectGuid(HIGHGUID_ITEM, item_lowguid), stackcount, remaincharges, maxduration, remaintime);
+        if (!spellproto->StackAmount)
+            stackcount = 1;
+        else if (spellproto->StackAmount < stackcount)
+            stackcount = spellproto->StackAmount;
+        else if (!stackcount)
+            stackcount = 1;
 
-            for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            {
-                if ((effIndexMask & (1 << i)) == 0)
-                    continue;
+        SpellAuraHolder* holder = CreateSpellAuraHolder(spellproto, this, nullptr);
+        holder->SetLoadedState(casterGuid, ObjectGuid(HIGHGUID_ITEM, item_lowguid), stackcount, remaincharges, maxduration, remaintime);
 
-                Aura* aura = CreateAura(spellproto, SpellEffectIndex(i), nullptr, nullptr, holder, this);
-                if (!damage[i])
-                    damage[i] = aura->GetModifier()->m_amount;
+        for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            if ((effIndexMask & (1 << i)) == 0)
+                continue;
 
-                aura->SetLoadedState(damage[i], periodicTime[i]);
-                holder->AddAura(aura, SpellEffectIndex(i));
-            }
+            Aura* aura = CreateAura(spellproto, SpellEffectIndex(i), nullptr, nullptr, holder, this);
+            if (!damage[i])
+                damage[i] = aura->GetModifier()->m_amount;
 
-            const bool empty = holder->IsEmptyHolder();
-            if (!empty)
-            {
-                // reset stolen single target auras
-                if (casterGuid != GetObjectGuid() && holder->GetTrackedAuraType() == TRACK_AURA_TYPE_SINGLE_TARGET)
-                    holder->SetTrackedAuraType(TRACK_AURA_TYPE_NOT_TRACKED);
+            aura->SetLoadedState(damage[i], periodicTime[i]);
+            holder->AddAura(aura, SpellEffectIndex(i));
+        }
 
-                holder->SetState(SPELLAURAHOLDER_STATE_DB_LOAD); // Safeguard mechanism against some actions
-            }
+        const bool empty = holder->IsEmptyHolder();
+        if (!empty)
+        {
+            // reset stolen single target auras
+            if (casterGuid != GetObjectGuid() && holder->GetTrackedAuraType() == TRACK_AURA_TYPE_SINGLE_TARGET)
+                holder->SetTrackedAuraType(TRACK_AURA_TYPE_NOT_TRACKED);
 
-            if (!empty && AddSpellAuraHolder(holder))
-            {
-                holder->SetState(SPELLAURAHOLDER_STATE_READY);
-                DETAIL_LOG("Added pet auras from spellid %u", spellproto->Id);
-            }
-            else
-                delete holder;
+            holder->SetState(SPELLAURAHOLDER_STATE_DB_LOAD); // Safeguard mechanism against some actions
         }
-        while (result->NextRow());
 
-        delete result;
+        if (!empty && AddSpellAuraHolder(holder))
+        {
+            holder->SetState(SPELLAURAHOLDER_STATE_READY);
+            DETAIL_LOG("Added pet auras from spellid %u", spellproto->Id);
+        }
+        else
+            delete holder;
     }
 }
 
-void Pet::_SaveAuras()
+void Pet::_SaveAuras(PetCacheEntry& petData)
 {
     // controllable guardians only save spells and main entry
     if (m_controllableGuardian)
@@ -1594,6 +1718,7 @@ void Pet::_SaveAuras()
 
     SqlStatement stmt = CharacterDatabase.CreateStatement(delAuras, "DELETE FROM pet_aura WHERE guid = ?");
     stmt.PExecute(m_charmInfo->GetPetNumber());
+    petData.auras.clear();
 
     SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
 
@@ -1666,6 +1791,22 @@ void Pet::_SaveAuras()
             stmt.addInt32(holder->GetAuraDuration());
             stmt.addUInt32(effIndexMask);
             stmt.Execute();
+
+            PetCacheAura savedAura;
+            savedAura.casterGuid = holder->GetCasterGuid().GetRawValue();
+            savedAura.itemLowGuid = holder->GetCastItemGuid().GetCounter();
+            savedAura.spellId = holder->GetId();
+            savedAura.stackCount = holder->GetStackAmount();
+            savedAura.remainCharges = holder->GetAuraCharges();
+            for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+            {
+                savedAura.damage[i] = damage[i];
+                savedAura.periodicTime[i] = periodicTime[i];
+            }
+            savedAura.maxDuration = holder->GetAuraMaxDuration();
+            savedAura.remainTime = holder->GetAuraDuration();
+            savedAura.effIndexMask = effIndexMask;
+            petData.auras.push_back(savedAura);
         }
     }
 }
@@ -2026,71 +2167,43 @@ void Pet::resetTalentsForAllPetsOf(Player* owner, Pet* online_pet /*= nullptr*/)
     // now need only reset for offline pets (all pets except online case)
     uint32 except_petnumber = online_pet ? online_pet->GetCharmInfo()->GetPetNumber() : 0;
 
-    QueryResult* resultPets = CharacterDatabase.PQuery(
-                                  "SELECT id FROM character_pet WHERE owner = '%u' AND id <> '%u'",
-                                  owner->GetGUIDLow(), except_petnumber);
+    std::set<uint32> petNumbers;
+    std::set<uint32> talentSpells;
 
-    // no offline pets
-    if (!resultPets)
-        return;
+    for (auto& itr : owner->GetPetCache().GetEntries())
+    {
+        PetCacheEntry& petData = itr.second;
+        if (petData.petNumber == except_petnumber)
+            continue;
 
-    QueryResult* result = CharacterDatabase.PQuery(
-                              "SELECT DISTINCT pet_spell.spell FROM pet_spell, character_pet "
-                              "WHERE character_pet.owner = '%u' AND character_pet.id = pet_spell.guid AND character_pet.id <> %u",
-                              owner->GetGUIDLow(), except_petnumber);
+        petNumbers.insert(petData.petNumber);
 
-    if (!result)
-    {
-        delete resultPets;
-        return;
+        for (auto spellItr = petData.spells.begin(); spellItr != petData.spells.end();)
+        {
+            if (GetTalentSpellCost(spellItr->first))
+            {
+                talentSpells.insert(spellItr->first);
+                spellItr = petData.spells.erase(spellItr);
+            }
+            else
+                ++spellItr;
+        }
     }
 
-    bool need_comma = false;
+    // no offline pets or no talents learned by them
+    if (talentSpells.empty())
+        return;
+
     std::ostringstream ss;
     ss << "DELETE FROM pet_spell WHERE guid IN (";
 
-    do
-    {
-        Field* fields = resultPets->Fetch();
-
-        uint32 id = fields[0].GetUInt32();
-
-        if (need_comma)
-            ss << ",";
-
-        ss << id;
-
-        need_comma = true;
-    }
-    while (resultPets->NextRow());
-
-    delete resultPets;
+    for (std::set<uint32>::const_iterator itr = petNumbers.begin(); itr != petNumbers.end(); ++itr)
+        ss << (itr != petNumbers.begin() ? "," : "") << *itr;
 
     ss << ") AND spell IN (";
 
-    bool need_execute = false;
-    do
-    {
-        Field* fields = result->Fetch();
-
-        uint32 spell = fields[0].GetUInt32();
-
-        if (!GetTalentSpellCost(spell))
-            continue;
-
-        if (need_execute)
-            ss << ",";
-
-        ss << spell;
-
-        need_execute = true;
-    }
-    while (result->NextRow());
-
-    delete result;
-
-    if (!need_execute)
-        return;
+    for (std::set<uint32>::const_iterator itr = talentSpells.begin(); itr != talentSpells.end(); ++itr)
+        ss << (itr != talentSpells.begin() ? "," : "") << *itr;
 
     ss << ")";
 
@@ -2478,7 +2591,8 @@ void Pet::InitializeSpellsForControllableGuardian(bool load)
     for (auto& spellData : spellList.Spells)
         addSpell(spellData.second.SpellId, ACT_DECIDE, PETSPELL_NEW);
 
-    if (load && _LoadGuardianPetNumber() && _LoadSpells())
+    PetCacheEntry const* petData = load ? _LoadGuardianPetNumber() : nullptr;
+    if (petData && _LoadSpells(*petData))
     {
         // update autocast in bar
         for (uint32 i = ACTION_BAR_INDEX_PET_SPELL_START; i < ACTION_BAR_INDEX_PET_SPELL_END; ++i)
@@ -135,6 +135,84 @@ typedef std::vector<uint32> AutoSpellList;
 #define ACTIVE_SPELLS_MAX           4
 
 class Player;
+class QueryResult;
+
+// pet_aura row
+struct PetCacheAura
+{
+    uint64 casterGuid;
+    uint32 itemLowGuid;
+    uint32 spellId;
+    uint32 stackCount;
+    uint32 remainCharges;
+    int32  damage[MAX_EFFECT_INDEX];
+    uint32 periodicTime[MAX_EFFECT_INDEX];
+    int32  maxDuration;
+    int32  remainTime;
+    uint32 effIndexMask;
+};
+
+// character_pet row together with its declined names, spells, cooldowns and auras
+struct PetCacheEntry
+{
+    PetCacheEntry() : petNumber(0), entry(0), modelId(0), level(0), exp(0), reactState(0), slot(PET_SAVE_NOT_IN_SLOT), renamed(false),
+        curHealth(0), curMana(0), curHappiness(0), saveTime(0), resetTalentsCost(0), resetTalentsTime(0), createdBySpell(0), petType(0),
+        hasDeclinedName(false) {}
+
+    uint32 petNumber;
+    uint32 entry;
+    uint32 modelId;
+    uint32 level;
+    uint32 exp;
+    uint8 reactState;
+    uint32 slot;
+    std::string name;
+    bool renamed;
+    uint32 curHealth;
+    uint32 curMana;
+    uint32 curHappiness;
+    std::string actionBar;
+    uint64 saveTime;
+    uint32 resetTalentsCost;
+    uint64 resetTalentsTime;
+    uint32 createdBySpell;
+    uint8 petType;
+
+    bool hasDeclinedName;
+    std::string declinedName[MAX_DECLINED_NAME_CASES];
+
+    std::vector<std::pair<uint32, uint8>> spells;           // spell, active
+    std::vector<std::pair<uint32, uint64>> cooldowns;       // spell, expire time
+    std::vector<PetCacheAura> auras;
+};
+
+// saved pets of a player, loaded with the character and updated on every pet save
+// so summoning, stabling and calling pets does not have to query the character DB
+class PetCache
+{
+    public:
+        typedef std::map<uint32, PetCacheEntry> EntryMap;   // ordered by pet number like character_pet
+
+        void LoadFromDB(QueryResult* pets, QueryResult* declinedNames, QueryResult* spells, QueryResult* cooldowns, QueryResult* auras);
+
+        EntryMap& GetEntries() { return m_entries; }
+        EntryMap const& GetEntries() const { return m_entries; }
+        PetCacheEntry* GetEntry(uint32 petNumber);
+        // same selection as the character_pet lookup in Pet::LoadPetFromDB
+        PetCacheEntry* FindEntry(uint32 petEntry, uint32 petNumber, bool current);
+        PetCacheEntry* FindEntryBySlot(uint32 slot);
+        PetCacheEntry* FindEntryByCreature(uint32 entry);
+
+        void SetEntry(PetCacheEntry&& petData) { m_entries[petData.petNumber] = std::move(petData); }
+        void RemoveEntry(uint32 petNumber) { m_entries.erase(petNumber); }
+        // same as UPDATE character_pet SET slot = toSlot WHERE slot = fromSlot
+        void ChangeSlot(uint32 fromSlot, uint32 toSlot);
+        // same as DELETE FROM character_pet WHERE slot = PET_SAVE_AS_CURRENT OR slot > PET_SAVE_LAST_STABLE_SLOT
+        void RemoveUnstabledEntries();
+
+    private:
+        EntryMap m_entries;
+};
 
 class Pet : public Creature
 {
@@ -225,13 +303,13 @@ class Pet : public Creature
         void CastOwnerTalentAuras();
         void CastPetAura(PetAura const* aura);
 
-        void _LoadSpellCooldowns();
-        void _SaveSpellCooldowns();
-        void _LoadAuras(uint32 timediff);
-        void _SaveAuras();
-        bool _LoadSpells();
-        void _SaveSpells();
-        bool _LoadGuardianPetNumber();
+        void _LoadSpellCooldowns(PetCacheEntry const& petData);
+        void _SaveSpellCooldowns(PetCacheEntry& petData);
+        void _LoadAuras(PetCacheEntry const& petData, uint32 timediff);
+        void _SaveAuras(PetCacheEntry& petData);
+        bool _LoadSpells(PetCacheEntry const& petData);
+        void _SaveSpells(PetCacheEntry& petData);
+        PetCacheEntry const* _LoadGuardianPetNumber();
 
         bool addSpell(uint32 spell_id, ActiveStates active = ACT_DECIDE, PetSpellState state = PETSPELL_NEW, PetSpellType type = PETSPELL_NORMAL);
         bool learnSpell(uint32 spell_id);
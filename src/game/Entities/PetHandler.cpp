@@ -654,6 +654,18 @@ void WorldSession::HandlePetRename(WorldPacket& recv_data)
         }
     }
 
+    if (PetCacheEntry* petData = _player->GetPetCache().GetEntry(pet->GetCharmInfo()->GetPetNumber()))
+    {
+        petData->name = name;
+        petData->renamed = true;
+        if (isdeclined)
+        {
+            petData->hasDeclinedName = true;
+            for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+                petData->declinedName[i] = declinedname.name[i];
+        }
+    }
+
     CharacterDatabase.BeginTransaction();
     if (isdeclined)
     {
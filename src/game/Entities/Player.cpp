@@ -58,6 +58,7 @@
 #include "Spells/Spell.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "Social/SocialMgr.h"
+#include "Social/WhoListIndex.h"
 #include "Achievements/AchievementMgr.h"
 #include "Mails/Mail.h"
 #include "Spells/SpellAuras.h"
@@ -333,16 +334,11 @@ void PlayerTaxi::InitTaxiNodesForLevel(uint32 race, uint32 chrClass, uint32 /*le
 
 void PlayerTaxi::LoadTaxiMask(const char* data)
 {
-    Tokens tokens = StrSplit(data, " ");
+    uint32 count = std::min(ParseUInt32List(data, m_taximask, TaxiMaskSize), uint32(TaxiMaskSize));
 
-    int index;
-    Tokens::iterator iter;
-    for (iter = tokens.begin(), index = 0;
-            (index < TaxiMaskSize) && (iter != tokens.end()); ++iter, ++index)
-    {
-        // load and set bits only for existing taxi nodes
-        m_taximask[index] = sTaxiNodesMask[index] & uint32(std::stoul(*iter));
-    }
+    // load and set bits only for existing taxi nodes
+    for (uint32 index = 0; index < count; ++index)
+        m_taximask[index] &= sTaxiNodesMask[index];
 }
 
 void PlayerTaxi::AppendTaximaskTo(ByteBuffer& data, bool all)
@@ -359,11 +355,9 @@ void PlayerTaxi::AppendTaximaskTo(ByteBuffer& data, bool all)
     }
 }
 
-std::ostringstream& operator<<(std::ostringstream& ss, PlayerTaxi const& taxi)
+void PlayerTaxi::AppendTaximaskTo(std::string& data, bool binary) const
 {
-    for (unsigned int i : taxi.m_taximask)
-        ss << i << " ";
-    return ss;
+    AppendUInt32List(data, m_taximask, TaxiMaskSize, binary);
 }
 
 uint64 SpellModifier::modCounter = 0;
@@ -1866,11 +1860,13 @@ bool Player::BuildEnumData(QueryResult* result, WorldPacket& p_data)
         p_data << uint32(petFamily);
     }
 
-    Tokens data = StrSplit(fields[19].GetCppString(), " ");
+    // item id and enchantments per slot, missing ones stay 0
+    uint32 equipment[INVENTORY_SLOT_BAG_END * 2] = {};
+    ParseUInt32List(fields[19].GetString(), equipment, INVENTORY_SLOT_BAG_END * 2);
     for (uint8 slot = 0; slot < INVENTORY_SLOT_BAG_END; ++slot)
     {
         uint32 visualbase = slot * 2;
-        uint32 item_id = GetUInt32ValueFromArray(data, visualbase);
+        uint32 item_id = equipment[visualbase];
         const ItemPrototype* proto = ObjectMgr::GetItemPrototype(item_id);
         if (!proto)
         {
@@ -1882,7 +1878,7 @@ bool Player::BuildEnumData(QueryResult* result, WorldPacket& p_data)
 
         SpellItemEnchantmentEntry const* enchant = nullptr;
 
-        uint32 enchants = GetUInt32ValueFromArray(data, visualbase + 1);
+        uint32 enchants = equipment[visualbase + 1];
         for (uint8 enchantSlot = PERM_ENCHANTMENT_SLOT; enchantSlot <= TEMP_ENCHANTMENT_SLOT; ++enchantSlot)
         {
             // values stored in 2 uint16
@@ -7345,6 +7341,12 @@ void Player::ModifyArenaPoints(int32 value)
     SetArenaPoints(newValue);
 }
 
+void Player::SetInGuild(uint32 GuildId)
+{
+    SetUInt32Value(PLAYER_GUILDID, GuildId);
+    sWhoListIndex.UpdateGuild(this, GuildId);
+}
+
 uint32 Player::GetGuildIdFromDB(ObjectGuid guid)
 {
     uint32 lowguid = guid.GetCounter();
@@ -7497,6 +7499,8 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea, bool force)
     bool updateZone = m_zoneUpdateId != newZone || force;
     if (updateZone)
     {
+        sWhoListIndex.UpdateZone(this, newZone);
+
         // handle outdoor pvp zones
         sOutdoorPvPMgr.HandlePlayerLeaveZone(this, m_zoneUpdateId);
         sWorldState.HandlePlayerLeaveZone(this, m_zoneUpdateId);
@@ -16182,21 +16186,9 @@ bool Player::LoadPositionFromDB(ObjectGuid guid, uint32& mapid, float& x, float&
 
 void Player::_LoadIntoDataField(const char* data, uint32 startOffset, uint32 count)
 {
-    if (!data)
+    if (!Object::_LoadIntoDataField(data, startOffset, count))
         return;
 
-    Tokens tokens = StrSplit(data, " ");
-
-    if (tokens.size() != count)
-        return;
-
-    Tokens::iterator iter;
-    uint32 index;
-    for (iter = tokens.begin(), index = 0; index < count; ++iter, ++index)
-    {
-        m_uint32Values[startOffset + index] = std::stoul(*iter);
-    }
-
     // repair titles
     uint32 foundTitle = 0;
     for (uint32 i = 1; i <= 28; ++i)
@@ -16883,6 +16875,10 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
 
     _LoadDeclinedNames(holder->GetResult(PLAYER_LOGIN_QUERY_LOADDECLINEDNAMES));
 
+    m_petCache.LoadFromDB(holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETS), holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETDECLINEDNAMES),
+                          holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETSPELLS), holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETSPELLCOOLDOWNS),
+                          holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETAURAS));
+
     m_achievementMgr.CheckAllAchievementCriteria();
 
     _LoadEquipmentSets(holder->GetResult(PLAYER_LOGIN_QUERY_LOADEQUIPMENTSETS));
@@ -18216,9 +18212,12 @@ void Player::SaveToDB()
         uberInsert.addFloat(finiteAlways(GetTeleportDest().orientation));
     }
 
-    std::ostringstream ss;
-    ss << m_taxi;                                   // string with TaxiMaskSize numbers
-    uberInsert.addString(ss);
+    // number list columns are built in one reused buffer
+    bool const binary = sWorld.getConfig(CONFIG_BOOL_SAVE_BINARY_NUMBER_LISTS);
+    std::string blob;
+    m_taxi.AppendTaximaskTo(blob, binary);
+    uberInsert.addString(blob);
+    blob.clear();
 
     uberInsert.addUInt32(IsInWorld() ? 1 : 0);
 
@@ -18256,8 +18255,7 @@ void Player::SaveToDB()
 
     uberInsert.addUInt64(uint64(m_deathExpireTime));
 
-    ss << m_taxiTracker.Save();
-    uberInsert.addString(ss);
+    uberInsert.addString(m_taxiTracker.Save());
 
     uberInsert.addUInt32(GetArenaPoints());
 
@@ -18290,31 +18288,24 @@ void Player::SaveToDB()
     uberInsert.addUInt32(uint32(m_specsCount));
     uberInsert.addUInt32(uint32(m_activeSpec));
 
-    for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i) // string
-    {
-        ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << " ";
-    }
-    uberInsert.addString(ss);
+    AppendUInt32List(blob, &m_uint32Values[PLAYER_EXPLORED_ZONES_1], PLAYER_EXPLORED_ZONES_SIZE, binary);
+    uberInsert.addString(blob);
+    blob.clear();
 
-    for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)     // string
-    {
-        ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i) << " ";
-    }
+    AppendUInt32List(blob, &m_uint32Values[PLAYER_VISIBLE_ITEM_1_ENTRYID], EQUIPMENT_SLOT_END * 2, binary);
     // 1 in tbc - 4 in wotlk
-    for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_START + 1; ++i) // string: item id, ench (perm/temp)
+    for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_START + 1; ++i) // item id, ench (perm/temp)
     {
-        ss << (m_items[i] ? m_items[i]->GetEntry() : 0) << " ";
-        ss << uint32(MAKE_PAIR32(0, 0)) << " ";
+        uint32 const bagCache[2] = { m_items[i] ? m_items[i]->GetEntry() : 0, uint32(MAKE_PAIR32(0, 0)) };
+        AppendUInt32List(blob, bagCache, 2, binary);
     }
-    uberInsert.addString(ss);
+    uberInsert.addString(blob);
+    blob.clear();
 
     uberInsert.addUInt32(GetUInt32Value(PLAYER_AMMO_ID));
 
-    for (uint32 i = 0; i < KNOWN_TITLES_SIZE * 2; ++i)      // string
-    {
-        ss << GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i) << " ";
-    }
-    uberInsert.addString(ss);
+    AppendUInt32List(blob, &m_uint32Values[PLAYER__FIELD_KNOWN_TITLES], KNOWN_TITLES_SIZE * 2, binary);
+    uberInsert.addString(blob);
 
     uberInsert.addUInt32(uint32(GetByteValue(PLAYER_FIELD_BYTES, 2)));
 
@@ -21167,7 +21158,8 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateD
         if (target->isVisibleForInState(this, viewPoint, false))
         {
             visibleNow.insert(target);
-            target->BuildCreateUpdateBlockForPlayer(&data, this);
+            if (GetSession()->IsInterestedIn(SMSG_UPDATE_OBJECT))
+                target->BuildCreateUpdateBlockForPlayer(&data, this);
             AddAtClient(target);
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "UpdateVisibilityOf(TemplateV): %s is visible now for %s. Distance = %f", target->GetGuidStr().c_str(), GetGuidStr().c_str(), GetDistance(target));
@@ -22834,8 +22826,7 @@ void Player::SetTitle(CharTitlesEntry const* title, bool lost, bool send)
 void Player::SaveTitles()
 {
     std::string playerTitles;
-    for (uint32 i = 0; i < KNOWN_TITLES_SIZE * 2; ++i)
-        playerTitles += std::to_string(GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i)) + " ";
+    AppendUInt32List(playerTitles, &m_uint32Values[PLAYER__FIELD_KNOWN_TITLES], KNOWN_TITLES_SIZE * 2, sWorld.getConfig(CONFIG_BOOL_SAVE_BINARY_NUMBER_LISTS));
     CharacterDatabase.PExecute("UPDATE characters SET KnownTitles='%s' WHERE guid = '%u'", playerTitles.data(), GetGUIDLow());
 }
 
@@ -852,6 +852,11 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOADWEEKLYQUESTSTATUS,
     PLAYER_LOGIN_QUERY_LOADMONTHLYQUESTSTATUS,
     PLAYER_LOGIN_QUERY_LOADRANDOMBATTLEGROUND,
+    PLAYER_LOGIN_QUERY_LOADPETS,
+    PLAYER_LOGIN_QUERY_LOADPETDECLINEDNAMES,
+    PLAYER_LOGIN_QUERY_LOADPETSPELLS,
+    PLAYER_LOGIN_QUERY_LOADPETSPELLCOOLDOWNS,
+    PLAYER_LOGIN_QUERY_LOADPETAURAS,
 
     MAX_PLAYER_LOGIN_QUERY
 };
@@ -966,15 +971,12 @@ class PlayerTaxi
             return false;
         }
         void AppendTaximaskTo(ByteBuffer& data, bool all);
-
-        friend std::ostringstream& operator<<(std::ostringstream& ss, PlayerTaxi const& taxi);
+        void AppendTaximaskTo(std::string& data, bool binary) const; // db format, TaxiMaskSize numbers
 
     private:
         TaxiMask m_taximask;
 };
 
-std::ostringstream& operator<< (std::ostringstream& ss, PlayerTaxi const& taxi);
-
 /// Holder for BattleGround data
 struct BGData
 {
@@ -1829,7 +1831,7 @@ class Player : public Unit
         void SetAllowLowLevelRaid(bool allow) { ApplyModFlag(PLAYER_FLAGS, PLAYER_FLAGS_ENABLE_LOW_LEVEL_RAID, allow); }
         bool GetAllowLowLevelRaid() const { return HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_ENABLE_LOW_LEVEL_RAID); }
 
-        void SetInGuild(uint32 GuildId) { SetUInt32Value(PLAYER_GUILDID, GuildId); }
+        void SetInGuild(uint32 GuildId);
         void SetRank(uint32 rankId) { SetUInt32Value(PLAYER_GUILDRANK, rankId); }
         void SetGuildIdInvited(uint32 GuildId) { m_GuildIdInvited = GuildId; }
         uint32 GetGuildId() const { return GetUInt32Value(PLAYER_GUILDID);  }
@@ -2363,7 +2365,7 @@ class Player : public Unit
         bool HasAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.find(u->GetObjectGuid()) != m_clientGUIDs.end(); }
         void AddAtClient(WorldObject* target);
         void RemoveAtClient(WorldObject* target);
-        GuidSet& GetClientGuids() { return m_clientGUIDs; }
+        GuidFlatSet& GetClientGuids() { return m_clientGUIDs; }
 
         bool IsVisibleInGridForPlayer(Player* pl) const override;
         bool IsVisibleGloballyFor(Player* u) const;
@@ -2398,6 +2400,9 @@ class Player : public Unit
         void UnsummonPetIfAny();
         void ResummonPetTemporaryUnSummonedIfAny();
         bool IsPetNeedBeTemporaryUnsummoned(Pet* pet) const;
+
+        // saved pets, kept in sync with the character DB by pet saves
+        PetCache& GetPetCache() { return m_petCache; }
         uint32 GetBGPetSpell() const { return m_BGPetSpell; }
         void SetBGPetSpell(uint32 petSpell) { m_BGPetSpell = petSpell; }
         void AddControllable(Unit* controlled);
@@ -2905,6 +2910,7 @@ class Player : public Unit
         // Temporary removed pet cache
         uint32 m_temporaryUnsummonedPetNumber;
         uint32 m_BGPetSpell;
+        PetCache m_petCache;
 
         AchievementMgr m_achievementMgr;
         ReputationMgr  m_reputationMgr;
@@ -2922,7 +2928,7 @@ class Player : public Unit
         Spell* m_modsSpell;
         std::set<SpellModifierPair>* m_consumedMods;
 
-        GuidSet m_clientGUIDs;
+        GuidFlatSet m_clientGUIDs;
 
         // Recruit-A-Friend
         uint8 m_grantableLevels;
@@ -51,6 +51,7 @@
 #include "Tools/Formulas.h"
 #include "Entities/Transports.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Social/WhoListIndex.h"
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
@@ -11299,9 +11300,14 @@ void Unit::SetLevel(uint32 lvl)
 {
     SetUInt32Value(UNIT_FIELD_LEVEL, lvl);
 
-    // group update
-    if ((GetTypeId() == TYPEID_PLAYER) && ((Player*)this)->GetGroup())
-        ((Player*)this)->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        // group update
+        if (((Player*)this)->GetGroup())
+            ((Player*)this)->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+
+        sWhoListIndex.UpdateLevel((Player*)this, lvl);
+    }
 }
 
 void Unit::SetHealth(uint32 val)
@@ -13255,7 +13261,7 @@ void Unit::OnRelocated()
         m_last_notified_position.y = GetPositionY();
         m_last_notified_position.z = GetPositionZ();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
+        GetViewPoint().Call_UpdateVisibilityForOwnerOnMove(sqrt(distsq));
         UpdateObjectVisibility();
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
@@ -14153,11 +14159,13 @@ void Unit::InterruptSpellsCastedOnMe(bool killDelayed)
         if (!killDelayed)
             continue;
         // 2/ Interrupt spells that are not referenced but that still have an event (like delayed spell)
-        for (auto i_events = target->m_events.GetEvents().begin(); i_events != target->m_events.GetEvents().end(); ++i_events)
-            if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_events->second))
-                if (event && event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
+        target->m_events.ForEachEvent([this](BasicEvent* basicEvent)
+        {
+            if (SpellEvent* event = dynamic_cast<SpellEvent*>(basicEvent))
+                if (event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
                     if (event->GetSpell()->getState() != SPELL_STATE_FINISHED)
                         event->GetSpell()->cancel();
+        });
     }
 }
 
@@ -37,6 +37,11 @@ void UpdateData::AddOutOfRangeGUID(GuidSet& guids)
     m_outOfRangeGUIDs.insert(guids.begin(), guids.end());
 }
 
+void UpdateData::AddOutOfRangeGUID(GuidFlatSet const& guids)
+{
+    m_outOfRangeGUIDs.insert(guids.begin(), guids.end());
+}
+
 void UpdateData::AddOutOfRangeGUID(ObjectGuid const& guid)
 {
     m_outOfRangeGUIDs.insert(guid);
@@ -60,55 +65,88 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
     }
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
+    // deflate state reused by every update packet compressed on this thread, deflateInit allocates a few hundred KB each time
+    struct UpdateCompressor
+    {
+        z_stream stream;
+        int level = -1;                                     // -1 - not initialized
+
+        ~UpdateCompressor() { End(); }
+
+        bool Begin(int newLevel)
+        {
+            if (level == newLevel)
+                return deflateReset(&stream) == Z_OK;
+
+            End();
+
+            stream.zalloc = (alloc_func)nullptr;
+            stream.zfree = (free_func)nullptr;
+            stream.opaque = (voidpf)nullptr;
 
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+            int z_res = deflateInit(&stream, newLevel);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return false;
+            }
+
+            level = newLevel;
+            return true;
+        }
+
+        void End()
+        {
+            if (level >= 0)
+                deflateEnd(&stream);
+            level = -1;
+        }
+    };
+
+    thread_local UpdateCompressor t_compressor;
+
+    // block count and out of range part of the packet currently built on this thread
+    thread_local ByteBuffer t_packetHeader(64);
+}
+
+void UpdateData::Compress(void* dst, uint32* dst_size, ByteBuffer const& header, ByteBuffer const& body)
+{
+    UpdateCompressor& compressor = t_compressor;
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    if (!compressor.Begin(sWorld.getConfig(CONFIG_UINT32_COMPRESSION)))
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
+    z_stream& c_stream = compressor.stream;
     c_stream.next_out = (Bytef*)dst;
     c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
+    // header and body are fed separately instead of being copied into one buffer first
+    c_stream.next_in = (Bytef*)header.contents();
+    c_stream.avail_in = (uInt)header.wpos();
+
+    int z_res = deflate(&c_stream, Z_NO_FLUSH);
+    if (z_res != Z_OK || c_stream.avail_in != 0)
     {
         sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
+        compressor.End();
         *dst_size = 0;
         return;
     }
 
-    if (c_stream.avail_in != 0)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
-    }
+    c_stream.next_in = body.wpos() ? (Bytef*)body.contents() : nullptr;
+    c_stream.avail_in = (uInt)body.wpos();
 
     z_res = deflate(&c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
+        compressor.End();
         *dst_size = 0;
         return;
     }
@@ -121,22 +159,22 @@ WorldPacket UpdateData::BuildPacket(size_t index)
     WorldPacket packet;
     MANGOS_ASSERT(packet.empty());                         // shouldn't happen
 
-    ByteBuffer buf(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data[index].m_buffer.wpos());
+    ByteBuffer& header = t_packetHeader;
+    header.clear();
 
-    buf << (uint32)(!m_outOfRangeGUIDs.empty() ? m_data[index].m_blockCount + 1 : m_data[index].m_blockCount);
+    header << (uint32)(!m_outOfRangeGUIDs.empty() ? m_data[index].m_blockCount + 1 : m_data[index].m_blockCount);
 
     if (!m_outOfRangeGUIDs.empty())
     {
-        buf << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
-        buf << (uint32) m_outOfRangeGUIDs.size();
+        header << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
+        header << (uint32) m_outOfRangeGUIDs.size();
 
         for (auto m_outOfRangeGUID : m_outOfRangeGUIDs)
-            buf << m_outOfRangeGUID.WriteAsPacked();
+            header << m_outOfRangeGUID.WriteAsPacked();
     }
 
-    buf.append(m_data[index].m_buffer);
-
-    size_t pSize = buf.wpos();                              // use real used data size
+    ByteBuffer const& body = m_data[index].m_buffer;
+    size_t pSize = header.wpos() + body.wpos();             // use real used data size
 
     if (pSize > 100)                                        // compress large packets
     {
@@ -144,7 +182,7 @@ WorldPacket UpdateData::BuildPacket(size_t index)
         packet.resize(destsize + sizeof(uint32));
 
         packet.put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet.contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
+        Compress(const_cast<uint8*>(packet.contents()) + sizeof(uint32), &destsize, header, body);
         if (destsize == 0)
             return packet;
 
@@ -153,7 +191,9 @@ WorldPacket UpdateData::BuildPacket(size_t index)
     }
     else                                                    // send small packets without compression
     {
-        packet.append(buf);
+        packet.reserve(pSize);
+        packet.append(header);
+        packet.append(body);
         packet.SetOpcode(SMSG_UPDATE_OBJECT);
     }
 
@@ -166,8 +206,21 @@ void UpdateData::Clear()
     m_outOfRangeGUIDs.clear();
 }
 
+void UpdateData::Reset()
+{
+    // only the first buffer is kept, it is bounded by the client packet size
+    m_data.resize(1);
+    m_data[0].m_buffer.clear();
+    m_data[0].m_blockCount = 0;
+    m_currentIndex = 0;
+    m_outOfRangeGUIDs.clear();
+}
+
 void UpdateData::SendData(WorldSession& session)
 {
+    if (!session.IsInterestedIn(SMSG_UPDATE_OBJECT))
+        return;
+
     for (size_t i = 0; i < GetPacketCount(); ++i)
     {
         WorldPacket packet = BuildPacket(i);
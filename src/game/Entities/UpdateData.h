@@ -21,6 +21,7 @@
 
 #include "Util/ByteBuffer.h"
 #include "Entities/ObjectGuid.h"
+#include "Entities/GuidFlatSet.h"
 
 class WorldPacket;
 class WorldSession;
@@ -62,12 +63,15 @@ class UpdateData
         UpdateData();
 
         void AddOutOfRangeGUID(GuidSet& guids);
+        void AddOutOfRangeGUID(GuidFlatSet const& guids);
         void AddOutOfRangeGUID(ObjectGuid const& guid);
         void AddUpdateBlock(const ByteBuffer& block);
         WorldPacket BuildPacket(size_t index); // Copy Elision is a thing
         bool HasData() const { return m_data[0].m_buffer.size() > 0 || !m_outOfRangeGUIDs.empty(); }
         size_t GetPacketCount() const { return m_data.size(); }
         void Clear();
+        // empties the data but keeps the first buffer allocated, for owners reusing the same object every tick
+        void Reset();
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
@@ -78,6 +82,6 @@ class UpdateData
         std::vector<BufferPair> m_data;
         uint32 m_currentIndex;
 
-        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+        static void Compress(void* dst, uint32* dst_size, ByteBuffer const& header, ByteBuffer const& body);
 };
 #endif
@@ -24,8 +24,8 @@
 class UpdateMask
 {
     public:
-        UpdateMask() : mHasData(false), mCount(0), mBlocks(0), mUpdateMask(nullptr) { }
-        UpdateMask(const UpdateMask& mask) : mUpdateMask(nullptr) { *this = mask; }
+        UpdateMask() : mHasData(false), mCount(0), mBlocks(0), mCapacity(0), mUpdateMask(nullptr) { }
+        UpdateMask(const UpdateMask& mask) : mCapacity(0), mUpdateMask(nullptr) { *this = mask; }
 
         ~UpdateMask()
         {
@@ -54,14 +54,19 @@ class UpdateMask
         uint8* GetMask() const { return (uint8*)mUpdateMask; }
         bool HasData() const { return mHasData; }
 
+        // keeps already allocated storage when it is big enough, so a mask can be reused as scratch
         void SetCount(uint32 valuesCount)
         {
-            delete[] mUpdateMask;
-
             mCount = valuesCount;
             mBlocks = (valuesCount + 31) / 32;
 
-            mUpdateMask = new uint32[mBlocks];
+            if (!mUpdateMask || mBlocks > mCapacity)
+            {
+                delete[] mUpdateMask;
+                mUpdateMask = new uint32[mBlocks];
+                mCapacity = mBlocks;
+            }
+
             memset(mUpdateMask, 0, mBlocks << 2);
         }
 
@@ -118,6 +123,7 @@ class UpdateMask
         bool mHasData;
         uint32 mCount;
         uint32 mBlocks;
+        uint32 mCapacity;                                   // allocated blocks
         uint32* mUpdateMask;
 };
 #endif
@@ -28,6 +28,7 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "Entities/ObjectGuid.h"
 #include "World/World.h"
+#include "Social/WhoListIndex.h"
 
 #include <mutex>
 
@@ -312,18 +313,20 @@ void ObjectAccessor::AddObject(Player* player)
 {
     HashMapHolder<Player>::Insert(player);
     PlayerNameMapHolder::Insert(player);
+    sWhoListIndex.AddPlayer(player);
 }
 
 void ObjectAccessor::RemoveObject(Player* player)
 {
     HashMapHolder<Player>::Remove(player);
     PlayerNameMapHolder::Remove(player);
+    sWhoListIndex.RemovePlayer(player);
 }
 
 /// Define the static member of HashMapHolder
 
 template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
-template <class T> std::mutex HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::LockType HashMapHolder<T>::i_lock;
 
 /// Global definitions for the hashmap storage
 
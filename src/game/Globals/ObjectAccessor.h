@@ -33,6 +33,7 @@
 
 #include <functional>
 #include <mutex>
+#include <shared_mutex>
 
 class Unit;
 class WorldObject;
@@ -44,9 +45,10 @@ class HashMapHolder
     public:
 
         typedef std::unordered_map<ObjectGuid, T*>   MapType;
-        typedef std::mutex LockType;
-        typedef std::lock_guard<std::mutex> ReadGuard;
-        typedef std::lock_guard<std::mutex> WriteGuard;
+        // lookups by guid vastly outnumber logins/logouts, so readers must not serialize
+        typedef std::shared_mutex LockType;
+        typedef std::shared_lock<LockType> ReadGuard;
+        typedef std::unique_lock<LockType> WriteGuard;
 
         static void Insert(T* o);
 
@@ -162,6 +162,13 @@ ObjectMgr::ObjectMgr() :
     m_PetNumbers("Pet numbers"),
     m_FirstTemporaryCreatureGuid(1),
     m_FirstTemporaryGameObjectGuid(1),
+    m_oldMailsRunning(false),
+    m_oldMailsBaseTime(0),
+    m_oldMailsLastId(0),
+    m_oldMailsCount(0),
+    m_oldMailsChunks(0),
+    m_oldMailsStartTime(0),
+    m_oldMailsMaxChunkTime(0),
     m_unitConditionMgr(std::make_unique<UnitConditionMgr>()),
     m_worldStateExpressionMgr(std::make_unique<WorldStateExpressionMgr>()),
     m_combatConditionMgr(std::make_unique<CombatConditionMgr>(*m_unitConditionMgr, *m_worldStateExpressionMgr))
@@ -6433,24 +6440,123 @@ void ObjectMgr::LoadTrainerGreetingLocales()
     sLog.outString();
 }
 
-// not very fast function but it is called only once a day, or on starting-up
+// called once a day, or on starting-up
 /// @param serverUp true if the server is already running, false when the server is started
 void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
+    // previous run did not reach the end of the table yet
+    if (m_oldMailsRunning)
+        return;
+
     time_t basetime = time(nullptr);
     DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
+
+    m_oldMailsBaseTime = basetime;
+    m_oldMailsLastId = 0;
+    m_oldMailsCount = 0;
+    m_oldMailsChunks = 0;
+    m_oldMailsStartTime = WorldTimer::getMSTime();
+    m_oldMailsMaxChunkTime = 0;
+
+    if (serverUp)
+    {
+        // results are applied from the world thread result queue, next chunk is requested only when the previous one is done
+        m_oldMailsRunning = QueueOldMailsChunk();
+        return;
+    }
+
     // delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
-    //                                                     0  1           2      3        4         5           6   7       8
-    QueryResult* result = CharacterDatabase.PQuery("SELECT id,messageType,sender,receiver,has_items,expire_time,cod,checked,mailTemplateId FROM mail WHERE expire_time < '" UI64FMTD "'", (uint64)basetime);
-    if (!result)
+    CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
+
+    uint32 chunkSize = sWorld.getConfig(CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE);
+    uint32 rows;
+    do
     {
-        BarGoLink bar(1);
-        bar.step();
-        sLog.outString(">> Only expired mails (need to be return or delete) or DB table `mail` is empty.");
-        sLog.outString();
-        return;                                             // any mails need to be returned or deleted
+        QueryResult* mailResult = CharacterDatabase.PQuery("SELECT id,messageType,sender,receiver,has_items,expire_time,cod,checked,mailTemplateId FROM mail "
+                                  "WHERE id > '%u' AND expire_time < '" UI64FMTD "' ORDER BY id LIMIT %u", m_oldMailsLastId, (uint64)basetime, chunkSize);
+        QueryResult* itemResult = mailResult ? CharacterDatabase.PQuery("SELECT mail_id,item_guid,item_template FROM mail_items JOIN "
+                                  "(SELECT id FROM mail WHERE id > '%u' AND expire_time < '" UI64FMTD "' ORDER BY id LIMIT %u) AS expired ON mail_id = expired.id",
+                                  m_oldMailsLastId, (uint64)basetime, chunkSize) : nullptr;
+
+        rows = ProcessOldMailsChunk(mailResult, itemResult, false);
+        delete mailResult;
+        delete itemResult;
+    }
+    while (rows == chunkSize);
+
+    sLog.outString(">> Returned or deleted %u old mails", m_oldMailsCount);
+    sLog.outString();
+}
+
+bool ObjectMgr::QueueOldMailsChunk()
+{
+    uint32 chunkSize = sWorld.getConfig(CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE);
+
+    SqlQueryHolder* holder = new SqlQueryHolder;
+    holder->SetSize(2);
+    //                     0  1           2      3        4         5           6   7       8
+    holder->SetPQuery(0, "SELECT id,messageType,sender,receiver,has_items,expire_time,cod,checked,mailTemplateId FROM mail "
+                      "WHERE id > '%u' AND expire_time < '" UI64FMTD "' ORDER BY id LIMIT %u", m_oldMailsLastId, (uint64)m_oldMailsBaseTime, chunkSize);
+    holder->SetPQuery(1, "SELECT mail_id,item_guid,item_template FROM mail_items JOIN "
+                      "(SELECT id FROM mail WHERE id > '%u' AND expire_time < '" UI64FMTD "' ORDER BY id LIMIT %u) AS expired ON mail_id = expired.id",
+                      m_oldMailsLastId, (uint64)m_oldMailsBaseTime, chunkSize);
+
+    if (!CharacterDatabase.DelayQueryHolder(this, &ObjectMgr::HandleOldMailsChunk, holder))
+    {
+        delete holder;
+        return false;
+    }
+
+    return true;
+}
+
+void ObjectMgr::HandleOldMailsChunk(QueryResult* /*dummy*/, SqlQueryHolder* holder)
+{
+    if (!holder)
+    {
+        m_oldMailsRunning = false;
+        return;
+    }
+
+    uint32 startTime = WorldTimer::getMSTime();
+
+    QueryResult* mailResult = holder->GetResult(0);
+    QueryResult* itemResult = holder->GetResult(1);
+    uint32 rows = ProcessOldMailsChunk(mailResult, itemResult, true);
+    delete mailResult;
+    delete itemResult;
+    delete holder;
+
+    m_oldMailsMaxChunkTime = std::max(m_oldMailsMaxChunkTime, WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+
+    if (rows == sWorld.getConfig(CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE) && QueueOldMailsChunk())
+        return;
+
+    m_oldMailsRunning = false;
+
+    uint32 totalTime = WorldTimer::getMSTimeDiff(m_oldMailsStartTime, WorldTimer::getMSTime());
+    sLog.outString("Returned or deleted %u old mails in %u chunks, %u ms (%u mails/s, longest chunk %u ms)",
+                   m_oldMailsCount, m_oldMailsChunks, totalTime, totalTime ? uint32(uint64(m_oldMailsCount) * IN_MILLISECONDS / totalTime) : m_oldMailsCount, m_oldMailsMaxChunkTime);
+}
+
+/// @return amount of mail rows in the chunk, the chunk was the last one if it is below chunk size
+uint32 ObjectMgr::ProcessOldMailsChunk(QueryResult* mailResult, QueryResult* itemResult, bool serverUp)
+{
+    if (!mailResult)
+        return 0;
+
+    ++m_oldMailsChunks;
+
+    // both results are ordered by mail id only on the mail side, so gather the items first
+    std::unordered_map<uint32, MailItemInfoVec> items;
+    if (itemResult)
+    {
+        do
+        {
+            Field* fields = itemResult->Fetch();
+            items[fields[0].GetUInt32()].push_back({ fields[1].GetUInt32(), fields[2].GetUInt32() });
+        }
+        while (itemResult->NextRow());
     }
 
     // std::ostringstream delitems, delmails; // will be here for optimization
@@ -6458,14 +6564,15 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
     // delitems << "DELETE FROM item_instance WHERE guid IN ( ";
     // delmails << "DELETE FROM mail WHERE id IN ( "
 
-    BarGoLink bar(result->GetRowCount());
-    uint32 count = 0;
+    time_t basetime = m_oldMailsBaseTime;
+    uint32 rows = 0;
 
+    CharacterDatabase.BeginTransaction();
     do
     {
-        bar.step();
+        ++rows;
 
-        Field* fields = result->Fetch();
+        Field* fields = mailResult->Fetch();
         Mail* m = new Mail;
         m->messageID = fields[0].GetUInt32();
         m->messageType = fields[1].GetUInt8();
@@ -6478,6 +6585,8 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         m->checked = fields[7].GetUInt32();
         m->mailTemplateId = fields[8].GetInt16();
 
+        m_oldMailsLastId = m->messageID;
+
         Player* pl = nullptr;
         if (serverUp)
             pl = GetPlayer(m->receiverGuid);
@@ -6491,22 +6600,10 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         // delete or return mail:
         if (has_items)
         {
-            QueryResult* resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m->messageID);
-            if (resultItems)
-            {
-                do
-                {
-                    Field* fields2 = resultItems->Fetch();
-
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
+            auto itemsItr = items.find(m->messageID);
+            if (itemsItr != items.end())
+                m->items = std::move(itemsItr->second);
 
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
-
-                delete resultItems;
-            }
             // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
             if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
             {
@@ -6526,6 +6623,7 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
                     CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m->sender, itr2->item_guid);
                 }
                 delete m;
+                ++m_oldMailsCount;
                 continue;
             }
         }
@@ -6534,13 +6632,12 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         // delmails << m->messageID << ", ";
         CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
         delete m;
-        ++count;
+        ++m_oldMailsCount;
     }
-    while (result->NextRow());
-    delete result;
+    while (mailResult->NextRow());
+    CharacterDatabase.CommitTransaction();
 
-    sLog.outString(">> Loaded %u mails", count);
-    sLog.outString();
+    return rows;
 }
 
 void ObjectMgr::LoadQuestAreaTriggers()
@@ -1368,6 +1368,11 @@ class ObjectMgr
 
     private:
         void LoadCreatureAddons(SQLStorage& creatureaddons, char const* entryName, char const* comment);
+
+        // old mails are walked in id ordered chunks, while the server is up one chunk per world tick
+        bool QueueOldMailsChunk();
+        void HandleOldMailsChunk(QueryResult* /*dummy*/, SqlQueryHolder* holder);
+        uint32 ProcessOldMailsChunk(QueryResult* mailResult, QueryResult* itemResult, bool serverUp);
         void ConvertCreatureAddonAuras(CreatureDataAddon* addon, char const* table, char const* guidEntryStr);
         void LoadQuestRelationsHelper(QuestRelationsMap& map, char const* table);
         void LoadVendors(char const* tableName, bool isTemplates);
@@ -1378,6 +1383,14 @@ class ObjectMgr
 
         MailLevelRewardMap m_mailLevelRewardMap;
 
+        bool m_oldMailsRunning;
+        time_t m_oldMailsBaseTime;
+        uint32 m_oldMailsLastId;                            // chunks continue after this mail id
+        uint32 m_oldMailsCount;
+        uint32 m_oldMailsChunks;
+        uint32 m_oldMailsStartTime;
+        uint32 m_oldMailsMaxChunkTime;                      // longest time a chunk took on the world thread
+
         typedef std::map<uint32, PetLevelInfo*> PetLevelInfoMap;
         // PetLevelInfoMap[creature_id][level]
         PetLevelInfoMap petInfo;                            // [creature_id][level]
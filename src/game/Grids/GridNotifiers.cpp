@@ -38,6 +38,40 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
     }
 }
 
+VisibleNotifier::VisibleNotifier(Camera& c, float stableMargin) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()),
+    i_stableMargin(stableMargin), i_visibilityDistance(c.GetBody()->GetMap()->GetVisibilityDistance()), i_checked(0), i_skipped(0)
+{
+    // visibility distance overrides make the per object range differ from the map one
+    if (c.GetOwner()->GetVisibilityData().IsVisibilityOverridden() || c.GetOwner()->GetTransport() || c.GetBody()->GetTransport())
+        i_stableMargin = 0.0f;
+}
+
+bool VisibleNotifier::IsVisibilityStable(WorldObject const* target) const
+{
+    // only objects whose visibility depends on nothing but the distance to the viewpoint, everything else
+    // (phase, stealth, invisibility, spawn state) changes on the target or viewer side and triggers its own update
+    if (target->GetVisibilityData().IsVisibilityOverridden() || target->GetTransport())
+        return false;
+
+    WorldObject const* viewPoint = i_camera.GetBody();
+    float inner, outer;
+    if (target->GetTypeId() == TYPEID_GAMEOBJECT)
+    {
+        GameObject const* go = static_cast<GameObject const*>(target);
+        // stealthed gameobjects also depend on viewer facing and distance
+        if (go->GetVisibilityData().GetStealthMask())
+            return false;
+        go->GetVisibilityBounds(i_visibilityDistance + viewPoint->GetCombatReach(), inner, outer);
+    }
+    else
+        inner = outer = i_visibilityDistance + viewPoint->GetCombatReach() + target->GetCombatReach();
+
+    float distSq = target->GetDistance(viewPoint, false, DIST_CALC_NONE);
+    if (inner > i_stableMargin && distSq < (inner - i_stableMargin) * (inner - i_stableMargin))
+        return true;
+    return distSq > (outer + i_stableMargin) * (outer + i_stableMargin);
+}
+
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
@@ -59,9 +93,9 @@ void VisibleNotifier::Notify()
     }
 
     // Far objects update on player notify
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
+    for (GuidFlatSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
     {
-        GuidSet::iterator current = itr++;
+        GuidFlatSet::iterator current = itr++;
         if (WorldObject* obj = player.GetMap()->GetWorldObject(*current))
         {
             if (!obj->GetVisibilityData().IsVisibilityOverridden())
@@ -72,7 +106,7 @@ void VisibleNotifier::Notify()
         }
     }
 
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
+    for (GuidFlatSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
     {
         if ((*itr).IsMOTransport())
         {
@@ -84,7 +118,7 @@ void VisibleNotifier::Notify()
 
     // generate outOfRange for not iterate objects
     i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    for (GuidFlatSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
     {
         if (WorldObject* target = player.GetMap()->GetWorldObject(*itr))
         {
@@ -103,10 +137,13 @@ void VisibleNotifier::Notify()
     if (i_data.HasData())
     {
         // send create/outofrange packet to player (except player create updates that already sent using SendUpdateToPlayer)
-        for (size_t i = 0; i < i_data.GetPacketCount(); ++i)
+        if (player.GetSession()->IsInterestedIn(SMSG_UPDATE_OBJECT))
         {
-            WorldPacket packet = i_data.BuildPacket(i);
-            player.GetSession()->SendPacket(packet);
+            for (size_t i = 0; i < i_data.GetPacketCount(); ++i)
+            {
+                WorldPacket packet = i_data.BuildPacket(i);
+                player.GetSession()->SendPacket(packet);
+            }
         }
 
         // send out of range to other players if need
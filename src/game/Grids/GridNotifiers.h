@@ -37,13 +37,19 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
+        GuidFlatSet i_clientGUIDs;
         WorldObjectSet i_visibleNow;
+        float i_stableMargin;                               // objects further than this from the view distance edge keep their state
+        float i_visibilityDistance;
+        uint32 i_checked;
+        uint32 i_skipped;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()) {}
+        explicit VisibleNotifier(Camera& c, float stableMargin = 0.0f);
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
+
+        bool IsVisibilityStable(WorldObject const* target) const;
     };
 
     struct VisibleChangesNotifier
@@ -54,9 +60,9 @@ namespace MaNGOS
         template<class T> void Visit(GridRefManager<T>&) {}
         void Visit(CameraMapType&);
 
-        GuidSet& GetUnvisitedGuids() { return m_unvisitedGuids; }
+        GuidFlatSet& GetUnvisitedGuids() { return m_unvisitedGuids; }
 
-        GuidSet m_unvisitedGuids;
+        GuidFlatSet m_unvisitedGuids;
     };
 
     struct MessageDeliverer
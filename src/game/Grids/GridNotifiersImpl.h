@@ -34,7 +34,13 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
+        if (i_stableMargin && IsVisibilityStable(iter->getSource()))
+            ++i_skipped;
+        else
+        {
+            i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
+            ++i_checked;
+        }
         i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
     }
 }
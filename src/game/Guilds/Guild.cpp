@@ -249,6 +249,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
         pl->SetInGuild(m_Id);
         pl->SetRank(newmember.RankId);
         pl->SetGuildIdInvited(0);
+        MemberLoggedIn(pl);
     }
 
     UpdateAccountsNumber();
@@ -553,6 +554,7 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
     }
 
     members.erase(lowguid);
+    m_onlineMembers.erase(lowguid);
 
     Player* player = sObjectMgr.GetPlayer(guid);
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
@@ -582,11 +584,12 @@ void Guild::BroadcastToGuild(WorldSession* session, const std::string& msg, uint
     WorldPacket data;
     ChatHandler::BuildChatPacket(data, CHAT_MSG_GUILD, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    std::set<uint32> const* ignoredBy = sSocialMgr.GetIgnoreListers(player->GetObjectGuid());
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* pl = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        Player* pl = itr->second;
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+        if (pl->IsInWorld() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && (!ignoredBy || ignoredBy->find(itr->first) == ignoredBy->end()))
             pl->GetSession()->SendPacket(data);
     }
 }
@@ -600,41 +603,42 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
     if (!player || !HasRankRight(player->GetRank(), GR_RIGHT_OFFCHATSPEAK))
         return;
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-    {
-        WorldPacket data;
-        ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
+    WorldPacket data;
+    ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-        Player* pl = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+    std::set<uint32> const* ignoredBy = sSocialMgr.GetIgnoreListers(player->GetObjectGuid());
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        Player* pl = itr->second;
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+        if (pl->IsInWorld() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && (!ignoredBy || ignoredBy->find(itr->first) == ignoredBy->end()))
             pl->GetSession()->SendPacket(data);
     }
 }
 
 void Guild::BroadcastPacket(WorldPacket const& packet)
 {
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-    {
-        Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-        if (player)
-            player->GetSession()->SendPacket(packet);
-    }
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+        if (itr->second->IsInWorld())
+            itr->second->GetSession()->SendPacket(packet);
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket const& packet, uint32 rankId)
 {
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        if (itr->second.RankId == rankId)
-        {
-            Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-            if (player)
-                player->GetSession()->SendPacket(packet);
-        }
+        MemberList::const_iterator member = members.find(itr->first);
+        if (member != members.end() && member->second.RankId == rankId && itr->second->IsInWorld())
+            itr->second->GetSession()->SendPacket(packet);
     }
 }
 
+void Guild::MemberLoggedIn(Player* player)
+{
+    if (members.find(player->GetGUIDLow()) != members.end())
+        m_onlineMembers[player->GetGUIDLow()] = player;
+}
+
 // add new event to all already connected guild memebers
 void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 maxLevel, uint32 minRank)
 {
@@ -306,6 +306,7 @@ class Guild
 
         void DeleteGuildBankItems(bool alsoInDB = false);
         typedef std::unordered_map<uint32, MemberSlot> MemberList;
+        typedef std::unordered_map<uint32, Player*> OnlineMemberList;
         typedef std::vector<RankInfo> RankList;
 
         uint32 GetId() const { return m_Id; }
@@ -356,12 +357,15 @@ class Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = nullptr)
         {
-            for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
-                if (Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
-                    if (player != except)
-                        _do(player);
+            for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+                if (itr->second->IsInWorld() && itr->second != except)
+                    _do(itr->second);
         }
 
+        // keep the online member list used by broadcasts up to date
+        void MemberLoggedIn(Player* player);
+        void MemberLoggedOut(ObjectGuid guid) { m_onlineMembers.erase(guid.GetCounter()); }
+
         void CreateRank(std::string name_, uint32 rights);
         void DelRank();
         std::string GetRankName(uint32 rankId);
@@ -466,6 +470,7 @@ class Guild
         RankList m_Ranks;
 
         MemberList members;
+        OnlineMemberList m_onlineMembers;                   // members with a logged in player, subset of members
 
         std::vector<GuildBankTab> m_TabList;
 
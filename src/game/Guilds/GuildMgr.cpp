@@ -24,6 +24,8 @@
 #include "Policies/Singleton.h"
 #include "Util/ProgressBar.h"
 #include "World/World.h"
+#include "Globals/ObjectAccessor.h"
+#include "Social/WhoListIndex.h"
 
 INSTANTIATE_SINGLETON_1(GuildMgr);
 
@@ -40,6 +42,10 @@ GuildMgr::~GuildMgr()
 void GuildMgr::AddGuild(Guild* guild)
 {
     m_GuildMap[guild->GetId()] = guild;
+
+    // a new guild's leader joined before its name could be looked up
+    if (Player* leader = ObjectAccessor::FindPlayer(guild->GetLeaderGuid()))
+        sWhoListIndex.UpdateGuild(leader, guild->GetId());
 }
 
 void GuildMgr::RemoveGuild(uint32 guildId)
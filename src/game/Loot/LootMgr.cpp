@@ -20,6 +20,7 @@
 #include "Log.h"
 #include "Globals/ObjectMgr.h"
 #include "Util/ProgressBar.h"
+#include "Util/AliasTable.h"
 #include "World/World.h"
 #include "Util/Util.h"
 #include "Globals/SharedDefines.h"
@@ -31,6 +32,8 @@
 #include "BattleGround/BattleGroundMgr.h"
 #include <sstream>
 #include <iomanip>
+#include <future>
+#include <thread>
 
 INSTANTIATE_SINGLETON_1(LootMgr);
 
@@ -66,6 +69,8 @@ class LootTemplate::LootGroup                               // A set of loot def
         bool HasQuestDropForPlayer(Player const* player) const;
         // The same for active quests of the player
         void Process(Loot& loot, Player const* lootOwner) const; // Rolls an item from the group (if any) and adds the item to the loot
+        void CollectDropChances(LootDropChanceList& drops, float multiplier) const; // Adds the chance of every entry to be the rolled one
+        void Compile();                                     // Builds the roll tables (after loading stage)
         float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
         float TotalChance() const;                          // Overall chance for the group
 
@@ -74,6 +79,7 @@ class LootTemplate::LootGroup                               // A set of loot def
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+        AliasTable ExplicitlyChancedTable;                  // Roll table of explicitly chanced entries plus the chance of none of them
 
         LootStoreItem const* Roll(Loot const& loot, Player const* lootOwner) const; // Rolls an item from the group, returns NULL if all miss their chances
 };
@@ -101,7 +107,8 @@ void LootStore::LoadLootTable()
     LootTemplateMap::const_iterator tab;
     uint32 count = 0;
 
-    // Clearing store (for reloading case)
+    // Clearing store (for reloading case), a running drop simulation reads it
+    sLootMgr.CancelDropSimulation();
     Clear();
 
     //                                                 0      1     2                    3        4              5         6
@@ -174,6 +181,9 @@ void LootStore::LoadLootTable()
 
         delete result;
 
+        for (auto& lootTemplate : m_LootTemplates)
+            lootTemplate.second->Compile();
+
         Verify();                                           // Checks validity of the loot store
 
         sLog.outString(">> Loaded %u loot definitions (" SIZEFMTD " templates) from table %s", count, m_LootTemplates.size(), GetName());
@@ -291,17 +301,22 @@ bool LootStoreItem::Roll(bool rate) const
     if (chance >= 100.0f)
         return true;
 
+    return roll_chance_f(GetRollChance(rate));
+}
+
+float LootStoreItem::GetRollChance(bool rate) const
+{
     if (mincountOrRef < 0)                                  // reference case
-        return roll_chance_f(chance * (rate ? sWorld.getConfig(CONFIG_FLOAT_RATE_DROP_ITEM_REFERENCED) : 1.0f));
+        return chance * (rate ? sWorld.getConfig(CONFIG_FLOAT_RATE_DROP_ITEM_REFERENCED) : 1.0f);
 
     if (needs_quest)
-        return roll_chance_f(chance * (rate ? sWorld.getConfig(CONFIG_FLOAT_RATE_DROP_ITEM_QUEST) : 1.0f));
+        return chance * (rate ? sWorld.getConfig(CONFIG_FLOAT_RATE_DROP_ITEM_QUEST) : 1.0f);
 
     ItemPrototype const* pProto = ObjectMgr::GetItemPrototype(itemid);
 
     float qualityModifier = pProto && rate ? sWorld.getConfig(qualityToRate[pProto->Quality]) : 1.0f;
 
-    return roll_chance_f(chance * qualityModifier);
+    return chance * qualityModifier;
 }
 
 // Checks correctness of values
@@ -2461,26 +2476,61 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
         EqualChanced.push_back(item);
 }
 
+// Builds the alias table of the explicitly chanced entries (after loading stage)
+void LootTemplate::LootGroup::Compile()
+{
+    if (ExplicitlyChanced.empty())
+        return;
+
+    std::vector<double> weights;
+    weights.reserve(ExplicitlyChanced.size() + 1);
+    float totalChance = 0.0f;
+    for (auto const& entry : ExplicitlyChanced)
+    {
+        weights.push_back(entry.chance);
+        totalChance += entry.chance;
+    }
+
+    // over 100% the entries rolled last in the shuffled order are cut short, no fixed weights give the same drop rates
+    // such groups keep the original roll without the table
+    if (totalChance > 100.0f)
+        return;
+
+    // last slot is the chance that none of the entries is chosen
+    weights.push_back(std::max(100.0f - totalChance, 0.0f));
+    ExplicitlyChancedTable.Build(weights);
+}
+
 // Rolls an item from the group, returns NULL if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player const* lootOwner) const
 {
-    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
+    if (!ExplicitlyChancedTable.Empty())                    // First explicitly chanced entries are checked
     {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+        uint32 index = ExplicitlyChancedTable.Sample();
+        if (index < ExplicitlyChanced.size())
+        {
+            LootStoreItem const* lsi = &ExplicitlyChanced[index];
 
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : ExplicitlyChanced)
-            lootStoreItemVector.push_back(&itr);
+            // condition is checked for the chosen entry only, if it fails its chance goes to the equal chanced part
+            if (!lsi->conditionId || !lootOwner || LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+                return lsi;
 
-        // randomize the new vector
-        shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+            sLog.outDebug("In explicit chance -> This item cannot be added! (%u)", lsi->itemid);
+        }
+    }
+    else if (!ExplicitlyChanced.empty())                    // total chance over 100%, entries are checked in random order
+    {
+        static thread_local std::vector<uint32> order;
+        uint32 size = uint32(ExplicitlyChanced.size());
+        order.resize(size);
+        for (uint32 i = 0; i < size; ++i)
+            order[i] = i;
 
         float chance = rand_chance_f();
-
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+        for (uint32 i = 0; i < size; ++i)
         {
-            LootStoreItem const* lsi = *itr;
+            std::swap(order[i], order[urand(i, size - 1)]);
+            LootStoreItem const* lsi = &ExplicitlyChanced[order[i]];
 
             if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
             {
@@ -2499,19 +2549,17 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player cons
 
     if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
     {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
-
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : EqualChanced)
-            lootStoreItemVector.push_back(&itr);
-
-        // randomize the new vector
-        std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+        // entries are shuffled lazily, only as far as needed to find one that can be added
+        static thread_local std::vector<uint32> order;
+        uint32 size = uint32(EqualChanced.size());
+        order.resize(size);
+        for (uint32 i = 0; i < size; ++i)
+            order[i] = i;
 
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+        for (uint32 i = 0; i < size; ++i)
         {
-            LootStoreItem const* lsi = *itr;
+            std::swap(order[i], order[urand(i, size - 1)]);
+            LootStoreItem const* lsi = &EqualChanced[order[i]];
 
             //check if we already have that item in the loot list
             if (loot.IsItemAlreadyIn(lsi->itemid))
@@ -2590,6 +2638,28 @@ float LootTemplate::LootGroup::TotalChance() const
     return result;
 }
 
+// Explicitly chanced entries are tried first, equal chanced entries share whatever chance is left
+void LootTemplate::LootGroup::CollectDropChances(LootDropChanceList& drops, float multiplier) const
+{
+    float explicitChance = 0.0f;
+    for (auto const& entry : ExplicitlyChanced)
+    {
+        float chance = std::min(entry.chance, 100.0f - explicitChance);
+        if (chance <= 0.0f)
+            break;
+
+        explicitChance += chance;
+        drops.push_back({ entry.itemid, chance / 100.0f * multiplier, uint8(entry.mincountOrRef), entry.maxcount });
+    }
+
+    if (EqualChanced.empty() || explicitChance >= 100.0f)
+        return;
+
+    float equalChance = (100.0f - explicitChance) / EqualChanced.size();
+    for (auto const& entry : EqualChanced)
+        drops.push_back({ entry.itemid, equalChance / 100.0f * multiplier, uint8(entry.mincountOrRef), entry.maxcount });
+}
+
 void LootTemplate::LootGroup::Verify(LootStore const& lootstore, uint32 id, uint32 group_id) const
 {
     float chance = RawTotalChance();
@@ -2646,6 +2716,13 @@ void LootTemplate::AddEntry(LootStoreItem& item)
         Entries.push_back(item);
 }
 
+// Builds the roll tables of all groups (after loading stage)
+void LootTemplate::Compile()
+{
+    for (auto& group : Groups)
+        group.Compile();
+}
+
 // Rolls for every item in the template and adds the rolled items the the loot
 void LootTemplate::Process(Loot& loot, Player const* lootOwner, LootStore const& store, bool rate, uint8 groupId) const
 {
@@ -2687,6 +2764,34 @@ void LootTemplate::Process(Loot& loot, Player const* lootOwner, LootStore const&
         Group.Process(loot, lootOwner);
 }
 
+void LootTemplate::CollectDropChances(LootDropChanceList& drops, bool rate, float multiplier, uint8 groupId) const
+{
+    if (groupId)                                            // Group reference uses own processing of the group
+    {
+        if (groupId <= Groups.size())
+            Groups[groupId - 1].CollectDropChances(drops, multiplier);
+        return;
+    }
+
+    for (auto const& entry : Entries)
+    {
+        float chance = std::min(entry.GetRollChance(rate), 100.0f) / 100.0f * multiplier;
+        if (chance <= 0.0f)
+            continue;
+
+        if (entry.mincountOrRef < 0)                        // References processing
+        {
+            if (LootTemplate const* referenced = LootTemplates_Reference.GetLootFor(-entry.mincountOrRef))
+                referenced->CollectDropChances(drops, rate, chance * entry.maxcount, entry.group);
+        }
+        else
+            drops.push_back({ entry.itemid, chance, uint8(entry.mincountOrRef), entry.maxcount });
+    }
+
+    for (auto const& group : Groups)
+        group.CollectDropChances(drops, multiplier);
+}
+
 // True if template includes at least 1 quest drop entry
 bool LootTemplate::HasQuestDrop(LootTemplateMap const& store, uint8 groupId) const
 {
@@ -3228,34 +3333,105 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
     if (amountOfCheck < 1)
         amountOfCheck = 1;
 
-    std::unique_ptr<Loot> loot = std::unique_ptr<Loot>(new Loot(LOOT_DEBUG));
-
     // get loot table for provided loot id
-    LootTemplate const* lootTable = store->GetLootFor(lootId);
-    if (!lootTable)
+    if (!store->GetLootFor(lootId))
     {
         chat.PSendSysMessage("No table loot found for lootId(%u) in table loot table '%s'.", lootId, store->GetName());
         return;
     }
 
-    // do the loot drop simulation
+    if (m_dropSimulationRunning.exchange(true))
+    {
+        chat.SendSysMessage("Another loot drop simulation is still running, try again later.");
+        return;
+    }
+
+    chat.PSendSysMessage("Simulating %u drops of loot id(%u) in %s in background, results will follow.", amountOfCheck, lootId, store->GetName());
+
+    // the previous simulation has finished, only its thread is left to be joined
+    if (m_dropSimulationThread.joinable())
+        m_dropSimulationThread.join();
+    m_dropSimulationCancel = false;
+
+    ObjectGuid requester = chat.GetSession() && chat.GetSession()->GetPlayer() ? chat.GetSession()->GetPlayer()->GetObjectGuid() : ObjectGuid();
+    m_dropSimulationThread = std::thread([this, store, amountOfCheck, lootId, requester]()
+    {
+        std::unordered_map<uint32, uint32> itemStatsMap;
+        if (LootTemplate const* lootTable = store->GetLootFor(lootId))
+        {
+            // use half of the cores at most, the realm keeps running meanwhile
+            uint32 workerCount = std::max(std::thread::hardware_concurrency() / 2, 1u);
+            workerCount = std::min(workerCount, amountOfCheck);
+
+            std::vector<std::future<std::unordered_map<uint32, uint32>>> workers;
+            for (uint32 i = 0; i < workerCount; ++i)
+            {
+                uint32 checks = amountOfCheck / workerCount + (i < amountOfCheck % workerCount ? 1 : 0);
+                workers.push_back(std::async(std::launch::async, &LootMgr::SimulateDrops, lootTable, store, checks, std::cref(m_dropSimulationCancel)));
+            }
+
+            for (auto& worker : workers)
+                for (auto const& itemStat : worker.get())
+                    itemStatsMap[itemStat.first] += itemStat.second;
+        }
+        m_dropSimulationRunning = false;
+
+        // reload or shutdown, the store and possibly the world are going away
+        if (m_dropSimulationCancel)
+        {
+            sLog.outString("Drop simulation of loot id(%u) in %s cancelled.", lootId, store->GetName());
+            return;
+        }
+
+        // report from world thread, the requester may have logged out meanwhile
+        sWorld.GetMessager().AddMessage([itemStatsMap, store, amountOfCheck, lootId, requester](World* /*world*/)
+        {
+            Player* player = requester ? sObjectMgr.GetPlayer(requester) : nullptr;
+            ReportDropStats(player, itemStatsMap, amountOfCheck, lootId, store->GetName());
+        });
+    });
+}
+
+void LootMgr::CancelDropSimulation() const
+{
+    if (!m_dropSimulationThread.joinable())
+        return;
+
+    m_dropSimulationCancel = true;
+    m_dropSimulationThread.join();
+}
+
+// Rolls the loot template amountOfCheck times and counts every dropped item
+std::unordered_map<uint32, uint32> LootMgr::SimulateDrops(LootTemplate const* lootTable, LootStore const* store, uint32 amountOfCheck, std::atomic<bool> const& cancel)
+{
     std::unordered_map<uint32, uint32> itemStatsMap;
+    std::unique_ptr<Loot> loot = std::unique_ptr<Loot>(new Loot(LOOT_DEBUG));
     for (uint32 i = 1; i <= amountOfCheck; ++i)
     {
+        if ((i & 0x3FF) == 0 && cancel.load(std::memory_order_relaxed))
+            break;
+
         lootTable->Process(*loot, nullptr, *store, store->IsRatesAllowed());
         for (auto lootItem : loot->m_lootItems)
             ++itemStatsMap[lootItem->itemId];
         loot->Clear();
     }
+    return itemStatsMap;
+}
 
-    // sort the result
-    auto comp = [](std::pair<uint32, uint32> const& a, std::pair<uint32, uint32> const& b) { return a.second > b.second; };
-    std::set<std::pair<uint32, uint32>, decltype(comp)> sortedResult(
-        itemStatsMap.begin(), itemStatsMap.end(), comp);
+void LootMgr::ReportDropStats(Player* player, std::unordered_map<uint32, uint32> const& itemStatsMap, uint32 amountOfCheck, uint32 lootId, char const* storeName)
+{
+    // sort the result, most dropped first
+    std::vector<std::pair<uint32, uint32>> sortedResult(itemStatsMap.begin(), itemStatsMap.end());
+    std::sort(sortedResult.begin(), sortedResult.end(), [](std::pair<uint32, uint32> const& a, std::pair<uint32, uint32> const& b)
+    {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
 
     // report the result in both chat client and console
-    chat.PSendSysMessage("Results for %u drops simulation of loot id(%u) in %s:", amountOfCheck, lootId, store->GetName());
-    sLog.outString("Results for %u drops simulation of loot id(%u) in %s:", amountOfCheck, lootId, store->GetName());
+    if (player)
+        ChatHandler(player).PSendSysMessage("Results for %u drops simulation of loot id(%u) in %s (95%% confidence interval):", amountOfCheck, lootId, storeName);
+    sLog.outString("Results for %u drops simulation of loot id(%u) in %s (95%% confidence interval):", amountOfCheck, lootId, storeName);
     std::stringstream ss;
     for (auto itemStat : sortedResult)
     {
@@ -3266,13 +3442,21 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
 
         std::string name = pProto->Name1;
         sObjectMgr.GetItemLocaleStrings(itemId, -1, &name);
-        float computedStats = itemStat.second / float(amountOfCheck) * 100;
+
+        // wilson score interval, stays sane for very rare drops
+        double const z = 1.96;
+        double n = amountOfCheck;
+        double p = itemStat.second / n;
+        double denominator = 1.0 + z * z / n;
+        double center = (p + z * z / (2.0 * n)) / denominator;
+        double halfWidth = z * std::sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n)) / denominator;
+
         ss.str("");
         ss.clear();
-        ss << std::fixed << std::setprecision(4) << computedStats;
-        ss << '%';
-        chat.PSendSysMessage(LANG_ITEM_LIST_CHAT, itemId, itemId, name.c_str(), ss.str().c_str());
-        sLog.outString("%6u - %-45s \tfound %6u/%-6u \tso %8s%% drop", itemStat.first, name.c_str(), itemStat.second, amountOfCheck, ss.str().c_str());
+        ss << std::fixed << std::setprecision(4) << p * 100 << "% [" << std::max(center - halfWidth, 0.0) * 100 << "% - " << std::min(center + halfWidth, 1.0) * 100 << "%]";
+        if (player)
+            ChatHandler(player).PSendSysMessage(LANG_ITEM_LIST_CHAT, itemId, itemId, name.c_str(), ss.str().c_str());
+        sLog.outString("%6u - %-45s \tfound %6u/%-6u \tso %s drop", itemStat.first, name.c_str(), itemStat.second, amountOfCheck, ss.str().c_str());
     }
 }
 
@@ -24,6 +24,9 @@
 #include "Globals/SharedDefines.h"
 
 #include <vector>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 #include "Entities/Bag.h"
 
 #define LOOT_ROLL_TIMEOUT  (1*MINUTE*IN_MILLISECONDS)
@@ -179,10 +182,22 @@ struct LootStoreItem
     {}
 
     bool Roll(bool rate) const;                             // Checks if the entry takes it's chance (at loot generation)
+    float GetRollChance(bool rate) const;                   // Chance used by Roll, with drop rates applied
     bool IsValid(LootStore const& store, uint32 entry) const;
     // Checks correctness of values
 };
 
+// Expected drops of one item entry per template roll, conditions are ignored
+struct LootDropChance
+{
+    uint32  itemid;
+    float   chance;                                         // expected times the entry drops per roll (0..1 for single entries)
+    uint8   mincount;
+    uint8   maxcount;
+};
+
+typedef std::vector<LootDropChance> LootDropChanceList;
+
 struct LootItem
 {
     uint32       itemId;
@@ -262,6 +277,8 @@ class LootTemplate
     public:
         // Adds an entry to the group (at loading stage)
         void AddEntry(LootStoreItem& item);
+        // Builds the roll tables of all groups (after loading stage)
+        void Compile();
         // Rolls for every item in the template and adds the rolled items the the loot
         void Process(Loot& loot, Player const* lootOwner, LootStore const& store, bool rate, uint8 groupId = 0) const;
 
@@ -272,6 +289,9 @@ class LootTemplate
         // True if at least one player fulfils loot condition
         static bool PlayerOrGroupFulfilsCondition(const Loot& loot, Player const* lootOwner, uint16 conditionId);
 
+        // Adds every item the template can drop with its expected drop chance per Process call
+        void CollectDropChances(LootDropChanceList& drops, bool rate, float multiplier = 1.0f, uint8 groupId = 0) const;
+
         // Checks integrity of the template
         void Verify(LootStore const& lootstore, uint32 id) const;
         void CheckLootRefs(LootIdSet* ref_set) const;
@@ -430,10 +450,25 @@ inline void LoadLootTables(LootIdSet& ids_set)
 class LootMgr
 {
     public:
+        LootMgr() : m_dropSimulationRunning(false), m_dropSimulationCancel(false) {}
+        ~LootMgr() { CancelDropSimulation(); }
+
         void PlayerVote(Player* player, ObjectGuid const& lootTargetGuid, uint32 itemSlot, RollVote vote);
         Loot* GetLoot(Player* player, ObjectGuid const& targetGuid = ObjectGuid()) const;
+        // Simulates the drops on background threads, results are reported from the world thread
         void CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 lootId, std::string lootStore) const;
         bool ExistsRefLootTemplate(uint32 refLootId) const;
+
+        // Aborts a running drop simulation and waits for its threads, called before loot stores are reloaded and at shutdown
+        void CancelDropSimulation() const;
+
+    private:
+        static std::unordered_map<uint32, uint32> SimulateDrops(LootTemplate const* lootTable, LootStore const* store, uint32 amountOfCheck, std::atomic<bool> const& cancel);
+        static void ReportDropStats(Player* player, std::unordered_map<uint32, uint32> const& itemStatsMap, uint32 amountOfCheck, uint32 lootId, char const* storeName);
+
+        mutable std::atomic<bool> m_dropSimulationRunning;
+        mutable std::atomic<bool> m_dropSimulationCancel;
+        mutable std::thread m_dropSimulationThread;
 };
 
 #define sLootMgr MaNGOS::Singleton<LootMgr>::Instance()
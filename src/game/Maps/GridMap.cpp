@@ -710,8 +710,67 @@ bool GridMap::ExistVMap(uint32 mapid, int gx, int gy)
 }
 
 //////////////////////////////////////////////////////////////////////////
-TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
+// Area flag cache
+// GetAreaFlag() does a vmap ray query and WMOAreaTable lookups, and is called for every moving unit
+// answers are cached per thread (so map update threads never contend) in a 2-way set associative table
+// keyed on the position quantized to AREA_CACHE_XY_STEP x AREA_CACHE_XY_STEP x AREA_CACHE_Z_STEP yards
+#define AREA_CACHE_SETS         4096                        // must be power of 2
+#define AREA_CACHE_XY_STEP      0.5f
+#define AREA_CACHE_Z_STEP       1.0f
+
+namespace
 {
+    struct AreaCacheEntry
+    {
+        uint32 mapId;
+        uint32 generation;
+        int32 x, y, z;
+        uint16 areaFlag;
+        bool isOutdoors;
+        bool used;
+    };
+
+    struct AreaCacheSet
+    {
+        AreaCacheEntry entries[2];
+        uint8 lastUsed;                                     // index of most recently used entry, the other one is evicted first
+    };
+
+    thread_local std::unique_ptr<AreaCacheSet[]> t_areaCache;
+
+    // source of unique generation values, so a TerrainInfo recreated for the same map never matches stale entries
+    std::atomic<uint32> s_areaCacheGeneration(0);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Static line of sight cache
+// spell, AI and movement code repeat the same vmap LOS rays many times per second
+// results are cached per thread in a direct mapped table keyed on both endpoints quantized to LOS_CACHE_STEP yards
+// entries expire after vmap.losCacheTTL ms and are dropped when the grid of either endpoint (or a neighbour) is loaded/unloaded
+#define LOS_CACHE_SIZE          4096                        // must be power of 2
+#define LOS_CACHE_STEP          0.25f
+
+namespace
+{
+    struct LosCacheEntry
+    {
+        uint32 mapId;
+        uint32 generation[2];                               // of the grids containing the two endpoints
+        int32 pos[6];
+        uint32 expireTime;
+        bool ignoreM2Model;
+        bool inLineOfSight;
+        bool used;
+    };
+
+    thread_local std::unique_ptr<LosCacheEntry[]> t_losCache;
+}
+
+//////////////////////////////////////////////////////////////////////////
+TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid),
+    m_areaCacheHits(0), m_areaCacheMisses(0), m_losCacheHits(0), m_losCacheMisses(0)
+{
+    uint32 generation = ++s_areaCacheGeneration;
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
     {
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
@@ -719,6 +778,7 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
             m_GridMaps[i][k] = nullptr;
             m_GridRef[i][k] = 0;
             m_GridMapsLoadAttempted[i][k] = false;
+            m_gridGeneration[i][k] = generation;
         }
     }
 
@@ -804,6 +864,7 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
 
                 // unload VMAPS...
                 m_vmgr->unloadMap(m_mapId, x, y);
+                InvalidateAreaCache(x, y);
 
                 // unload mmap... - not possible like this - mmaps are per-map
                 // MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId, x, y);
@@ -1033,6 +1094,126 @@ AreaNameInfo TerrainInfo::GetAreaName(float x, float y, float z, uint32 langInde
 }
 
 uint16 TerrainInfo::GetAreaFlag(float x, float y, float z, bool* isOutdoors) const
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_TERRAIN_AREA_CACHE))
+    {
+        bool outdoors;
+        uint16 areaFlag = CalculateAreaFlag(x, y, z, outdoors);
+        if (isOutdoors)
+            *isOutdoors = outdoors;
+        return areaFlag;
+    }
+
+    if (!t_areaCache)
+        t_areaCache.reset(new AreaCacheSet[AREA_CACHE_SETS]());
+
+    int32 qx = int32(floor(x / AREA_CACHE_XY_STEP));
+    int32 qy = int32(floor(y / AREA_CACHE_XY_STEP));
+    int32 qz = int32(floor(z / AREA_CACHE_Z_STEP));
+    uint32 generation = GetGridGeneration(x, y);
+
+    uint32 hash = (uint32(qx) * 73856093u) ^ (uint32(qy) * 19349663u) ^ (uint32(qz) * 83492791u) ^ (m_mapId * 2654435761u);
+    AreaCacheSet& set = t_areaCache[hash & (AREA_CACHE_SETS - 1)];
+
+    for (uint8 i = 0; i < 2; ++i)
+    {
+        AreaCacheEntry const& entry = set.entries[i];
+        if (entry.used && entry.x == qx && entry.y == qy && entry.z == qz && entry.mapId == m_mapId && entry.generation == generation)
+        {
+            set.lastUsed = i;
+            ++m_areaCacheHits;
+            if (isOutdoors)
+                *isOutdoors = entry.isOutdoors;
+            return entry.areaFlag;
+        }
+    }
+
+    ++m_areaCacheMisses;
+
+    bool outdoors;
+    uint16 areaFlag = CalculateAreaFlag(x, y, z, outdoors);
+
+    uint8 victim = set.lastUsed ^ 1;
+    set.entries[victim] = { m_mapId, generation, qx, qy, qz, areaFlag, outdoors, true };
+    set.lastUsed = victim;
+
+    if (isOutdoors)
+        *isOutdoors = outdoors;
+    return areaFlag;
+}
+
+uint32 TerrainInfo::GetGridGeneration(float x, float y) const
+{
+    int gx = std::min(std::max(int(32 - x / SIZE_OF_GRIDS), 0), MAX_NUMBER_OF_GRIDS - 1);
+    int gy = std::min(std::max(int(32 - y / SIZE_OF_GRIDS), 0), MAX_NUMBER_OF_GRIDS - 1);
+    return m_gridGeneration[gx][gy];
+}
+
+void TerrainInfo::InvalidateAreaCache(uint32 x, uint32 y)
+{
+    // a vmap model reaching over a grid border stays loaded while either grid is, neighbours can change too
+    uint32 generation = ++s_areaCacheGeneration;
+    for (uint32 gx = x ? x - 1 : x; gx <= x + 1 && gx < MAX_NUMBER_OF_GRIDS; ++gx)
+        for (uint32 gy = y ? y - 1 : y; gy <= y + 1 && gy < MAX_NUMBER_OF_GRIDS; ++gy)
+            m_gridGeneration[gx][gy] = generation;
+}
+
+bool TerrainInfo::IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) const
+{
+    VMAP::IVMapManager* vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
+    uint32 ttl = sWorld.getConfig(CONFIG_UINT32_VMAP_LOS_CACHE_TTL);
+    // entries are only valid while the grids the ray crosses are unchanged, that is known for rays shorter than a grid
+    // every grid crossed by those is the grid of an endpoint or one of its neighbours
+    if (!ttl || std::abs(x2 - x1) > SIZE_OF_GRIDS || std::abs(y2 - y1) > SIZE_OF_GRIDS)
+        return vMapManager->isInLineOfSight(m_mapId, x1, y1, z1, x2, y2, z2, ignoreM2Model);
+
+    if (!t_losCache)
+        t_losCache.reset(new LosCacheEntry[LOS_CACHE_SIZE]());
+
+    int32 pos[6] =
+    {
+        int32(floor(x1 / LOS_CACHE_STEP)), int32(floor(y1 / LOS_CACHE_STEP)), int32(floor(z1 / LOS_CACHE_STEP)),
+        int32(floor(x2 / LOS_CACHE_STEP)), int32(floor(y2 / LOS_CACHE_STEP)), int32(floor(z2 / LOS_CACHE_STEP))
+    };
+
+    uint32 generation[2] = { GetGridGeneration(x1, y1), GetGridGeneration(x2, y2) };
+
+    // line of sight is symmetric, store both directions in one entry
+    if (std::lexicographical_compare(pos + 3, pos + 6, pos, pos + 3))
+    {
+        std::swap_ranges(pos, pos + 3, pos + 3);
+        std::swap(generation[0], generation[1]);
+    }
+
+    uint32 hash = m_mapId * 2654435761u ^ uint32(ignoreM2Model);
+    for (int32 coord : pos)
+        hash = (hash ^ uint32(coord)) * 16777619u;
+
+    LosCacheEntry& entry = t_losCache[hash & (LOS_CACHE_SIZE - 1)];
+    uint32 now = WorldTimer::getMSTime();
+
+    if (entry.used && entry.mapId == m_mapId && std::equal(generation, generation + 2, entry.generation) && entry.ignoreM2Model == ignoreM2Model &&
+            std::equal(pos, pos + 6, entry.pos) && int32(entry.expireTime - now) > 0)
+    {
+        ++m_losCacheHits;
+        return entry.inLineOfSight;
+    }
+
+    ++m_losCacheMisses;
+
+    bool inLineOfSight = vMapManager->isInLineOfSight(m_mapId, x1, y1, z1, x2, y2, z2, ignoreM2Model);
+
+    entry.mapId = m_mapId;
+    std::copy(generation, generation + 2, entry.generation);
+    std::copy(pos, pos + 6, entry.pos);
+    entry.expireTime = now + ttl;
+    entry.ignoreM2Model = ignoreM2Model;
+    entry.inLineOfSight = inLineOfSight;
+    entry.used = true;
+    return inLineOfSight;
+}
+
+uint16 TerrainInfo::CalculateAreaFlag(float x, float y, float z, bool& isOutdoors) const
 {
     uint32 mogpFlags = 0;
     int32 adtId, rootId, groupId;
@@ -1069,13 +1250,11 @@ uint16 TerrainInfo::GetAreaFlag(float x, float y, float z, bool* isOutdoors) con
             areaflag = GetAreaFlagByMapId(GetMapId());
     }
 
-    if (isOutdoors)
-    {
-        if (haveAreaInfo)
-            *isOutdoors = IsOutdoorWMO(mogpFlags, foundWmoEntry, atEntry);
-        else
-            *isOutdoors = true;
-    }
+    if (haveAreaInfo)
+        isOutdoors = IsOutdoorWMO(mogpFlags, foundWmoEntry, atEntry);
+    else
+        isOutdoors = true;
+
     return areaflag;
 }
 
@@ -1353,6 +1532,7 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
 
             delete[] tmp;
             m_GridMaps[x][y] = map;
+            InvalidateAreaCache(x, y);
         }
     }
 
@@ -1384,6 +1564,8 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
     if (m_GridMaps[x][y])
         m_GridMaps[x][y]->SetFullyLoaded();
 
+    InvalidateAreaCache(x, y);
+
     return  m_GridMaps[x][y];
 }
 
@@ -175,6 +175,15 @@ class TerrainInfo : public Referencable<std::atomic_long>
 
         bool CanCheckLiquidLevel(float x, float y) const;
 
+        // hits/misses of the quantized area flag cache for this map
+        uint64 GetAreaCacheHits() const { return m_areaCacheHits; }
+        uint64 GetAreaCacheMisses() const { return m_areaCacheMisses; }
+
+        // static vmap line of sight only, dynamic objects are checked by the map
+        bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) const;
+        uint64 GetLosCacheHits() const { return m_losCacheHits; }
+        uint64 GetLosCacheMisses() const { return m_losCacheMisses; }
+
     protected:
         friend class Map;
         friend class ObjectMgr;
@@ -192,8 +201,21 @@ class TerrainInfo : public Referencable<std::atomic_long>
         int RefGrid(const uint32& x, const uint32& y);
         int UnrefGrid(const uint32& x, const uint32& y);
 
+        uint16 CalculateAreaFlag(float x, float y, float z, bool& isOutdoors) const;
+        uint32 GetGridGeneration(float x, float y) const;
+        void InvalidateAreaCache(uint32 x, uint32 y);
+
         const uint32 m_mapId;
 
+        // cached area flags are only valid for the generation of their grid they were computed in
+        // generation is changed on every map/vmap load and unload of the grid or one of its neighbours
+        // line of sight cache entries use the generations of the grids of both endpoints
+        std::atomic<uint32> m_gridGeneration[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        mutable std::atomic<uint64> m_areaCacheHits;
+        mutable std::atomic<uint64> m_areaCacheMisses;
+        mutable std::atomic<uint64> m_losCacheHits;
+        mutable std::atomic<uint64> m_losCacheMisses;
+
         GridMap* m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         bool m_GridMapsLoadAttempted[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
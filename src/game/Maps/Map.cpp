@@ -43,6 +43,7 @@
 #include "Grids/ObjectGridLoader.h"
 #include "Vmap/GameObjectModel.h"
 #include "LFG/LFGMgr.h"
+#include "Util/Trace.h"
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
@@ -70,6 +71,14 @@ Map::~Map()
     delete m_weatherSystem;
     m_weatherSystem = nullptr;
 
+    m_scriptSchedule.ForEach([this](TimerWheelNode* node)
+    {
+        m_scriptSchedule.Cancel(node);
+        delete static_cast<ScheduledScriptAction*>(node);
+    });
+    for (ScheduledScriptAction* node : m_scriptActionPool)
+        delete node;
+
     for (auto transport : m_transports)
     {
         transport->Object::RemoveFromWorld();
@@ -733,6 +742,7 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::Obje
 
 void Map::Update(const uint32& t_diff)
 {
+    TRACE_SCOPE("Map::Update");
 
 #ifdef BUILD_METRICS
     metric::duration<std::chrono::milliseconds> meas("map.update", {
@@ -774,6 +784,7 @@ void Map::Update(const uint32& t_diff)
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     {
+        TRACE_SCOPE("Map::Update sessions");
 #ifdef BUILD_METRICS
         uint32 updatedSessions = 0;
         metric::duration<std::chrono::milliseconds> sessions_meas("map.update.session", {
@@ -801,11 +812,14 @@ void Map::Update(const uint32& t_diff)
     }
 
     /// update players at tick
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
-            plr->Update(t_diff);
+        TRACE_SCOPE("Map::Update players");
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+                plr->Update(t_diff);
+        }
     }
 
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -863,10 +877,13 @@ void Map::Update(const uint32& t_diff)
     }
 
     // update all objects
-    for (auto wObj : objToUpdate)
     {
-        wObj->Update(t_diff);
-        ++count;
+        TRACE_SCOPE("Map::Update objects");
+        for (auto wObj : objToUpdate)
+        {
+            wObj->Update(t_diff);
+            ++count;
+        }
     }
 
 #ifdef BUILD_METRICS
@@ -880,6 +897,7 @@ void Map::Update(const uint32& t_diff)
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
     {
+        TRACE_SCOPE("Map::Update grid states");
         for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
         {
             NGridType* grid = i->getSource();
@@ -891,11 +909,14 @@ void Map::Update(const uint32& t_diff)
     }
 
     ///- Process necessary scripts
-    if (!m_scriptSchedule.empty())
-        ScriptsProcess();
+    {
+        TRACE_SCOPE("Map::Update scripts");
+        if (!m_scriptSchedule.Empty())
+            ScriptsProcess();
 
-    if (i_data)
-        i_data->Update(t_diff);
+        if (i_data)
+            i_data->Update(t_diff);
+    }
 
     m_weatherSystem->UpdateWeathers(t_diff);
 }
@@ -2101,15 +2122,19 @@ bool Map::ScriptsStart(ScriptMapType scriptType, uint32 id, Object* source, Obje
 
     if (execParams)                                         // Check if the execution should be uniquely
     {
-        for (ScriptScheduleMap::const_iterator searchItr = m_scriptSchedule.begin(); searchItr != m_scriptSchedule.end(); ++searchItr)
+        bool alreadyStarted = false;
+        m_scriptSchedule.ForEach([&](TimerWheelNode* node)
         {
-            if (searchItr->second.IsSameScript(scriptMapMap->first, id,
-                                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE ? sourceGuid : ObjectGuid(),
-                                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET ? targetGuid : ObjectGuid(), ownerGuid))
-            {
-                DETAIL_FILTER_LOG(LOG_FILTER_DB_SCRIPT, "DB-SCRIPTS: Process table `%s` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", scriptMapMap->first, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
-                return true;
-            }
+            if (!alreadyStarted && static_cast<ScheduledScriptAction*>(node)->action.IsSameScript(scriptMapMap->first, id,
+                    execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE ? sourceGuid : ObjectGuid(),
+                    execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET ? targetGuid : ObjectGuid(), ownerGuid))
+                alreadyStarted = true;
+        });
+
+        if (alreadyStarted)
+        {
+            DETAIL_FILTER_LOG(LOG_FILTER_DB_SCRIPT, "DB-SCRIPTS: Process table `%s` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", scriptMapMap->first, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
+            return true;
         }
     }
 
@@ -2137,7 +2162,7 @@ bool Map::ScriptsStart(ScriptMapType scriptType, uint32 id, Object* source, Obje
     {
         auto const& scriptInfo = scriptInfoItr->second;
         ScriptAction sa(scriptType, this, sourceGuid, targetGuid, ownerGuid, scriptInfo);
-        m_scriptSchedule.emplace(GetCurrentClockTime() + std::chrono::milliseconds(scriptInfoItr->first), sa);
+        ScheduleScriptAction(sa, scriptInfoItr->first);
     }
 
     return true;
@@ -2155,45 +2180,65 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     ScriptAction sa(SCRIPT_TYPE_INTERNAL, this, sourceGuid, targetGuid, ownerGuid, std::make_shared<ScriptInfo>(script));
 
     if (delay)
-    {
-        m_scriptSchedule.emplace(GetCurrentClockTime() + std::chrono::milliseconds(delay), sa);
-    }
+        ScheduleScriptAction(sa, delay);
     else
         sa.HandleScriptStep();
 }
 
+void Map::ScheduleScriptAction(ScriptAction const& action, uint32 delay)
+{
+    ScheduledScriptAction* node;
+    if (m_scriptActionPool.empty())
+        node = new ScheduledScriptAction(action);
+    else
+    {
+        node = m_scriptActionPool.back();
+        m_scriptActionPool.pop_back();
+        node->action = action;
+    }
+
+    m_scriptSchedule.Schedule(node, uint64((GetCurrentClockTime() + std::chrono::milliseconds(delay)).time_since_epoch().count()));
+}
+
 /// Process queued scripts
 void Map::ScriptsProcess()
 {
-    if (m_scriptSchedule.empty())
+    if (m_scriptSchedule.Empty())
         return;
 
+    uint64 now = uint64(GetCurrentClockTime().time_since_epoch().count());
+    m_scriptSchedule.Advance(now);
+
     ///- Process overdue queued scripts
-    ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
-    // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= GetCurrentClockTime()))
+    // expired nodes come out in time order, the executed step stays scheduled until it is done
+    while (TimerWheelNode* node = m_scriptSchedule.PeekExpired(now))
     {
-        if (iter->second.HandleScriptStep())
+        ScheduledScriptAction* step = static_cast<ScheduledScriptAction*>(node);
+        if (step->action.HandleScriptStep())
         {
             // Terminate following script steps of this script
-            const char* tableName = iter->second.GetTableName();
-            uint32 id = iter->second.GetId();
-            ObjectGuid sourceGuid = iter->second.GetSourceGuid();
-            ObjectGuid targetGuid = iter->second.GetTargetGuid();
-            ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
+            const char* tableName = step->action.GetTableName();
+            uint32 id = step->action.GetId();
+            ObjectGuid sourceGuid = step->action.GetSourceGuid();
+            ObjectGuid targetGuid = step->action.GetTargetGuid();
+            ObjectGuid ownerGuid = step->action.GetOwnerGuid();
 
-            for (ScriptScheduleMap::iterator rmItr = m_scriptSchedule.begin(); rmItr != m_scriptSchedule.end();)
+            m_scriptSchedule.ForEach([&](TimerWheelNode* rmNode)
             {
-                if (rmItr->second.IsSameScript(tableName, id, sourceGuid, targetGuid, ownerGuid))
-                    m_scriptSchedule.erase(rmItr++);
-                else
-                    ++rmItr;
-            }
+                ScheduledScriptAction* rmStep = static_cast<ScheduledScriptAction*>(rmNode);
+                if (rmStep->action.IsSameScript(tableName, id, sourceGuid, targetGuid, ownerGuid))
+                {
+                    m_scriptSchedule.Cancel(rmStep);
+                    m_scriptActionPool.push_back(rmStep);
+                }
+            });
         }
-        else
-            m_scriptSchedule.erase(iter);
 
-        iter = m_scriptSchedule.begin();
+        if (step->IsScheduled())
+        {
+            m_scriptSchedule.Cancel(step);
+            m_scriptActionPool.push_back(step);
+        }
     }
 }
 
@@ -2327,7 +2372,10 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
 
 void Map::SendObjectUpdates()
 {
-    UpdateDataMapType update_players;
+    TRACE_SCOPE("Map::SendObjectUpdates");
+
+    UpdateDataMapType& update_players = m_updatePlayers;
+    size_t reused = update_players.size();
 
     while (!i_objectsToClientUpdate.empty())
     {
@@ -2336,13 +2384,39 @@ void Map::SendObjectUpdates()
         obj->BuildUpdateData(update_players);
     }
 
-    for (auto& update_player : update_players)
+    UpdateBufferStats& stats = m_updateBufferStats;
+    ++stats.ticks;
+    stats.reusedBuffers += reused;
+    stats.newBuffers += update_players.size() - reused;
+
+    for (auto itr = update_players.begin(); itr != update_players.end();)
     {
-        for (size_t i = 0; i < update_player.second.GetPacketCount(); ++i)
+        UpdateData& data = itr->second;
+
+        // nothing for this player in this tick, the key may also be a player which already left the map
+        if (!data.HasData())
         {
-            WorldPacket packet = update_player.second.BuildPacket(i);
-            update_player.first->GetSession()->SendPacket(packet);
+            itr = update_players.erase(itr);
+            continue;
         }
+
+        for (size_t i = 0; i < data.GetPacketCount(); ++i)
+        {
+            WorldPacket packet = data.BuildPacket(i);
+            ++stats.packets;
+            stats.sentBytes += packet.size();
+            if (packet.GetOpcode() == SMSG_COMPRESSED_UPDATE_OBJECT)
+            {
+                ++stats.compressedPackets;
+                stats.rawBytes += packet.read<uint32>(0);
+            }
+            else
+                stats.rawBytes += packet.size();
+            itr->first->GetSession()->SendPacket(packet);
+        }
+
+        data.Reset();
+        ++itr;
     }
 }
 
@@ -2572,7 +2646,7 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask, bool ignoreM2Model) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
+    return m_TerrainData->IsInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
            && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask, ignoreM2Model);
 }
 
@@ -39,6 +39,7 @@
 #include "Maps/SpawnManager.h"
 #include "Maps/MapDataContainer.h"
 #include "World/WorldStateVariableManager.h"
+#include "Utilities/TimerWheel.h"
 
 #include <bitset>
 #include <functional>
@@ -402,6 +403,39 @@ class Map : public GridRefManager<NGridType>
 
         SpawnManager& GetSpawnManager() { return m_spawnManager; }
 
+        // camera visibility passes on this map, time in microseconds
+        struct VisibilityStats
+        {
+            uint64 fullPasses = 0;
+            uint64 movePasses = 0;
+            uint64 checkedObjects = 0;
+            uint64 skippedObjects = 0;
+            uint64 totalTime = 0;
+        };
+        VisibilityStats& GetVisibilityStats() { return m_visibilityStats; }
+
+        // object update packets sent from this map, bytes before and after compression
+        struct UpdateBufferStats
+        {
+            uint64 ticks = 0;
+            uint64 packets = 0;
+            uint64 compressedPackets = 0;
+            uint64 rawBytes = 0;
+            uint64 sentBytes = 0;
+            uint64 reusedBuffers = 0;
+            uint64 newBuffers = 0;
+        };
+        UpdateBufferStats const& GetUpdateBufferStats() const { return m_updateBufferStats; }
+
+        // creature updates on this map, idle ones are updates which carried skipped time
+        struct CreatureUpdateStats
+        {
+            uint64 fullUpdates = 0;
+            uint64 idleUpdates = 0;
+            uint64 skippedUpdates = 0;
+        };
+        CreatureUpdateStats& GetCreatureUpdateStats() { return m_creatureUpdateStats; }
+
         MapDataContainer& GetMapDataContainer() { return m_dataContainer; }
         MapDataContainer const& GetMapDataContainer() const { return m_dataContainer; }
         WorldStateVariableManager& GetVariableManager() { return m_variableManager; }
@@ -455,6 +489,7 @@ class Map : public GridRefManager<NGridType>
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
+        void ScheduleScriptAction(ScriptAction const& action, uint32 delay);
 
         void SendObjectUpdates();
         std::set<Object*> i_objectsToClientUpdate;
@@ -500,8 +535,13 @@ class Map : public GridRefManager<NGridType>
 
         WorldObjectSet i_objectsToRemove;
 
-        typedef std::multimap<TimePoint, ScriptAction> ScriptScheduleMap;
-        ScriptScheduleMap m_scriptSchedule;
+        struct ScheduledScriptAction : public TimerWheelNode
+        {
+            explicit ScheduledScriptAction(ScriptAction const& _action) : action(_action) {}
+            ScriptAction action;
+        };
+        TimerWheel m_scriptSchedule;
+        std::vector<ScheduledScriptAction*> m_scriptActionPool;  // released nodes, reused by the next scheduled steps
 
         InstanceData* i_data;
         uint32 i_script_id;
@@ -525,6 +565,12 @@ class Map : public GridRefManager<NGridType>
 
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
+        VisibilityStats m_visibilityStats;
+
+        // kept between ticks so the per player update buffers are allocated once instead of every tick
+        UpdateDataMapType m_updatePlayers;
+        UpdateBufferStats m_updateBufferStats;
+        CreatureUpdateStats m_creatureUpdateStats;
 
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
@@ -27,6 +27,7 @@
 #include "Grids/CellImpl.h"
 #include "Globals/ObjectMgr.h"
 #include "Maps/MapWorkers.h"
+#include "Util/Trace.h"
 #include <future>
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
@@ -195,6 +196,8 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    TRACE_SCOPE("MapManager::Update");
+
     for (auto& map : i_maps)
     {
         if (m_updater.activated())
@@ -204,7 +207,10 @@ void MapManager::Update(uint32 diff)
     }
 
     if (m_updater.activated())
+    {
+        TRACE_SCOPE("MapManager::Update wait for maps");
         m_updater.wait();
+    }
 
     // remove all maps which can be unloaded
     MapMapType::iterator iter = i_maps.begin();
@@ -77,90 +77,167 @@ void SpawnManager::Initialize()
 
 void SpawnManager::AddCreature(uint32 respawnDelay, uint32 dbguid)
 {
-    m_spawns.emplace_back(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay), dbguid, HIGHGUID_UNIT);
-    std::sort(m_spawns.begin(), m_spawns.end());
+    AddSpawn(respawnDelay, dbguid, HIGHGUID_UNIT);
 }
 
 void SpawnManager::AddGameObject(uint32 respawnDelay, uint32 dbguid)
 {
-    m_spawns.emplace_back(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay), dbguid, HIGHGUID_GAMEOBJECT);
-    std::sort(m_spawns.begin(), m_spawns.end());
+    AddSpawn(respawnDelay, dbguid, HIGHGUID_GAMEOBJECT);
+}
+
+void SpawnManager::AddSpawn(uint32 respawnDelay, uint32 dbguid, HighGuid high)
+{
+    TimePoint when = m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay);
+    auto result = m_spawns.emplace(MakeSpawnKey(high, dbguid), SpawnInfo(when, dbguid, high));
+    // already scheduled - the latest schedule wins instead of spawning twice
+    if (!result.second)
+        result.first->second.Reschedule(when);
+
+    Schedule(result.first->second);
+}
+
+void SpawnManager::Schedule(SpawnInfo const& spawnInfo)
+{
+    m_spawnQueue.push_back({ spawnInfo.GetRespawnTime(), MakeSpawnKey(spawnInfo.GetHighGuid(), spawnInfo.GetDbGuid()) });
+    std::push_heap(m_spawnQueue.begin(), m_spawnQueue.end(), std::greater<ScheduledSpawn>());
 }
 
 void SpawnManager::RespawnCreature(uint32 dbguid, uint32 respawnDelay)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
-    {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
-    }
-    if (!found)
-        AddCreature(respawnDelay, dbguid);
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
-    if (respawnDelay > 0)
-        std::sort(m_spawns.begin(), m_spawns.end());
+    RespawnSpawn(dbguid, HIGHGUID_UNIT, respawnDelay);
 }
 
 void SpawnManager::RespawnGameObject(uint32 dbguid, uint32 respawnDelay)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
+    RespawnSpawn(dbguid, HIGHGUID_GAMEOBJECT, respawnDelay);
+}
+
+void SpawnManager::RespawnSpawn(uint32 dbguid, HighGuid high, uint32 respawnDelay)
+{
+    uint64 key = MakeSpawnKey(high, dbguid);
+    auto itr = m_spawns.find(key);
+    if (itr == m_spawns.end() || itr->second.IsUsed())
     {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
+        AddSpawn(respawnDelay, dbguid, high);
+        return;
     }
-    if (!found)
-        AddGameObject(respawnDelay, dbguid);
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
+
+    if (high == HIGHGUID_UNIT)
+        m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
+    else
+        m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
+
     if (respawnDelay > 0)
-        std::sort(m_spawns.begin(), m_spawns.end());
+    {
+        itr->second.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
+        Schedule(itr->second);
+        return;
+    }
+
+    // construction can add spawns and rehash, so erase by key
+    if (itr->second.ConstructForMap(m_map))
+        m_spawns.erase(key);
 }
 
 void SpawnManager::RespawnAll()
 {
-    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+    for (auto itr = m_spawns.begin(); itr != m_spawns.end(); ++itr)
+        m_dueSpawns.push_back(itr->first);
+
+    for (uint64 key : m_dueSpawns)
     {
-        auto& spawnInfo = *itr;
+        auto itr = m_spawns.find(key);
+        if (itr == m_spawns.end() || itr->second.IsUsed())
+            continue;
+
+        SpawnInfo& spawnInfo = itr->second;
         if (spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
             m_map.GetPersistentState()->SaveGORespawnTime(spawnInfo.GetDbGuid(), 0);
         if (spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
             m_map.GetPersistentState()->SaveCreatureRespawnTime(spawnInfo.GetDbGuid(), 0);
-        spawnInfo.ConstructForMap(m_map);
+        if (spawnInfo.ConstructForMap(m_map))
+            m_spawns.erase(key);
+    }
+    m_dueSpawns.clear();
+}
+
+uint64 SpawnManager::GetCellSortKey(SpawnInfo const& spawnInfo) const
+{
+    float x = 0.f, y = 0.f;
+    if (spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
+    {
+        if (CreatureData const* data = sObjectMgr.GetCreatureData(spawnInfo.GetDbGuid()))
+        {
+            x = data->posX;
+            y = data->posY;
+        }
+    }
+    else if (GameObjectData const* data = sObjectMgr.GetGOData(spawnInfo.GetDbGuid()))
+    {
+        x = data->posX;
+        y = data->posY;
     }
+
+    // grid first so all cells of one grid are spawned together
+    GridPair grid = MaNGOS::ComputeGridPair(x, y);
+    CellPair cell = MaNGOS::ComputeCellPair(x, y);
+    return (uint64(grid.y_coord * MAX_NUMBER_OF_GRIDS + grid.x_coord) << 32) | (cell.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + cell.x_coord);
 }
 
 void SpawnManager::Update()
 {
     auto now = m_map.GetCurrentClockTime();
-    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+
+    // pop everything due, skipping nodes left behind by reschedules
+    while (!m_spawnQueue.empty() && m_spawnQueue.front().respawnTime <= now)
     {
-        auto& spawnInfo = *itr;
-        if (spawnInfo.IsUsed() ||
-            (spawnInfo.GetRespawnTime() <= now && spawnInfo.ConstructForMap(m_map)))
-            itr = m_spawns.erase(itr);
-        else
-            ++itr;
+        ScheduledSpawn scheduled = m_spawnQueue.front();
+        std::pop_heap(m_spawnQueue.begin(), m_spawnQueue.end(), std::greater<ScheduledSpawn>());
+        m_spawnQueue.pop_back();
+
+        auto itr = m_spawns.find(scheduled.key);
+        if (itr == m_spawns.end())
+            continue;
+
+        if (itr->second.IsUsed())
+            m_spawns.erase(itr);
+        else if (itr->second.GetRespawnTime() == scheduled.respawnTime)
+            m_dueSpawns.push_back(scheduled.key);
+    }
+
+    if (!m_dueSpawns.empty())
+    {
+        // construct spawns of the same grid cell together so grid and cell lookups stay hot
+        std::vector<std::pair<uint64, uint64>> ordered;
+        ordered.reserve(m_dueSpawns.size());
+        for (uint64 key : m_dueSpawns)
+            ordered.emplace_back(GetCellSortKey(m_spawns.find(key)->second), key);
+        std::sort(ordered.begin(), ordered.end());
+        ordered.erase(std::unique(ordered.begin(), ordered.end()), ordered.end());
+        m_dueSpawns.clear();
+
+        for (auto const& due : ordered)
+        {
+            // construction can add, reschedule or use spawns, look each one up again
+            auto itr = m_spawns.find(due.second);
+            if (itr == m_spawns.end())
+                continue;
+
+            SpawnInfo& spawnInfo = itr->second;
+            if (spawnInfo.IsUsed() || spawnInfo.ConstructForMap(m_map))
+                m_spawns.erase(due.second);
+            else if (spawnInfo.GetRespawnTime() <= now)
+                m_dueSpawns.push_back(due.second);      // failed, retry next tick
+        }
+
+        // a later construction in the loop above can have used and erased a retried spawn
+        for (uint64 key : m_dueSpawns)
+        {
+            auto itr = m_spawns.find(key);
+            if (itr != m_spawns.end() && !itr->second.IsUsed())
+                Schedule(itr->second);
+        }
+        m_dueSpawns.clear();
     }
 
     for (auto& group : m_spawnGroups)
@@ -169,9 +246,17 @@ void SpawnManager::Update()
 
 std::string SpawnManager::GetRespawnList()
 {
-    std::string output = "";
+    std::vector<SpawnInfo const*> spawns;
+    spawns.reserve(m_spawns.size());
     for (auto& data : m_spawns)
+        if (!data.second.IsUsed())
+            spawns.push_back(&data.second);
+    std::sort(spawns.begin(), spawns.end(), [](SpawnInfo const* lhs, SpawnInfo const* rhs) { return *lhs < *rhs; });
+
+    std::string output = "";
+    for (SpawnInfo const* spawnInfo : spawns)
     {
+        SpawnInfo const& data = *spawnInfo;
         output += "DBGuid: " + std::to_string(data.GetDbGuid()) + "HighGuid: " + (data.GetHighGuid() == HIGHGUID_UNIT ? "Creature" : "GameObject") + "Respawn Time ";
         auto diff = (data.GetRespawnTime() - m_map.GetCurrentClockTime()).count();
         if (auto hours = diff / (HOUR * IN_MILLISECONDS))
@@ -38,6 +38,7 @@ class SpawnInfo
         HighGuid GetHighGuid() const { return m_high; }
         void SetUsed() { m_used = true; }
         bool IsUsed() const { return m_inUse || m_used; }
+        void Reschedule(TimePoint const& time) { m_respawnTime = time; m_used = false; }
     private:
         TimePoint m_respawnTime;
         uint32 m_dbguid;
@@ -71,9 +72,27 @@ class SpawnManager
 
         void RespawnSpawnGroupsInVicinity(Position pos, float range);
     private:
+        // respawn queue node, stale when the spawn was rescheduled or removed meanwhile
+        struct ScheduledSpawn
+        {
+            TimePoint respawnTime;
+            uint64 key;
+
+            bool operator>(ScheduledSpawn const& other) const { return respawnTime > other.respawnTime; }
+        };
+
+        static uint64 MakeSpawnKey(HighGuid high, uint32 dbguid) { return (uint64(high) << 32) | dbguid; }
+
+        void AddSpawn(uint32 respawnDelay, uint32 dbguid, HighGuid high);
+        void RespawnSpawn(uint32 dbguid, HighGuid high, uint32 respawnDelay);
+        void Schedule(SpawnInfo const& spawnInfo);
+        uint64 GetCellSortKey(SpawnInfo const& spawnInfo) const;
+
         Map& m_map;
 
-        std::vector<SpawnInfo> m_spawns; // must only be erased from in Update
+        std::unordered_map<uint64, SpawnInfo> m_spawns;    // one pending spawn per db guid, must only be erased from in Update and Respawn*
+        std::vector<ScheduledSpawn> m_spawnQueue;           // min heap on respawn time
+        std::vector<uint64> m_dueSpawns;                    // reused by Update
         std::map<uint32, SpawnGroup*> m_spawnGroups;
 };
 
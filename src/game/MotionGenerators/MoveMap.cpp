@@ -115,6 +115,57 @@ namespace MMAP
         return false;
     }
 
+    // ######################## PolyPathCache ########################
+    bool PolyPathCache::Find(PolyPathKey const& key, dtPolyRef* path, uint32& pathSize)
+    {
+        auto itr = m_index.find(key);
+        if (itr == m_index.end())
+        {
+            ++m_misses;
+            return false;
+        }
+
+        // move to front - most recently used
+        m_entries.splice(m_entries.begin(), m_entries, itr->second);
+
+        std::vector<dtPolyRef> const& polys = itr->second->second;
+        pathSize = uint32(polys.size());
+        memcpy(path, polys.data(), pathSize * sizeof(dtPolyRef));
+        ++m_hits;
+        return true;
+    }
+
+    void PolyPathCache::Insert(PolyPathKey const& key, dtPolyRef const* path, uint32 pathSize)
+    {
+        uint32 maxEntries = sWorld.getConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE);
+        if (!maxEntries)
+            return;
+
+        auto itr = m_index.find(key);
+        if (itr != m_index.end())
+        {
+            itr->second->second.assign(path, path + pathSize);
+            m_entries.splice(m_entries.begin(), m_entries, itr->second);
+            return;
+        }
+
+        // evict least recently used entries
+        while (m_entries.size() >= maxEntries)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front(key, std::vector<dtPolyRef>(path, path + pathSize));
+        m_index.emplace(key, m_entries.begin());
+    }
+
+    void PolyPathCache::Clear()
+    {
+        m_entries.clear();
+        m_index.clear();
+    }
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
@@ -277,6 +328,7 @@ namespace MMAP
         }
 
         mmapData->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        mmapData->pathCache.Clear();
         ++m_loadedTiles;
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded into %03i[%02i,%02i]", fileName, mapId, header->x, header->y);
         return true;
@@ -391,6 +443,7 @@ namespace MMAP
         else
         {
             mmapData->mmapLoadedTiles.erase(packedGridPos);
+            mmapData->pathCache.Clear();
             --m_loadedTiles;
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -475,6 +528,15 @@ namespace MMAP
         return (*itr).second->navMesh;
     }
 
+    PolyPathCache* MMapManager::GetPolyPathCache(uint32 mapId, uint32 instanceId)
+    {
+        auto itr = m_loadedMMaps.find(packInstanceId(mapId, instanceId));
+        if (itr == m_loadedMMaps.end())
+            return nullptr;
+
+        return &(*itr).second->pathCache;
+    }
+
     dtNavMesh const* MMapManager::GetGONavMesh(uint32 mapId)
     {
         if (m_loadedModels.find(mapId) == m_loadedModels.end())
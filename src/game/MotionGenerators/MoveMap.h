@@ -24,6 +24,7 @@
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
 
+#include <list>
 #include <memory>
 #include <mutex>
 
@@ -47,6 +48,60 @@ namespace MMAP
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
     typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshGOQuerySet;
 
+    // key of a cached poly corridor - filter flags are part of the key since they change the search result
+    struct PolyPathKey
+    {
+        dtPolyRef startPoly;
+        dtPolyRef endPoly;
+        uint16 includeFlags;
+        uint16 excludeFlags;
+        uint32 maxPathSize;
+
+        bool operator==(PolyPathKey const& other) const
+        {
+            return startPoly == other.startPoly && endPoly == other.endPoly && includeFlags == other.includeFlags &&
+                   excludeFlags == other.excludeFlags && maxPathSize == other.maxPathSize;
+        }
+    };
+
+    struct PolyPathKeyHash
+    {
+        std::size_t operator()(PolyPathKey const& key) const
+        {
+            uint64 flags = (uint64(key.includeFlags) << 48) | (uint64(key.excludeFlags) << 32) | key.maxPathSize;
+            std::size_t seed = std::hash<uint64>()(uint64(key.startPoly));
+            seed ^= std::hash<uint64>()(uint64(key.endPoly)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= std::hash<uint64>()(flags) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
+    // bounded LRU cache of findPath() results, shared by all path finders of one map instance
+    // units chasing the same target from the same polygon reuse the corridor instead of running A* again
+    // not thread safe - only ever used from the thread updating the owning map instance
+    class PolyPathCache
+    {
+        public:
+            PolyPathCache() : m_hits(0), m_misses(0) {}
+
+            bool Find(PolyPathKey const& key, dtPolyRef* path, uint32& pathSize);
+            void Insert(PolyPathKey const& key, dtPolyRef const* path, uint32 pathSize);
+            void Clear();
+
+            uint32 GetSize() const { return uint32(m_entries.size()); }
+            uint64 GetHits() const { return m_hits; }
+            uint64 GetMisses() const { return m_misses; }
+
+        private:
+            typedef std::pair<PolyPathKey, std::vector<dtPolyRef>> CacheEntry;
+            typedef std::list<CacheEntry> CacheList;
+
+            CacheList m_entries;                                                        // most recently used first
+            std::unordered_map<PolyPathKey, CacheList::iterator, PolyPathKeyHash> m_index;
+            uint64 m_hits;
+            uint64 m_misses;
+    };
+
     // dummy struct to hold map's mmap data
     struct MMapData
     {
@@ -65,6 +120,7 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        PolyPathCache pathCache;            // corridors found on this navmesh, dropped on every tile change
     };
 
     struct MMapGOData
@@ -108,6 +164,7 @@ namespace MMAP
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
             dtNavMesh const* GetNavMesh(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetGONavMesh(uint32 displayId);
+            PolyPathCache* GetPolyPathCache(uint32 mapId, uint32 instanceId);
 
             uint32 getLoadedTilesCount() const { return m_loadedTiles; }
             uint32 getLoadedMapsCount() const { return m_loadedMMaps.size(); }
@@ -37,7 +37,7 @@ PathFinder::PathFinder(const Unit* owner, bool ignoreNormalization) :
     m_pointPathLimit(MAX_POINT_PATH_LENGTH), // TODO: Fix legitimate long paths
     m_cachedPoints(m_pointPathLimit * VERTEX_SIZE), m_pathPolyRefs(m_pointPathLimit), m_polyLength(0),
     m_smoothPathPolyRefs(m_pointPathLimit), m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr),
-    m_defaultMapId(m_sourceUnit->GetMapId()), m_ignoreNormalization(ignoreNormalization)
+    m_defaultNavMeshQuery(nullptr), m_pathCache(nullptr), m_defaultMapId(m_sourceUnit->GetMapId()), m_ignoreNormalization(ignoreNormalization)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
@@ -45,6 +45,7 @@ PathFinder::PathFinder(const Unit* owner, bool ignoreNormalization) :
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
+        m_pathCache = mmap->GetPolyPathCache(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
     }
 
     createFilter();
@@ -65,7 +66,10 @@ void PathFinder::SetCurrentNavMesh()
         else
         {
             if (m_defaultMapId != m_sourceUnit->GetMapId())
+            {
                 m_defaultNavMeshQuery = mmap->GetNavMeshQuery(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
+                m_pathCache = mmap->GetPolyPathCache(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
+            }
 
             m_navMeshQuery = m_defaultNavMeshQuery;
         }
@@ -457,15 +461,28 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
         if (!m_straightLine)
         {
-            dtResult = m_navMeshQuery->findPath(
-                    startPoly,          // start polygon
-                    endPoly,            // end polygon
-                    startPoint,         // start position
-                    endPoint,           // end position
-                    &m_filter,          // polygon search filter
-                    m_pathPolyRefs.data(), // [out] path
-                    (int*)&m_polyLength,
-                    m_pointPathLimit);   // max number of polygons in output path
+            // corridor between two polygons barely depends on the exact positions inside them
+            // so units chasing the same target from the same polygon can share it (transport meshes are per thread, not cached)
+            MMAP::PolyPathCache* pathCache = m_navMeshQuery == m_defaultNavMeshQuery ? m_pathCache : nullptr;
+            MMAP::PolyPathKey cacheKey = { startPoly, endPoly, m_filter.getIncludeFlags(), m_filter.getExcludeFlags(), m_pointPathLimit };
+
+            if (pathCache && pathCache->Find(cacheKey, m_pathPolyRefs.data(), m_polyLength))
+                dtResult = DT_SUCCESS;
+            else
+            {
+                dtResult = m_navMeshQuery->findPath(
+                        startPoly,          // start polygon
+                        endPoly,            // end polygon
+                        startPoint,         // start position
+                        endPoint,           // end position
+                        &m_filter,          // polygon search filter
+                        m_pathPolyRefs.data(), // [out] path
+                        (int*)&m_polyLength,
+                        m_pointPathLimit);   // max number of polygons in output path
+
+                if (pathCache && m_polyLength && dtStatusSucceed(dtResult))
+                    pathCache->Insert(cacheKey, m_pathPolyRefs.data(), m_polyLength);
+            }
         }
         else
         {
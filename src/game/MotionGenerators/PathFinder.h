@@ -31,6 +31,11 @@ using Movement::PointsArray;
 
 class Unit;
 
+namespace MMAP
+{
+    class PolyPathCache;
+}
+
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
@@ -114,6 +119,7 @@ class PathFinder
         const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
 
         const dtNavMeshQuery*   m_defaultNavMeshQuery;     // the nav mesh query used to find the path
+        MMAP::PolyPathCache*    m_pathCache;               // corridors shared with other units of the same map instance
         uint32                  m_defaultMapId;
 
         bool                    m_ignoreNormalization;
@@ -1542,6 +1542,23 @@ void PlayerbotAI::SendOrders(Player& /*player*/)
 }
 
 // handle outgoing packets the server would send to the client
+std::vector<uint16> const& PlayerbotAI::GetOutgoingPacketInterest()
+{
+    // keep in sync with the cases handled below
+    static std::vector<uint16> const opcodes =
+    {
+        SMSG_DUEL_WINNER, SMSG_DUEL_COMPLETE, SMSG_DUEL_OUTOFBOUNDS, SMSG_DUEL_REQUESTED,
+        SMSG_PET_TAME_FAILURE, SMSG_BUY_FAILED, SMSG_AUCTION_COMMAND_RESULT, SMSG_INVENTORY_CHANGE_FAILURE,
+        SMSG_CAST_RESULT, SMSG_SPELL_FAILURE, SMSG_MOVE_SET_CAN_FLY, SMSG_MOVE_UNSET_CAN_FLY,
+        SMSG_MESSAGECHAT, SMSG_GROUP_SET_LEADER, SMSG_PARTY_COMMAND_RESULT, SMSG_GROUP_INVITE,
+        SMSG_GUILD_INVITE, SMSG_TRADE_STATUS, SMSG_SPELL_START, SMSG_SPELL_GO,
+        SMSG_RESURRECT_REQUEST, SMSG_LOOT_RESPONSE, SMSG_LOOT_RELEASE_RESPONSE, SMSG_LOOT_ROLL_WON,
+        SMSG_PARTYKILLLOG, SMSG_ITEM_PUSH_RESULT, MSG_MOVE_TELEPORT_ACK, SMSG_TRANSFER_PENDING,
+        SMSG_NEW_WORLD
+    };
+    return opcodes;
+}
+
 void PlayerbotAI::HandleBotOutgoingPacket(const WorldPacket& packet)
 {
     switch (packet.GetOpcode())
@@ -1736,6 +1736,8 @@ class PlayerbotAI
         // Since there is no client at the other end, the packets are dropped of course.
         // For a list of opcodes that can be caught see Opcodes.cpp (SMSG_* opcodes only)
         void HandleBotOutgoingPacket(const WorldPacket& packet);
+        // Opcodes HandleBotOutgoingPacket reacts to, bot sessions get nothing else
+        static std::vector<uint16> const& GetOutgoingPacketInterest();
 
         // Returns what kind of situation we are in so the ai can react accordingly
         ScenarioType GetScenarioType() { return m_ScenarioType; }
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/OpcodeProfiler.h"
+#include "Server/Opcodes.h"
+#include "World/World.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(OpcodeProfiler);
+
+namespace
+{
+    uint32 GetLatencyBucket(uint32 microseconds)
+    {
+        uint32 bucket = 0;
+        while (bucket < OPCODE_LATENCY_BUCKETS - 1 && microseconds >= (1u << bucket))
+            ++bucket;
+        return bucket;
+    }
+
+    uint32 GetPercentile(OpcodeLatencyStats const& stats, uint32 samples, uint32 maxTime, uint32 percent)
+    {
+        uint64 wanted = (uint64(samples) * percent + 99) / 100;
+        uint64 counted = 0;
+        for (uint32 i = 0; i < OPCODE_LATENCY_BUCKETS - 1; ++i)
+        {
+            counted += stats.buckets[i];
+            if (counted >= wanted)
+                return std::min(1u << i, maxTime);
+        }
+        // the last bucket has no upper bound, the slowest sample is the only honest one
+        return maxTime;
+    }
+}
+
+OpcodeProfiler::OpcodeProfiler() : m_stats(NUM_MSG_TYPES)
+{
+}
+
+bool OpcodeProfiler::ShouldSample() const
+{
+    uint32 sampleRate = sWorld.getConfig(CONFIG_UINT32_OPCODE_PROFILER_SAMPLE_RATE);
+    if (!sampleRate)
+        return false;
+
+    static thread_local uint32 handlerCalls = 0;
+    if (++handlerCalls < sampleRate)
+        return false;
+
+    handlerCalls = 0;
+    return true;
+}
+
+void OpcodeProfiler::AddSample(uint16 opcode, uint32 microseconds)
+{
+    if (opcode >= m_stats.size())
+        return;
+
+    OpcodeLatencyStats& stats = m_stats[opcode];
+    ++stats.buckets[GetLatencyBucket(microseconds)];
+    ++stats.samples;
+    stats.totalTime += microseconds;
+
+    uint32 maxTime = stats.maxTime;
+    while (microseconds > maxTime && !stats.maxTime.compare_exchange_weak(maxTime, microseconds)) {}
+}
+
+std::vector<OpcodeLatencyReport> OpcodeProfiler::GetReport() const
+{
+    std::vector<OpcodeLatencyReport> report;
+    for (uint32 opcode = 0; opcode < m_stats.size(); ++opcode)
+    {
+        OpcodeLatencyStats const& stats = m_stats[opcode];
+        uint32 samples = stats.samples;
+        if (!samples)
+            continue;
+
+        uint32 maxTime = stats.maxTime;
+        report.push_back({ uint16(opcode), samples, maxTime, stats.totalTime, GetPercentile(stats, samples, maxTime, 50), GetPercentile(stats, samples, maxTime, 99) });
+    }
+
+    std::sort(report.begin(), report.end(), [](OpcodeLatencyReport const& a, OpcodeLatencyReport const& b) { return a.totalTime > b.totalTime; });
+    return report;
+}
+
+void OpcodeProfiler::Reset()
+{
+    for (OpcodeLatencyStats& stats : m_stats)
+    {
+        for (std::atomic<uint32>& bucket : stats.buckets)
+            bucket = 0;
+        stats.samples = 0;
+        stats.maxTime = 0;
+        stats.totalTime = 0;
+    }
+}
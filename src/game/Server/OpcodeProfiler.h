@@ -0,0 +1,69 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef __MANGOS_OPCODEPROFILER_H
+#define __MANGOS_OPCODEPROFILER_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <atomic>
+#include <vector>
+
+#define OPCODE_LATENCY_BUCKETS 24                           // bucket n counts handlers that took less than 2^n microseconds, the last one everything from 2^22 (~4s) up
+
+struct OpcodeLatencyStats
+{
+    std::atomic<uint32> buckets[OPCODE_LATENCY_BUCKETS];
+    std::atomic<uint32> samples;
+    std::atomic<uint32> maxTime;                            // microseconds
+    std::atomic<uint64> totalTime;                          // microseconds
+};
+
+struct OpcodeLatencyReport
+{
+    uint16 opcode;
+    uint32 samples;
+    uint32 maxTime;
+    uint64 totalTime;
+    uint32 p50;                                             // upper bound of the bucket holding the percentile, never above maxTime
+    uint32 p99;
+};
+
+// Sampled latency histograms of the client opcode handlers
+// Handlers run on the world thread and on map threads, so everything here is lock free
+class OpcodeProfiler
+{
+    public:
+        OpcodeProfiler();
+
+        // true for every n-th handler call of the calling thread, n being OpcodeProfiler.SampleRate
+        bool ShouldSample() const;
+        void AddSample(uint16 opcode, uint32 microseconds);
+
+        // opcodes with samples, most total time first
+        std::vector<OpcodeLatencyReport> GetReport() const;
+        void Reset();
+
+    private:
+        std::vector<OpcodeLatencyStats> m_stats;
+};
+
+#define sOpcodeProfiler MaNGOS::Singleton<OpcodeProfiler>::Instance()
+
+#endif
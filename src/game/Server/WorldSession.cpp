@@ -41,6 +41,7 @@
 #include "GMTickets/GMTicketMgr.h"
 #include "Loot/LootMgr.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Server/OpcodeProfiler.h"
 
 #include <boost/asio/ip/address_v4.hpp>
 
@@ -101,7 +102,11 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetStorageLocaleIndexFor(locale)),
     m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED), m_sessionState(WORLD_SESSION_STATE_CREATED),
     m_timeSyncClockDeltaQueue(6), m_timeSyncClockDelta(0), m_pendingTimeSyncRequests(), m_timeSyncNextCounter(0), m_timeSyncTimer(0),
-    m_requestSocket(nullptr), m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter) {}
+    m_requestSocket(nullptr), m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter), m_handlerTime(0), m_recentHandlerSampleIndex(0)
+{
+    for (auto& sample : m_recentHandlerSamples)
+        sample = 0;
+}
 
 /// WorldSession destructor
 WorldSession::~WorldSession()
@@ -199,8 +204,19 @@ void WorldSession::SetExpansion(uint8 expansion)
 }
 
 /// Send a packet to the client
+void WorldSession::SetOpcodeInterest(std::vector<uint16> const& opcodes)
+{
+    m_opcodeInterest.assign(NUM_MSG_TYPES, false);
+    for (uint16 opcode : opcodes)
+        if (opcode < NUM_MSG_TYPES)
+            m_opcodeInterest[opcode] = true;
+}
+
 void WorldSession::SendPacket(WorldPacket const& packet) const
 {
+    if (!IsInterestedIn(packet.GetOpcode()))
+        return;
+
 #ifdef BUILD_PLAYERBOT
     // Send packet to bot AI
     if (GetPlayer())
@@ -684,6 +700,7 @@ void WorldSession::LogoutPlayer()
             }
 
             guild->BroadcastEvent(GE_SIGNED_OFF, _player->GetObjectGuid(), _player->GetName());
+            guild->MemberLoggedOut(_player->GetObjectGuid());
         }
 
         ///- Remove pet
@@ -1171,6 +1188,9 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
     if (_player)
         _player->SetCanDelayTeleport(true);
 
+    bool profiled = sOpcodeProfiler.ShouldSample();
+    std::chrono::steady_clock::time_point handlerStart = profiled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
     try
     {
         (this->*opHandle.handler)(packet);
@@ -1180,6 +1200,13 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
         ProcessByteBufferException(packet);
     }
 
+    if (profiled)
+    {
+        uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handlerStart).count());
+        sOpcodeProfiler.AddSample(packet.GetOpcode(), elapsed);
+        AddHandlerSample(packet.GetOpcode(), elapsed);
+    }
+
     if (_player)
     {
         // can be not set in fact for login opcode, but this not create porblems.
@@ -1195,6 +1222,26 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
         LogUnprocessedTail(packet);
 }
 
+void WorldSession::AddHandlerSample(uint16 opcode, uint32 microseconds)
+{
+    m_handlerTime += uint64(microseconds) * std::max(sWorld.getConfig(CONFIG_UINT32_OPCODE_PROFILER_SAMPLE_RATE), 1u);
+    uint32 index = m_recentHandlerSampleIndex++ % WORLD_SESSION_HANDLER_SAMPLES;
+    m_recentHandlerSamples[index] = (uint64(opcode) << 32) | microseconds;
+}
+
+std::vector<std::pair<uint16, uint32>> WorldSession::GetRecentHandlerSamples() const
+{
+    std::vector<std::pair<uint16, uint32>> samples;
+    uint32 next = m_recentHandlerSampleIndex;
+    for (uint32 i = 0; i < WORLD_SESSION_HANDLER_SAMPLES; ++i)
+    {
+        uint64 sample = m_recentHandlerSamples[(next + i) % WORLD_SESSION_HANDLER_SAMPLES];
+        if (sample)
+            samples.emplace_back(uint16(sample >> 32), uint32(sample));
+    }
+    return samples;
+}
+
 void WorldSession::SendPlaySpellVisual(ObjectGuid guid, uint32 spellArtKit) const
 {
     WorldPacket data(SMSG_PLAY_SPELL_VISUAL, 8 + 4);        // visual effect on guid
@@ -33,6 +33,7 @@
 #include "Multithreading/Messager.h"
 #include "LFG/LFGDefines.h"
 
+#include <atomic>
 #include <deque>
 #include <mutex>
 #include <memory>
@@ -177,6 +178,8 @@ enum WorldSessionState
 
 #define MAX_DECLINED_NAME_CASES 5
 
+#define WORLD_SESSION_HANDLER_SAMPLES 16                    // sampled handler calls kept per session
+
 struct DeclinedName
 {
     std::string name[MAX_DECLINED_NAME_CASES];
@@ -265,6 +268,17 @@ class WorldSession
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
         void SendPacket(WorldPacket const& packet) const;
+
+        // limits the server opcodes delivered to this session, meant for sessions without a client
+        // producers check IsInterestedIn before building packets nobody would read
+        void SetOpcodeInterest(std::vector<uint16> const& opcodes);
+        bool IsInterestedIn(uint16 opcode) const { return m_opcodeInterest.empty() || (opcode < m_opcodeInterest.size() && m_opcodeInterest[opcode]); }
+
+        // packet handler time sampled by the opcode profiler, scaled up by the sample rate (microseconds)
+        uint64 GetHandlerTime() const { return m_handlerTime; }
+        // last sampled handler calls as opcode and microseconds, oldest first
+        std::vector<std::pair<uint16, uint32>> GetRecentHandlerSamples() const;
+
         void SendExpectedSpamRecords();
         void SendMotd();
         void SendOfflineNameQueryResponses();
@@ -1021,6 +1035,7 @@ class WorldSession
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
         void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet);
+        void AddHandlerSample(uint16 opcode, uint32 microseconds);
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket const& packet, const char* reason) const;
@@ -1032,6 +1047,7 @@ class WorldSession
         Player* _player;
         std::shared_ptr<WorldSocket> m_Socket;              // socket pointer is owned by the network thread which created it
         std::shared_ptr<WorldSocket> m_requestSocket;       // a new socket for this session is requested (double connection)
+        std::vector<bool> m_opcodeInterest;                 // empty - all opcodes
         std::string m_localAddress;
         WorldSessionState m_sessionState;                   // this session state
 
@@ -1086,6 +1102,11 @@ class WorldSession
         uint32 m_recruitingFriendId;
         bool m_isRecruiter;
 
+        // time spent in opcode handlers, handlers run on world and map threads
+        std::atomic<uint64> m_handlerTime;
+        std::atomic<uint64> m_recentHandlerSamples[WORLD_SESSION_HANDLER_SAMPLES]; // opcode << 32 | microseconds
+        std::atomic<uint32> m_recentHandlerSampleIndex;
+
         // Thread safety mechanisms
         std::mutex m_recvQueueLock;
         std::mutex m_recvQueueMapLock;
@@ -42,6 +42,10 @@
 #include <boost/asio.hpp>
 #include <utility>
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
 #if defined( __GNUC__ )
 #pragma pack(1)
 #else
@@ -113,7 +117,7 @@ std::deque<uint32> WorldSocket::GetIncOpcodeHistory()
 }
 
 WorldSocket::WorldSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler) : Socket(service, std::move(closeHandler)), m_lastPingTime(std::chrono::system_clock::time_point::min()), m_overSpeedPings(0), m_existingHeader(),
-    m_useExistingHeader(false), m_session(nullptr), m_seed(urand()), m_loggingPackets(false)
+    m_useExistingHeader(false), m_session(nullptr), m_seed(urand()), m_authPending(false), m_loggingPackets(false)
 {
 }
 
@@ -256,7 +260,7 @@ bool WorldSocket::ProcessIncomingData()
         switch (opcode)
         {
             case CMSG_AUTH_SESSION:
-                if (m_session)
+                if (m_session || m_authPending)
                 {
                     sLog.outError("WorldSocket::ProcessIncomingData: Player send CMSG_AUTH_SESSION again");
                     return false;
@@ -314,6 +318,26 @@ bool WorldSocket::ProcessIncomingData()
     return true;
 }
 
+struct WorldSocket::AuthSessionData
+{
+    explicit AuthSessionData(WorldPacket const& recvPacket) : clientBuild(0), clientSeed(0), digest(), packet(recvPacket), banned(false) {}
+
+    uint32 clientBuild;
+    uint32 clientSeed;
+    uint8 digest[20];
+    std::string account;
+    WorldPacket packet;
+
+    // filled on the login database delay thread
+    std::unique_ptr<QueryResult> accountResult;
+    std::unique_ptr<QueryResult> rafResult;
+    bool banned;
+
+    std::chrono::steady_clock::time_point queuedTime;
+    std::chrono::steady_clock::time_point lookupStartTime;
+    std::chrono::steady_clock::time_point lookupEndTime;
+};
+
 bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
 {
     // NOTE: ATM the socket is singlethread, have this in mind ...
@@ -321,10 +345,7 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     uint32 clientSeed;
     uint32 ClientBuild;
     uint32 unk2;
-    LocaleConstant locale;
-    std::string account, os;
-    Sha1Hash sha1;
-    BigNumber v, s, g, N, K;
+    std::string account;
     WorldPacket packet;
 
     // Read the content of the packet
@@ -360,25 +381,93 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     std::string safe_account = account; // Duplicate, else will screw the SHA hash verification below
     LoginDatabase.escape_string(safe_account);
     // No SQL injection, username escaped.
+    std::string accountQuery = "SELECT "
+                               "a.id, "                    //0
+                               "gmlevel, "                 //1
+                               "sessionkey, "              //2
+                               "lockedIp, "                //3
+                               "locked, "                  //4
+                               "v, "                       //5
+                               "s, "                       //6
+                               "expansion, "               //7
+                               "mutetime, "                //8
+                               "locale, "                  //9
+                               "os, "                      //10
+                               "flags, "                   //11
+                               "platform "                 //12
+                               "FROM account a "
+                               "WHERE username = '" + safe_account + "'";
+
+    // addon info is read from the packet copy after the lookup
+    std::shared_ptr<AuthSessionData> data = std::make_shared<AuthSessionData>(recvPacket);
+    data->clientBuild = ClientBuild;
+    data->clientSeed = clientSeed;
+    memcpy(data->digest, digest, sizeof(digest));
+    data->account = account;
+    data->queuedTime = std::chrono::steady_clock::now();
+
+    // lookups run on the login database delay thread, the network thread keeps serving other sockets meanwhile
+    // the handshake continues in HandleAuthSessionResult on this socket's network thread
+    std::shared_ptr<WorldSocket> self = shared<WorldSocket>();
+    std::string const address = GetRemoteAddress();
+    bool const queued = LoginDatabase.AsyncTask([self, data, address, accountQuery](SqlConnection* conn)
+    {
+        data->lookupStartTime = std::chrono::steady_clock::now();
+
+        data->accountResult.reset(conn->Query(accountQuery.c_str()));
+        if (data->accountResult)
+        {
+            std::string const id = std::to_string((*data->accountResult)[0].GetUInt32());
 
-    QueryResult* result =
-        LoginDatabase.PQuery("SELECT "
-                             "a.id, "                    //0
-                             "gmlevel, "                 //1
-                             "sessionkey, "              //2
-                             "lockedIp, "                //3
-                             "locked, "                  //4
-                             "v, "                       //5
-                             "s, "                       //6
-                             "expansion, "               //7
-                             "mutetime, "                //8
-                             "locale, "                  //9
-                             "os, "                      //10
-                             "flags, "                   //11
-                             "platform "                 //12
-                             "FROM account a "
-                             "WHERE username = '%s'",
-                             safe_account.c_str());
+            // Re-check account ban (same check as in realmd)
+            std::unique_ptr<QueryResult> banResult(conn->Query(("SELECT 1 FROM account_banned WHERE account_id = " + id + " AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)"
+                                                                "UNION "
+                                                                "SELECT 1 FROM ip_banned WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '" + address + "'").c_str()));
+            data->banned = banResult != nullptr;
+
+            if (!data->banned)
+                data->rafResult.reset(conn->Query(("SELECT referrer, referred FROM account_raf WHERE referrer=" + id + " OR referred=" + id).c_str()));
+        }
+
+        data->lookupEndTime = std::chrono::steady_clock::now();
+
+        self->Post([self, data]()
+        {
+            self->m_authPending = false;
+            if (!self->IsClosed() && !self->HandleAuthSessionResult(*data))
+                self->Close();
+        });
+    });
+
+    if (!queued)
+        return false;
+
+    m_authPending = true;
+    return true;
+}
+
+bool WorldSocket::HandleAuthSessionResult(AuthSessionData& data)
+{
+#ifdef BUILD_METRICS
+    {
+        auto const now = std::chrono::steady_clock::now();
+        metric::measurement meas("worldsocket.auth");
+        meas.add_field("queue_us", std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(data.lookupStartTime - data.queuedTime).count()));
+        meas.add_field("lookup_us", std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(data.lookupEndTime - data.lookupStartTime).count()));
+        meas.add_field("resume_us", std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(now - data.lookupEndTime).count()));
+    }
+#endif
+
+    uint8 const* digest = data.digest;
+    uint32 const clientSeed = data.clientSeed;
+    uint32 const ClientBuild = data.clientBuild;
+    std::string const& account = data.account;
+    WorldPacket& recvPacket = data.packet;
+    QueryResult* result = data.accountResult.get();
+    LocaleConstant locale;
+    std::string os;
+    BigNumber v, s, g, N, K;
+    WorldPacket packet;
 
     // Stop if the account is not found
     if (!result)
@@ -420,7 +509,6 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
             packet << uint8(AUTH_FAILED);
             SendPacket(packet);
 
-            delete result;
             BASIC_LOG("WorldSocket::HandleAuthSession: Sent Auth Response (Account IP differs).");
             return false;
         }
@@ -451,23 +539,12 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     uint32 accountFlags = fields[11].GetUInt32();
 	std::string platform = fields[12].GetString();
 
-    delete result;
-
-    // Re-check account ban (same check as in realmd)
-    QueryResult* banresult =
-        LoginDatabase.PQuery("SELECT 1 FROM account_banned WHERE account_id = %u AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)"
-                             "UNION "
-                             "SELECT 1 FROM ip_banned WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'",
-                             id, GetRemoteAddress().c_str());
-
-    if (banresult) // if account banned
+    if (data.banned) // if account banned
     {
         packet.Initialize(SMSG_AUTH_RESPONSE, 1);
         packet << uint8(AUTH_BANNED);
         SendPacket(packet);
 
-        delete banresult;
-
         sLog.outError("WorldSocket::HandleAuthSession: Sent Auth Response (Account banned).");
         return false;
     }
@@ -598,20 +675,17 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     {
         uint32 otherRaf = 0;
         bool isRecruiter = false;
+        if (QueryResult* rafResult = data.rafResult.get())
         {
-            std::unique_ptr<QueryResult> result(LoginDatabase.PQuery("SELECT referrer, referred FROM account_raf WHERE referrer=%u OR referred=%u", id, id));
-            if (result)
+            Field* fields = rafResult->Fetch();
+            uint32 recruiter = fields[0].GetUInt32();
+            if (id == recruiter)
             {
-                Field* fields = result->Fetch();
-                uint32 recruiter = fields[0].GetUInt32();
-                if (id == recruiter)
-                {
-                    isRecruiter = true;
-                    otherRaf = fields[1].GetUInt32();
-                }
-                else
-                    otherRaf = recruiter;
+                isRecruiter = true;
+                otherRaf = fields[1].GetUInt32();
             }
+            else
+                otherRaf = recruiter;
         }
 
         // new session
@@ -115,9 +115,18 @@ class WorldSocket : public MaNGOS::Socket
         /// process one incoming packet.
         virtual bool ProcessIncomingData() override;
 
-        /// Called by ProcessIncoming() on CMSG_AUTH_SESSION.
+        /// Called by ProcessIncoming() on CMSG_AUTH_SESSION, queues the account lookups.
         bool HandleAuthSession(WorldPacket& recvPacket);
 
+        /// CMSG_AUTH_SESSION state carried over the async account lookups
+        struct AuthSessionData;
+
+        /// Finishes CMSG_AUTH_SESSION on the network thread once the lookups are done.
+        bool HandleAuthSessionResult(AuthSessionData& data);
+
+        /// Account lookups of CMSG_AUTH_SESSION are in progress
+        bool m_authPending;
+
         /// Called by ProcessIncoming() on CMSG_PING.
         bool HandlePing(WorldPacket& recvPacket);
 
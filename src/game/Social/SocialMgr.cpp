@@ -79,6 +79,11 @@ bool PlayerSocial::AddToSocialList(ObjectGuid friend_guid, bool ignore)
         fi.Flags |= flag;
         m_playerSocialMap[friend_guid.GetCounter()] = fi;
     }
+
+    if (flag & SOCIAL_FLAG_FRIEND)
+        sSocialMgr.AddFriendLister(friend_guid.GetCounter(), m_playerLowGuid);
+    else
+        sSocialMgr.AddIgnoreLister(friend_guid.GetCounter(), m_playerLowGuid);
     return true;
 }
 
@@ -92,6 +97,11 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid friend_guid, bool ignore)
     if (ignore)
         flag = SOCIAL_FLAG_IGNORED;
 
+    if (itr->second.Flags & flag & SOCIAL_FLAG_FRIEND)
+        sSocialMgr.RemoveFriendLister(friend_guid.GetCounter(), m_playerLowGuid);
+    if (itr->second.Flags & flag & SOCIAL_FLAG_IGNORED)
+        sSocialMgr.RemoveIgnoreLister(friend_guid.GetCounter(), m_playerLowGuid);
+
     itr->second.Flags &= ~flag;
     if (itr->second.Flags == 0)
     {
@@ -176,6 +186,61 @@ SocialMgr::~SocialMgr()
 {
 }
 
+void SocialMgr::RemovePlayerSocial(uint32 guid)
+{
+    SocialMap::iterator itr = m_socialMap.find(guid);
+    if (itr == m_socialMap.end())
+        return;
+
+    for (auto& social : itr->second.m_playerSocialMap)
+    {
+        if (social.second.Flags & SOCIAL_FLAG_FRIEND)
+            RemoveFriendLister(social.first, guid);
+        if (social.second.Flags & SOCIAL_FLAG_IGNORED)
+            RemoveIgnoreLister(social.first, guid);
+    }
+
+    m_socialMap.erase(itr);
+}
+
+void SocialMgr::AddFriendLister(uint32 friend_lowguid, uint32 lister_lowguid)
+{
+    m_friendListers[friend_lowguid].insert(lister_lowguid);
+}
+
+void SocialMgr::RemoveFriendLister(uint32 friend_lowguid, uint32 lister_lowguid)
+{
+    FriendListerMap::iterator itr = m_friendListers.find(friend_lowguid);
+    if (itr == m_friendListers.end())
+        return;
+
+    itr->second.erase(lister_lowguid);
+    if (itr->second.empty())
+        m_friendListers.erase(itr);
+}
+
+void SocialMgr::AddIgnoreLister(uint32 ignored_lowguid, uint32 lister_lowguid)
+{
+    m_ignoreListers[ignored_lowguid].insert(lister_lowguid);
+}
+
+void SocialMgr::RemoveIgnoreLister(uint32 ignored_lowguid, uint32 lister_lowguid)
+{
+    FriendListerMap::iterator itr = m_ignoreListers.find(ignored_lowguid);
+    if (itr == m_ignoreListers.end())
+        return;
+
+    itr->second.erase(lister_lowguid);
+    if (itr->second.empty())
+        m_ignoreListers.erase(itr);
+}
+
+std::set<uint32> const* SocialMgr::GetIgnoreListers(ObjectGuid guid) const
+{
+    FriendListerMap::const_iterator itr = m_ignoreListers.find(guid.GetCounter());
+    return itr != m_ignoreListers.end() ? &itr->second : nullptr;
+}
+
 void SocialMgr::GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo& friendInfo) const
 {
     if (!player)
@@ -273,28 +338,30 @@ void SocialMgr::BroadcastToFriendListers(Player* player, WorldPacket const& pack
     AccountTypes gmLevelInWhoList = AccountTypes(sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST));
     bool allowTwoSideWhoList = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
 
-    for (SocialMap::const_iterator itr = m_socialMap.begin(); itr != m_socialMap.end(); ++itr)
+    FriendListerMap::const_iterator listers = m_friendListers.find(guid);
+    if (listers == m_friendListers.end())
+        return;
+
+    for (uint32 listerGuid : listers->second)
     {
-        PlayerSocialMap::const_iterator itr2 = itr->second.m_playerSocialMap.find(guid);
-        if (itr2 != itr->second.m_playerSocialMap.end() && (itr2->second.Flags & SOCIAL_FLAG_FRIEND))
+        Player* pFriend = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, listerGuid));
+
+        // PLAYER see his team only and PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
+        // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
+        if (pFriend && pFriend->IsInWorld() &&
+                (pFriend->GetSession()->GetSecurity() > SEC_PLAYER ||
+                 ((pFriend->GetTeam() == team || allowTwoSideWhoList) && security <= gmLevelInWhoList)) &&
+                player->IsVisibleGloballyFor(pFriend))
         {
-            Player* pFriend = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-
-            // PLAYER see his team only and PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
-            // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
-            if (pFriend && pFriend->IsInWorld() &&
-                    (pFriend->GetSession()->GetSecurity() > SEC_PLAYER ||
-                     ((pFriend->GetTeam() == team || allowTwoSideWhoList) && security <= gmLevelInWhoList)) &&
-                    player->IsVisibleGloballyFor(pFriend))
-            {
-                pFriend->GetSession()->SendPacket(packet);
-            }
+            pFriend->GetSession()->SendPacket(packet);
         }
     }
 }
 
 PlayerSocial* SocialMgr::LoadFromDB(QueryResult* result, ObjectGuid guid)
 {
+    RemovePlayerSocial(guid.GetCounter());                  // drop a stale list and its index entries, if any
+
     PlayerSocial* social = &m_socialMap[guid.GetCounter()];
     social->SetPlayerGuid(guid);
 
@@ -318,6 +385,10 @@ PlayerSocial* SocialMgr::LoadFromDB(QueryResult* result, ObjectGuid guid)
             continue;
 
         social->m_playerSocialMap[friend_guid] = FriendInfo(flags, note);
+        if (flags & SOCIAL_FLAG_FRIEND)
+            AddFriendLister(friend_guid, guid.GetCounter());
+        if (flags & SOCIAL_FLAG_IGNORED)
+            AddIgnoreLister(friend_guid, guid.GetCounter());
 
         if (flags & SOCIAL_FLAG_IGNORED)
             ++ignoreCounter;
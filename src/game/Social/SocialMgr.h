@@ -73,6 +73,7 @@ struct FriendInfo
 
 typedef std::map<uint32, FriendInfo> PlayerSocialMap;
 typedef std::map<uint32, PlayerSocial> SocialMap;
+typedef std::unordered_map<uint32, std::set<uint32> > FriendListerMap;
 
 /// Results of friend related commands
 enum FriendsResult
@@ -137,17 +138,28 @@ class SocialMgr
         SocialMgr();
         ~SocialMgr();
         // Misc
-        void RemovePlayerSocial(uint32 guid) { m_socialMap.erase(guid); }
+        void RemovePlayerSocial(uint32 guid);
 
         void GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo& friendInfo) const;
         // Packet management
         static void MakeFriendStatusPacket(FriendsResult result, uint32 guid, WorldPacket& data);
         void SendFriendStatus(Player* player, FriendsResult result, ObjectGuid friend_guid, bool broadcast);
         void BroadcastToFriendListers(Player* player, WorldPacket const& packet);
+        // loaded players ignoring the given one, nullptr when there are none
+        std::set<uint32> const* GetIgnoreListers(ObjectGuid guid) const;
         // Loading
         PlayerSocial* LoadFromDB(QueryResult* result, ObjectGuid guid);
     private:
+        friend class PlayerSocial;
+
+        void AddFriendLister(uint32 friend_lowguid, uint32 lister_lowguid);
+        void RemoveFriendLister(uint32 friend_lowguid, uint32 lister_lowguid);
+        void AddIgnoreLister(uint32 ignored_lowguid, uint32 lister_lowguid);
+        void RemoveIgnoreLister(uint32 ignored_lowguid, uint32 lister_lowguid);
+
         SocialMap m_socialMap;
+        FriendListerMap m_friendListers;                    // friend -> loaded players having him in their friend list
+        FriendListerMap m_ignoreListers;                    // ignored -> loaded players having him in their ignore list
 };
 
 #define sSocialMgr MaNGOS::Singleton<SocialMgr>::Instance()
@@ -0,0 +1,166 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Social/WhoListIndex.h"
+#include "Entities/Player.h"
+#include "Guilds/GuildMgr.h"
+#include "Util/Util.h"
+
+INSTANTIATE_SINGLETON_1(WhoListIndex);
+
+namespace
+{
+    void ToLowerWide(std::string const& str, std::wstring& lower)
+    {
+        lower.clear();
+        if (Utf8toWStr(str, lower))
+            wstrToLower(lower);
+    }
+
+    void BucketAdd(WhoListIndex::Bucket& bucket, WhoListEntry* entry, size_t& slot)
+    {
+        slot = bucket.size();
+        bucket.push_back(entry);
+    }
+
+    // swap with the last one, bucket order does not matter
+    void BucketRemove(WhoListIndex::Bucket& bucket, size_t slot, size_t WhoListEntry::* slotMember)
+    {
+        WhoListEntry* last = bucket.back();
+        bucket[slot] = last;
+        last->*slotMember = slot;
+        bucket.pop_back();
+    }
+}
+
+WhoListEntry* WhoListIndex::Find(Player* player)
+{
+    auto itr = m_entries.find(player->GetGUIDLow());
+    return itr != m_entries.end() && itr->second.player == player ? &itr->second : nullptr;
+}
+
+void WhoListIndex::LinkLevel(WhoListEntry& entry)
+{
+    BucketAdd(m_levelBuckets[std::min<uint32>(entry.level, STRONG_MAX_LEVEL)], &entry, entry.levelSlot);
+}
+
+void WhoListIndex::UnlinkLevel(WhoListEntry& entry)
+{
+    BucketRemove(m_levelBuckets[std::min<uint32>(entry.level, STRONG_MAX_LEVEL)], entry.levelSlot, &WhoListEntry::levelSlot);
+}
+
+void WhoListIndex::LinkZone(WhoListEntry& entry)
+{
+    BucketAdd(m_zoneBuckets[entry.zoneId], &entry, entry.zoneSlot);
+}
+
+void WhoListIndex::UnlinkZone(WhoListEntry& entry)
+{
+    auto itr = m_zoneBuckets.find(entry.zoneId);
+    BucketRemove(itr->second, entry.zoneSlot, &WhoListEntry::zoneSlot);
+    if (itr->second.empty())
+        m_zoneBuckets.erase(itr);
+}
+
+void WhoListIndex::SetGuild(WhoListEntry& entry, uint32 guildId)
+{
+    entry.guildName = sGuildMgr.GetGuildNameById(guildId);
+    ToLowerWide(entry.guildName, entry.lowerGuildName);
+}
+
+void WhoListIndex::AddPlayer(Player* player)
+{
+    WhoListEntry entry;
+    entry.player = player;
+    entry.name = player->GetName();
+    ToLowerWide(entry.name, entry.lowerName);
+    SetGuild(entry, player->GetGuildId());
+    entry.level = player->GetLevel();
+    entry.zoneId = player->GetZoneId();
+    entry.race = player->getRace();
+    entry.playerClass = player->getClass();
+    entry.gender = player->getGender();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto itr = m_entries.find(player->GetGUIDLow());
+    if (itr != m_entries.end())
+    {
+        UnlinkLevel(itr->second);
+        UnlinkZone(itr->second);
+        itr->second = std::move(entry);
+    }
+    else
+        itr = m_entries.emplace(player->GetGUIDLow(), std::move(entry)).first;
+
+    LinkLevel(itr->second);
+    LinkZone(itr->second);
+}
+
+void WhoListIndex::RemovePlayer(Player* player)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    WhoListEntry* entry = Find(player);
+    if (!entry)
+        return;
+
+    UnlinkLevel(*entry);
+    UnlinkZone(*entry);
+    m_entries.erase(player->GetGUIDLow());
+}
+
+void WhoListIndex::UpdateLevel(Player* player, uint32 level)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    WhoListEntry* entry = Find(player);
+    if (!entry || entry->level == level)
+        return;
+
+    UnlinkLevel(*entry);
+    entry->level = level;
+    LinkLevel(*entry);
+}
+
+void WhoListIndex::UpdateZone(Player* player, uint32 zoneId)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    WhoListEntry* entry = Find(player);
+    if (!entry || entry->zoneId == zoneId)
+        return;
+
+    UnlinkZone(*entry);
+    entry->zoneId = zoneId;
+    LinkZone(*entry);
+}
+
+void WhoListIndex::UpdateGuild(Player* player, uint32 guildId)
+{
+    std::string guildName = sGuildMgr.GetGuildNameById(guildId);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    WhoListEntry* entry = Find(player);
+    if (!entry)
+        return;
+
+    entry->guildName = guildName;
+    ToLowerWide(entry->guildName, entry->lowerGuildName);
+}
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef __MANGOS_WHOLISTINDEX_H
+#define __MANGOS_WHOLISTINDEX_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "Server/DBCEnums.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class Player;
+
+// who list data of one online player, strings are lowercased once here instead of on every query
+// team and security can change while online (gm level, faction change), read them from player when filtering
+struct WhoListEntry
+{
+    Player* player;
+    std::string name;
+    std::wstring lowerName;
+    std::string guildName;
+    std::wstring lowerGuildName;
+    uint32 level;
+    uint32 zoneId;
+    uint8 race;
+    uint8 playerClass;
+    uint8 gender;
+
+    size_t levelSlot;                                       // position in the level bucket
+    size_t zoneSlot;                                        // position in the zone bucket
+};
+
+// Online players bucketed by level and zone for CMSG_WHO
+// Kept up to date from login, logout, level, zone and guild changes, which may come from map threads
+class WhoListIndex
+{
+    public:
+        typedef std::vector<WhoListEntry*> Bucket;
+
+        void AddPlayer(Player* player);
+        void RemovePlayer(Player* player);
+
+        void UpdateLevel(Player* player, uint32 level);
+        void UpdateZone(Player* player, uint32 zoneId);
+        void UpdateGuild(Player* player, uint32 guildId);
+
+        // calls visitor for every indexed player within the level range and, if any given, in one of the zones
+        // stops as soon as visitor returns false
+        template<typename Visitor>
+        void Visit(uint32 levelMin, uint32 levelMax, uint32 const* zoneIds, uint32 zoneCount, Visitor&& visitor) const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            if (levelMax > STRONG_MAX_LEVEL)
+                levelMax = STRONG_MAX_LEVEL;
+
+            if (zoneCount)
+            {
+                // zone filtered queries never touch players elsewhere
+                for (uint32 i = 0; i < zoneCount; ++i)
+                {
+                    // client may repeat a zone
+                    if (std::find(zoneIds, zoneIds + i, zoneIds[i]) != zoneIds + i)
+                        continue;
+
+                    auto itr = m_zoneBuckets.find(zoneIds[i]);
+                    if (itr == m_zoneBuckets.end())
+                        continue;
+
+                    for (WhoListEntry const* entry : itr->second)
+                        if (entry->level >= levelMin && entry->level <= levelMax)
+                            if (!visitor(*entry))
+                                return;
+                }
+                return;
+            }
+
+            for (uint32 level = levelMin; level <= levelMax; ++level)
+                for (WhoListEntry const* entry : m_levelBuckets[level])
+                    if (!visitor(*entry))
+                        return;
+        }
+
+    private:
+        WhoListEntry* Find(Player* player);
+
+        void LinkLevel(WhoListEntry& entry);
+        void UnlinkLevel(WhoListEntry& entry);
+        void LinkZone(WhoListEntry& entry);
+        void UnlinkZone(WhoListEntry& entry);
+
+        static void SetGuild(WhoListEntry& entry, uint32 guildId);
+
+        mutable std::mutex m_lock;
+        std::unordered_map<uint32, WhoListEntry> m_entries;     // by player low guid
+        Bucket m_levelBuckets[STRONG_MAX_LEVEL + 1];
+        std::unordered_map<uint32, Bucket> m_zoneBuckets;
+};
+
+#define sWhoListIndex MaNGOS::Singleton<WhoListIndex>::Instance()
+
+#endif
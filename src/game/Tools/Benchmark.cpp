@@ -0,0 +1,446 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Tools/Benchmark.h"
+#include "Policies/Singleton.h"
+#include "Database/DatabaseEnv.h"
+#include "Server/WorldSession.h"
+#include "Server/SQLStorages.h"
+#include "Entities/Player.h"
+#include "Globals/ObjectMgr.h"
+#include "MotionGenerators/MotionMaster.h"
+#include "World/World.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+INSTANTIATE_SINGLETON_1(BenchmarkMgr);
+
+// logins still pending after this many ms fail the run
+static uint32 const BENCHMARK_LOGIN_TIMEOUT = 2 * MINUTE * IN_MILLISECONDS;
+
+// resident set size in bytes, 0 where it is not available
+static uint64 GetResidentMemory()
+{
+#ifdef __linux__
+    unsigned long long pages = 0, residentPages = 0;
+    if (FILE* statm = fopen("/proc/self/statm", "r"))
+    {
+        if (fscanf(statm, "%llu %llu", &pages, &residentPages) != 2)
+            residentPages = 0;
+        fclose(statm);
+    }
+    return residentPages * uint64(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+BenchmarkMgr::BenchmarkMgr() : m_ticks(0), m_started(false), m_pendingLogins(0), m_loginTime(0), m_startMemory(0), m_peakMemory(0)
+{
+}
+
+uint64 BenchmarkMgr::Now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool BenchmarkMgr::LoadScenario()
+{
+    // without a scenario only the world itself is measured
+    if (m_scenarioFile.empty())
+        return true;
+
+    std::ifstream file(m_scenarioFile);
+    if (!file)
+    {
+        sLog.outError("Benchmark: can not open scenario file %s", m_scenarioFile.c_str());
+        return false;
+    }
+
+    BenchmarkScenario& scenario = m_scenario;
+    std::string line;
+    uint32 lineNumber = 0;
+    bool hasMap = false;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        std::istringstream in(line);
+        std::string key;
+        if (!(in >> key))
+            continue;
+
+        bool valid = true;
+        if (key == "map")
+        {
+            valid = bool(in >> scenario.mapId >> scenario.x >> scenario.y >> scenario.z);
+            hasMap = true;
+        }
+        else if (key == "radius")
+            valid = bool(in >> scenario.radius) && scenario.radius > 0.f;
+        else if (key == "players")
+            valid = bool(in >> scenario.players);
+        else if (key == "first_guid")
+            valid = bool(in >> scenario.firstGuid) && scenario.firstGuid != 0;
+        else if (key == "seed")
+            valid = bool(in >> scenario.seed);
+        else if (key == "max_tick_p99")
+            valid = bool(in >> scenario.maxTickP99);
+        else if (key == "move" || key == "cast" || key == "fight" || key == "chat")
+        {
+            BenchmarkAction action;
+            action.param = 0;
+            action.castTarget = BENCHMARK_CAST_SELF;
+            action.yell = false;
+            valid = bool(in >> action.interval) && action.interval != 0;
+
+            if (key == "move")
+                action.type = BENCHMARK_ACTION_MOVE;
+            else if (key == "cast")
+            {
+                action.type = BENCHMARK_ACTION_CAST;
+                std::string target;
+                valid = valid && bool(in >> action.param >> target) && sSpellTemplate.LookupEntry<SpellEntry>(action.param);
+                if (target == "friend")
+                    action.castTarget = BENCHMARK_CAST_FRIEND;
+                else if (target == "enemy")
+                    action.castTarget = BENCHMARK_CAST_ENEMY;
+                else if (target != "self")
+                    valid = false;
+            }
+            else if (key == "fight")
+            {
+                action.type = BENCHMARK_ACTION_FIGHT;
+                valid = valid && bool(in >> action.param) && ObjectMgr::GetCreatureTemplate(action.param);
+            }
+            else
+            {
+                action.type = BENCHMARK_ACTION_CHAT;
+                std::string mode;
+                valid = valid && bool(in >> mode) && (mode == "say" || mode == "yell");
+                action.yell = mode == "yell";
+                std::getline(in >> std::ws, action.text);
+                valid = valid && !action.text.empty();
+            }
+
+            if (valid)
+                scenario.actions.push_back(action);
+        }
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            sLog.outError("Benchmark: %s:%u: invalid line '%s'", m_scenarioFile.c_str(), lineNumber, line.c_str());
+            return false;
+        }
+    }
+
+    if (scenario.players && (!hasMap || !scenario.firstGuid))
+    {
+        sLog.outError("Benchmark: scenario %s has players but no map or first_guid", m_scenarioFile.c_str());
+        return false;
+    }
+
+    m_random.seed(scenario.seed);
+    return true;
+}
+
+bool BenchmarkMgr::StartLogins()
+{
+    BenchmarkScenario const& scenario = m_scenario;
+    if (!scenario.players)
+        return true;
+
+    uint32 const lastGuid = scenario.firstGuid + scenario.players - 1;
+    QueryResult* result = CharacterDatabase.PQuery("SELECT guid, account FROM characters WHERE guid BETWEEN %u AND %u ORDER BY guid", scenario.firstGuid, lastGuid);
+    uint32 const found = result ? uint32(result->GetRowCount()) : 0;
+    if (found < scenario.players)
+    {
+        sLog.outError("Benchmark: scenario needs %u characters from guid %u, the database has %u. Load src/benchmarks/fixture/characters.sql first",
+                      scenario.players, scenario.firstGuid, found);
+        delete result;
+        return false;
+    }
+
+    // every run starts from the same place, the scenario moves the players apart
+    CharacterDatabase.DirectPExecute("UPDATE characters SET map = %u, position_x = %f, position_y = %f, position_z = %f, orientation = 0, transguid = 0, online = 0 "
+                                     "WHERE guid BETWEEN %u AND %u", scenario.mapId, scenario.x, scenario.y, scenario.z, scenario.firstGuid, lastGuid);
+
+    sLog.outString("Benchmark: logging in %u synthetic players on map %u", scenario.players, scenario.mapId);
+    m_pendingLogins = scenario.players;
+    do
+    {
+        Field* fields = result->Fetch();
+        LoginPlayer(fields[1].GetUInt32(), ObjectGuid(HIGHGUID_PLAYER, fields[0].GetUInt32()));
+    }
+    while (result->NextRow());
+    delete result;
+
+    return true;
+}
+
+void BenchmarkMgr::OnPlayerLogin(WorldSession* session)
+{
+    if (m_pendingLogins)
+        --m_pendingLogins;
+
+    // failed to load, HandlePlayerLogin already logged why
+    if (!session->GetPlayer())
+    {
+        delete session;
+        return;
+    }
+
+    SyntheticPlayer player;
+    player.session = session;
+    // spread the actions of all players over their intervals
+    for (BenchmarkAction const& action : m_scenario.actions)
+        player.nextAction.push_back(std::uniform_int_distribution<uint32>(0, action.interval)(m_random));
+    m_players.push_back(player);
+
+    if (!m_pendingLogins)
+        sLog.outString("Benchmark: %u synthetic players logged in after %u ms", uint32(m_players.size()), m_loginTime);
+}
+
+void BenchmarkMgr::Update(uint32 diff)
+{
+    if (!m_ticks)
+        return;
+
+    if (!m_started)
+    {
+        m_started = true;
+        if (!LoadScenario() || !StartLogins())
+        {
+            m_ticks = 0;
+            sWorld.StopNow(ERROR_EXIT_CODE);
+        }
+        return;
+    }
+
+    if (m_pendingLogins)
+    {
+        m_loginTime += diff;
+        if (m_loginTime > BENCHMARK_LOGIN_TIMEOUT)
+        {
+            sLog.outError("Benchmark: %u synthetic players did not log in after %u ms", m_pendingLogins, m_loginTime);
+            LogoutPlayers();
+            m_ticks = 0;
+            sWorld.StopNow(ERROR_EXIT_CODE);
+        }
+        return;
+    }
+
+    for (SyntheticPlayer& synthetic : m_players)
+    {
+        Player* player = synthetic.session->GetPlayer();
+        if (!player || !player->IsInWorld())
+            continue;
+
+        for (size_t i = 0; i < m_scenario.actions.size(); ++i)
+        {
+            if (synthetic.nextAction[i] > diff)
+            {
+                synthetic.nextAction[i] -= diff;
+                continue;
+            }
+
+            synthetic.nextAction[i] = m_scenario.actions[i].interval;
+            RunAction(player, m_scenario.actions[i]);
+        }
+    }
+}
+
+Player* BenchmarkMgr::GetRandomPlayer(Player* except)
+{
+    if (m_players.size() < 2)
+        return nullptr;
+
+    Player* player = m_players[std::uniform_int_distribution<size_t>(0, m_players.size() - 1)(m_random)].session->GetPlayer();
+    return player != except && player && player->IsInWorld() ? player : nullptr;
+}
+
+void BenchmarkMgr::RunAction(Player* player, BenchmarkAction const& action)
+{
+    if (!player->IsAlive())
+    {
+        player->ResurrectPlayer(1.0f);
+        player->SpawnCorpseBones();
+    }
+
+    switch (action.type)
+    {
+        case BENCHMARK_ACTION_MOVE:
+        {
+            // uniform over the circle around the scenario center
+            float const angle = std::uniform_real_distribution<float>(0.f, 2 * M_PI_F)(m_random);
+            float const dist = m_scenario.radius * sqrt(std::uniform_real_distribution<float>(0.f, 1.f)(m_random));
+            float const x = m_scenario.x + dist * cos(angle);
+            float const y = m_scenario.y + dist * sin(angle);
+            float z = m_scenario.z;
+            player->UpdateAllowedPositionZ(x, y, z);
+            player->GetMotionMaster()->MovePoint(0, x, y, z);
+            break;
+        }
+        case BENCHMARK_ACTION_CAST:
+        {
+            Unit* target = player;
+            if (action.castTarget == BENCHMARK_CAST_FRIEND)
+                target = GetRandomPlayer(player);
+            else if (action.castTarget == BENCHMARK_CAST_ENEMY)
+                target = player->GetVictim();
+
+            if (target)
+                player->CastSpell(target, action.param, TRIGGERED_NONE);
+            break;
+        }
+        case BENCHMARK_ACTION_FIGHT:
+        {
+            if (player->GetVictim())
+                break;
+
+            float x, y, z;
+            player->GetNearPoint(player, x, y, z, 0.f, 3.f, player->GetOrientation());
+            if (Creature* creature = player->SummonCreature(action.param, x, y, z, player->GetOrientation() + M_PI_F, TEMPSPAWN_TIMED_OOC_OR_DEAD_DESPAWN, 30 * IN_MILLISECONDS))
+            {
+                player->SetFacingToObject(creature);
+                player->Attack(creature, true);
+            }
+            break;
+        }
+        case BENCHMARK_ACTION_CHAT:
+            if (action.yell)
+                player->Yell(action.text, LANG_UNIVERSAL);
+            else
+                player->Say(action.text, LANG_UNIVERSAL);
+            break;
+    }
+}
+
+void BenchmarkMgr::LogoutPlayers()
+{
+    for (SyntheticPlayer& synthetic : m_players)
+    {
+        synthetic.session->LogoutPlayer();
+        delete synthetic.session;
+    }
+    m_players.clear();
+}
+
+void BenchmarkMgr::AddTick(PhaseStarts const& phaseStarts, uint64 tickEnd)
+{
+    // the ticks spent logging in the synthetic players are not measured
+    if (!m_ticks || !m_started || m_pendingLogins)
+        return;
+
+    if (m_samples.empty())
+    {
+        m_samples.reserve(m_ticks);
+        m_startMemory = GetResidentMemory();
+        m_peakMemory = m_startMemory;
+        sLog.outString("Benchmark: running %u world ticks", m_ticks);
+    }
+
+    std::array<uint32, MAX_BENCHMARK_PHASES> sample;
+    for (uint32 phase = 0; phase < MAX_BENCHMARK_PHASES; ++phase)
+        sample[phase] = uint32((phase + 1 < MAX_BENCHMARK_PHASES ? phaseStarts[phase + 1] : tickEnd) - phaseStarts[phase]);
+    m_samples.push_back(sample);
+    m_peakMemory = std::max(m_peakMemory, GetResidentMemory());
+
+    if (m_samples.size() >= m_ticks)
+        Finish();
+}
+
+void BenchmarkMgr::Finish()
+{
+    std::vector<uint32> totals;
+    Report(totals);
+
+    LogoutPlayers();
+    m_ticks = 0;
+    m_samples.clear();
+
+    uint32 const p99 = totals[std::min(uint32(totals.size()) - 1, uint32(totals.size()) * 99 / 100)];
+    if (m_scenario.maxTickP99 && p99 > m_scenario.maxTickP99)
+    {
+        sLog.outError("Benchmark: 99th percentile tick took %u us, the scenario allows %u us", p99, m_scenario.maxTickP99);
+        sWorld.StopNow(ERROR_EXIT_CODE);
+    }
+    else
+        sWorld.StopNow(SHUTDOWN_EXIT_CODE);
+}
+
+void BenchmarkMgr::Report(std::vector<uint32>& totals)
+{
+    static char const* phaseNames[MAX_BENCHMARK_PHASES] = { "presession", "sessions", "maps", "singletons", "cleanup" };
+
+    uint32 const count = uint32(m_samples.size());
+    sLog.outString("Benchmark: %u ticks, %u synthetic players, times in microseconds", count, uint32(m_players.size()));
+    sLog.outString("Benchmark: %-10s %10s %10s %10s %10s %10s", "phase", "mean", "p50", "p95", "p99", "max");
+
+    auto report = [count](char const* name, std::vector<uint32>& times)
+    {
+        uint64 sum = 0;
+        for (uint32 time : times)
+            sum += time;
+        std::sort(times.begin(), times.end());
+
+        auto percentile = [&times, count](uint32 pct) { return times[std::min(count - 1, count * pct / 100)]; };
+        sLog.outString("Benchmark: %-10s %10u %10u %10u %10u %10u", name, uint32(sum / count), percentile(50), percentile(95), percentile(99), times.back());
+    };
+
+    std::vector<uint32> times(count);
+    totals.assign(count, 0);
+    for (uint32 phase = 0; phase < MAX_BENCHMARK_PHASES; ++phase)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            times[i] = m_samples[i][phase];
+            totals[i] += times[i];
+        }
+        report(phaseNames[phase], times);
+    }
+    report("total", totals);
+
+    if (m_startMemory)
+        sLog.outString("Benchmark: resident memory " UI64FMTD " KB at start, " UI64FMTD " KB at end, " UI64FMTD " KB peak",
+                       m_startMemory / 1024, GetResidentMemory() / 1024, m_peakMemory / 1024);
+}
+
+BenchmarkTickTimer::BenchmarkTickTimer() : m_enabled(sBenchmarkMgr.IsEnabled())
+{
+    Mark(BENCHMARK_PHASE_PRE_SESSION);
+}
+
+void BenchmarkTickTimer::Finish()
+{
+    if (m_enabled)
+        sBenchmarkMgr.AddTick(m_phaseStarts, BenchmarkMgr::Now());
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+#include "Policies/Singleton.h"
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+class WorldSession;
+class Player;
+
+// Note. All times are in microseconds here, unless said otherwise.
+
+enum BenchmarkPhase
+{
+    BENCHMARK_PHASE_PRE_SESSION,
+    BENCHMARK_PHASE_SESSIONS,
+    BENCHMARK_PHASE_MAPS,
+    BENCHMARK_PHASE_SINGLETONS,
+    BENCHMARK_PHASE_CLEANUP,
+    MAX_BENCHMARK_PHASES
+};
+
+enum BenchmarkActionType
+{
+    BENCHMARK_ACTION_MOVE,                                  // walk to a random point around the scenario center
+    BENCHMARK_ACTION_CAST,                                  // cast a spell at self, another synthetic player or the current victim
+    BENCHMARK_ACTION_FIGHT,                                 // summon a creature next to the player and attack it
+    BENCHMARK_ACTION_CHAT,                                  // say or yell a line
+};
+
+enum BenchmarkCastTarget
+{
+    BENCHMARK_CAST_SELF,
+    BENCHMARK_CAST_FRIEND,
+    BENCHMARK_CAST_ENEMY,
+};
+
+struct BenchmarkAction
+{
+    BenchmarkActionType type;
+    uint32 interval;                                        // ms between two actions of this type by the same player
+    uint32 param;                                           // spell id for cast, creature entry for fight
+    BenchmarkCastTarget castTarget;
+    bool yell;
+    std::string text;
+};
+
+// Contents of a scenario file, see src/benchmarks/scenarios
+struct BenchmarkScenario
+{
+    BenchmarkScenario() : mapId(0), x(0.f), y(0.f), z(0.f), radius(30.f), players(0), firstGuid(0), seed(0), maxTickP99(0) {}
+
+    uint32 mapId;
+    float x, y, z;
+    float radius;
+    uint32 players;
+    uint32 firstGuid;                                       // synthetic players are the characters firstGuid .. firstGuid + players - 1
+    uint32 seed;
+    uint32 maxTickP99;                                      // fail the run when the 99th percentile tick is slower, 0 for no limit
+    std::vector<BenchmarkAction> actions;
+};
+
+// mangosd --benchmark: runs a fixed number of world ticks, optionally with socketless synthetic players
+// driven by a scenario file, then logs tick time percentiles per phase and memory use and stops the server
+class BenchmarkMgr
+{
+    public:
+        typedef std::array<uint64, MAX_BENCHMARK_PHASES> PhaseStarts;
+
+        BenchmarkMgr();
+
+        void SetTicks(uint32 ticks) { m_ticks = ticks; }
+        void SetScenarioFile(std::string const& file) { m_scenarioFile = file; }
+        bool IsEnabled() const { return m_ticks != 0; }
+
+        // steady clock, independent of the trace clock
+        static uint64 Now();
+
+        // world thread, during the session phase: logs the synthetic players in and runs their actions
+        void Update(uint32 diff);
+        // world thread, end of every tick
+        void AddTick(PhaseStarts const& phaseStarts, uint64 tickEnd);
+
+        // logs out and deletes all synthetic sessions
+        void LogoutPlayers();
+
+        // defined in CharacterHandler.cpp next to the other login paths
+        void LoginPlayer(uint32 accountId, ObjectGuid guid);
+        void OnPlayerLogin(WorldSession* session);
+
+    private:
+        struct SyntheticPlayer
+        {
+            WorldSession* session;
+            std::vector<uint32> nextAction;                 // ms until the next action, per scenario action
+        };
+
+        bool LoadScenario();
+        bool StartLogins();
+        void RunAction(Player* player, BenchmarkAction const& action);
+        Player* GetRandomPlayer(Player* except);
+        void Finish();
+        void Report(std::vector<uint32>& totals);
+
+        uint32 m_ticks;
+        std::string m_scenarioFile;
+        BenchmarkScenario m_scenario;
+
+        bool m_started;
+        uint32 m_pendingLogins;
+        uint32 m_loginTime;                                 // ms spent waiting for the logins
+        std::vector<SyntheticPlayer> m_players;
+        std::mt19937 m_random;
+
+        std::vector<std::array<uint32, MAX_BENCHMARK_PHASES>> m_samples;
+        uint64 m_startMemory;
+        uint64 m_peakMemory;
+};
+
+// takes the phase start times of one world tick, only in benchmark mode
+class BenchmarkTickTimer
+{
+    public:
+        BenchmarkTickTimer();
+
+        void Mark(BenchmarkPhase phase) { if (m_enabled) m_phaseStarts[phase] = BenchmarkMgr::Now(); }
+        void Finish();
+
+    private:
+        bool m_enabled;
+        BenchmarkMgr::PhaseStarts m_phaseStarts;
+};
+
+#define sBenchmarkMgr MaNGOS::Singleton<BenchmarkMgr>::Instance()
+
+#endif
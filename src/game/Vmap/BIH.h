@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <type_traits>
 
 #define MAX_STACK_SIZE 64
 
@@ -56,6 +57,13 @@ static inline float intBitsToFloat(uint32 i)
     return temp.fval;
 }
 
+// ray callbacks may provide IntersectLeaf to test all objects of a leaf at once
+template<typename RayCallback, typename = void>
+struct HasLeafIntersect : std::false_type {};
+
+template<typename RayCallback>
+struct HasLeafIntersect<RayCallback, std::void_t<decltype(&RayCallback::IntersectLeaf)>> : std::true_type {};
+
 struct AABound
 {
     Vector3 lo, hi;
@@ -219,12 +227,21 @@ class BIH
                         {
                             // leaf - test some objects
                             int n = tree[node + 1];
-                            while (n > 0)
+                            if constexpr (HasLeafIntersect<RayCallback>::value)
                             {
-                                bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst, ignoreM2Model);
-                                if (stopAtFirst && hit) return;
-                                --n;
-                                ++offset;
+                                // callback tests the whole leaf in one go (SIMD)
+                                if (n > 0 && intersectCallback.IntersectLeaf(r, &objects[offset], n, maxDist, stopAtFirst, ignoreM2Model) && stopAtFirst)
+                                    return;
+                            }
+                            else
+                            {
+                                while (n > 0)
+                                {
+                                    bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst, ignoreM2Model);
+                                    if (stopAtFirst && hit) return;
+                                    --n;
+                                    ++offset;
+                                }
                             }
                             break;
                         }
@@ -26,6 +26,7 @@
 #include "Vmap/GameObjectModel.h"
 #include "Server/DBCStores.h"
 #include "ModelInstance.h"
+#include "VMapSimd.h"
 #include "Vmap/GameObjectModelVmaps.h"
 #include "MotionGenerators/MoveMapSharedDefines.h"
 
@@ -114,8 +115,7 @@ bool GameObjectModel::intersectRay(const G3D::Ray& ray, float& MaxDist, bool Sto
     if (!(phasemask & phaseMask))
         return false;
 
-    float time = ray.intersectionTime(iBound);
-    if (time == G3D::inf())
+    if (VMAP::IntersectRayBox(ray.origin(), ray.invDirection(), iBound, MaxDist) < 0.f)
         return false;
 
     // child bounds are defined in object space:
@@ -20,6 +20,7 @@
 #include "WorldModel.h"
 #include "MapTree.h"
 #include "VMapDefinitions.h"
+#include "VMapSimd.h"
 
 using G3D::Vector3;
 using G3D::Ray;
@@ -41,8 +42,8 @@ namespace VMAP
 #endif
             return false;
         }
-        float time = pRay.intersectionTime(iBound);
-        if (time == G3D::inf())
+        // bound is missed or entered only past the searched distance, nothing inside can be closer
+        if (IntersectRayBox(pRay.origin(), pRay.invDirection(), iBound, pMaxDist) < 0.f)
         {
 #ifdef VMAP_DEBUG
             DEBUG_LOG("Ray does not hit '%s'", name.c_str());
@@ -0,0 +1,189 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _VMAPSIMD_H
+#define _VMAPSIMD_H
+
+#include "Platform/Define.h"
+#include <G3D/Vector3.h>
+#include <G3D/AABox.h>
+
+#include <cfloat>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VMAP_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+// SSE kernels for the hot ray queries (line of sight, object hit position, height)
+// Every kernel has a scalar fallback with the same results for builds without SSE2
+namespace VMAP
+{
+    // triangles tested at once by IntersectTriangles
+    static uint32 constexpr SIMD_TRIANGLES = 4;
+
+    // Slab test of a ray against a box, invDir is 1 / direction per axis (may be infinite)
+    // Returns the entry distance (0 when the origin is inside) or -1 if the box is missed or only entered beyond maxDist
+    inline float IntersectRayBox(G3D::Vector3 const& origin, G3D::Vector3 const& invDir, G3D::AABox const& box, float maxDist)
+    {
+        G3D::Vector3 const& lo = box.low();
+        G3D::Vector3 const& hi = box.high();
+#ifdef VMAP_SIMD_SSE
+        // the fourth lane spans everything so it never narrows the interval
+        __m128 const org = _mm_setr_ps(origin.x, origin.y, origin.z, 0.f);
+        __m128 const inv = _mm_setr_ps(invDir.x, invDir.y, invDir.z, 1.f);
+        __m128 const t1 = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(lo.x, lo.y, lo.z, -FLT_MAX), org), inv);
+        __m128 const t2 = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(hi.x, hi.y, hi.z, FLT_MAX), org), inv);
+
+        // a ray parallel to a slab and starting on its plane gives 0 * inf = NaN
+        // such an axis counts as inside the slab, same as G3D::Ray::intersectionTime
+        __m128 const parallel = _mm_cmpunord_ps(t1, t2);
+        __m128 tNear = _mm_andnot_ps(parallel, _mm_min_ps(t1, t2));
+        __m128 tFar = _mm_or_ps(_mm_and_ps(parallel, _mm_set1_ps(FLT_MAX)), _mm_andnot_ps(parallel, _mm_max_ps(t1, t2)));
+        tNear = _mm_max_ps(tNear, _mm_setzero_ps());
+        tFar = _mm_min_ps(tFar, _mm_set1_ps(maxDist));
+        tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(2, 3, 0, 1)));
+        tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(1, 0, 3, 2)));
+        tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(2, 3, 0, 1)));
+        tFar = _mm_min_ps(tFar, _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        float const enter = _mm_cvtss_f32(tNear);
+        return enter <= _mm_cvtss_f32(tFar) ? enter : -1.f;
+#else
+        float enter = 0.f;
+        float exit = maxDist;
+        for (int i = 0; i < 3; ++i)
+        {
+            float t1 = (lo[i] - origin[i]) * invDir[i];
+            float t2 = (hi[i] - origin[i]) * invDir[i];
+            // parallel ray on the slab plane, see above
+            if (t1 != t1 || t2 != t2)
+                continue;
+            float near = t1 < t2 ? t1 : t2;
+            float far = t1 < t2 ? t2 : t1;
+            if (near > enter)
+                enter = near;
+            if (far < exit)
+                exit = far;
+        }
+        return enter <= exit ? enter : -1.f;
+#endif
+    }
+
+    // Möller-Trumbore (RTR2 ch. 13.7) against up to SIMD_TRIANGLES triangles given by their corners
+    // Same arithmetic as the scalar IntersectTriangle so results match it bit for bit
+    // Returns the lane of the closest hit nearer than distance and updates distance, -1 without hit
+    inline int IntersectTriangles(G3D::Vector3 const& origin, G3D::Vector3 const& dir, G3D::Vector3 const* const corners[][3], uint32 count, float& distance)
+    {
+        float const EPSILON = 1e-5f;
+#ifdef VMAP_SIMD_SSE
+        alignas(16) float v0[3][SIMD_TRIANGLES], v1[3][SIMD_TRIANGLES], v2[3][SIMD_TRIANGLES];
+        for (uint32 i = 0; i < SIMD_TRIANGLES; ++i)
+        {
+            // unused lanes repeat the first triangle and get masked out below
+            uint32 const src = i < count ? i : 0;
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                v0[axis][i] = (*corners[src][0])[axis];
+                v1[axis][i] = (*corners[src][1])[axis];
+                v2[axis][i] = (*corners[src][2])[axis];
+            }
+        }
+
+        __m128 const x0 = _mm_load_ps(v0[0]), y0 = _mm_load_ps(v0[1]), z0 = _mm_load_ps(v0[2]);
+        __m128 const e1x = _mm_sub_ps(_mm_load_ps(v1[0]), x0), e1y = _mm_sub_ps(_mm_load_ps(v1[1]), y0), e1z = _mm_sub_ps(_mm_load_ps(v1[2]), z0);
+        __m128 const e2x = _mm_sub_ps(_mm_load_ps(v2[0]), x0), e2y = _mm_sub_ps(_mm_load_ps(v2[1]), y0), e2z = _mm_sub_ps(_mm_load_ps(v2[2]), z0);
+        __m128 const dx = _mm_set1_ps(dir.x), dy = _mm_set1_ps(dir.y), dz = _mm_set1_ps(dir.z);
+
+        // p = dir x e2, a = e1 . p
+        __m128 const px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        __m128 const py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        __m128 const pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        __m128 const a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+        __m128 const absA = _mm_andnot_ps(_mm_set1_ps(-0.f), a);
+        __m128 mask = _mm_cmpge_ps(absA, _mm_set1_ps(EPSILON));
+
+        __m128 const f = _mm_div_ps(_mm_set1_ps(1.f), a);
+        __m128 const sx = _mm_sub_ps(_mm_set1_ps(origin.x), x0), sy = _mm_sub_ps(_mm_set1_ps(origin.y), y0), sz = _mm_sub_ps(_mm_set1_ps(origin.z), z0);
+        __m128 const u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, _mm_setzero_ps()), _mm_cmple_ps(u, _mm_set1_ps(1.f))));
+
+        // q = s x e1
+        __m128 const qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        __m128 const qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        __m128 const qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        __m128 const v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, _mm_setzero_ps()), _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.f))));
+
+        __m128 const t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(t, _mm_setzero_ps()), _mm_cmplt_ps(t, _mm_set1_ps(distance))));
+
+        int hits = _mm_movemask_ps(mask) & ((1 << count) - 1);
+        if (!hits)
+            return -1;
+
+        alignas(16) float times[SIMD_TRIANGLES];
+        _mm_store_ps(times, t);
+        int closest = -1;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if ((hits & (1 << i)) && times[i] < distance)
+            {
+                distance = times[i];
+                closest = int(i);
+            }
+        }
+        return closest;
+#else
+        int closest = -1;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            G3D::Vector3 const& p0 = *corners[i][0];
+            G3D::Vector3 const e1 = *corners[i][1] - p0;
+            G3D::Vector3 const e2 = *corners[i][2] - p0;
+            G3D::Vector3 const p(dir.cross(e2));
+            float const a = e1.dot(p);
+            if (fabs(a) < EPSILON)
+                continue;
+
+            float const f = 1.0f / a;
+            G3D::Vector3 const s(origin - p0);
+            float const u = f * s.dot(p);
+            if (u < 0.0f || u > 1.0f)
+                continue;
+
+            G3D::Vector3 const q(s.cross(e1));
+            float const v = f * dir.dot(q);
+            if (v < 0.0f || (u + v) > 1.0f)
+                continue;
+
+            float const t = f * e2.dot(q);
+            if (t > 0.0f && t < distance)
+            {
+                distance = t;
+                closest = int(i);
+            }
+        }
+        return closest;
+#endif
+    }
+}
+
+#endif
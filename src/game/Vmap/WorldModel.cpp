@@ -20,6 +20,7 @@
 #include "VMapDefinitions.h"
 #include "MapTree.h"
 #include "ModelInstance.h"
+#include "VMapSimd.h"
 #include <string.h>
 
 using G3D::Vector3;
@@ -381,6 +382,25 @@ namespace VMAP
                 hit = true;
             return hit;
         }
+        // whole BIH leaf at once, SIMD_TRIANGLES triangles per kernel call
+        bool IntersectLeaf(const G3D::Ray& ray, uint32 const* entries, uint32 count, float& distance, bool /*pStopAtFirstHit*/, bool /*ignoreM2Model*/)
+        {
+            Vector3 const* corners[SIMD_TRIANGLES][3];
+            for (uint32 i = 0; i < count; i += SIMD_TRIANGLES)
+            {
+                uint32 const batch = std::min(count - i, SIMD_TRIANGLES);
+                for (uint32 j = 0; j < batch; ++j)
+                {
+                    MeshTriangle const& tri = triangles[entries[i + j]];
+                    corners[j][0] = &vertices[tri.idx0];
+                    corners[j][1] = &vertices[tri.idx1];
+                    corners[j][2] = &vertices[tri.idx2];
+                }
+                if (IntersectTriangles(ray.origin(), ray.direction(), corners, batch, distance) >= 0)
+                    hit = true;
+            }
+            return hit;
+        }
         std::vector<Vector3>::const_iterator vertices;
         std::vector<MeshTriangle>::const_iterator triangles;
         bool hit;
@@ -45,6 +45,9 @@ namespace VMAP
             uint32 idx2;
     };
 
+    // scalar ray/triangle test, the SIMD kernels in VMapSimd.h must give the same results
+    bool IntersectTriangle(MeshTriangle const& tri, std::vector<Vector3>::const_iterator points, G3D::Ray const& ray, float& distance);
+
     class WmoLiquid
     {
         public:
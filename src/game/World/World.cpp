@@ -27,6 +27,8 @@
 #include "SystemConfig.h"
 #include "Log.h"
 #include "Server/Opcodes.h"
+#include "Server/OpcodeProfiler.h"
+#include "Util/Trace.h"
 #include "Server/WorldSession.h"
 #include "Server/WorldPacket.h"
 #include "Entities/Player.h"
@@ -63,6 +65,7 @@
 #include "GMTickets/GMTicketMgr.h"
 #include "Util/Util.h"
 #include "Tools/CharacterDatabaseCleaner.h"
+#include "Tools/Benchmark.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "Calendar/Calendar.h"
 #include "Weather/Weather.h"
@@ -102,7 +105,7 @@ TimePoint World::m_currentTime = TimePoint();
 uint32 World::m_currentDiff = 0;
 
 /// World constructor
-World::World() : mail_timer(0), mail_timer_expires(0), m_NextDailyQuestReset(0), m_NextWeeklyQuestReset(0), m_NextMonthlyQuestReset(0), m_opcodeCounters(NUM_MSG_TYPES)
+World::World() : mail_timer(0), mail_timer_expires(0), m_NextDailyQuestReset(0), m_NextWeeklyQuestReset(0), m_NextMonthlyQuestReset(0), m_lastAutoTraceDump(0), m_traceDumpRunning(false), m_opcodeCounters(NUM_MSG_TYPES)
 {
     m_playerLimit = 0;
     m_allowMovement = true;
@@ -155,8 +158,12 @@ void World::CleanupsBeforeStop()
 {
     KickAll(true);                                   // save and kick all players
     UpdateSessions(1);                               // real players unload required UpdateSessions call
+    sBenchmarkMgr.LogoutPlayers();                   // synthetic players are not in the session list
     sBattleGroundMgr.DeleteAllBattleGrounds();       // unload battleground templates before different singletons destroyed
     sMapMgr.UnloadAll();                             // unload all grids (including locked in memory)
+    sLootMgr.CancelDropSimulation();                 // it reads loot stores and reports through the world messager
+    if (m_traceDumpThread.joinable())                // a trace dump may still be writing its file
+        m_traceDumpThread.join();
 }
 
 /// Find a session by its id
@@ -485,6 +492,10 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
     setConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS, "MaxWhoListReturns", 49);
+    setConfig(CONFIG_UINT32_OPCODE_PROFILER_SAMPLE_RATE, "OpcodeProfiler.SampleRate", 0);
+    setConfig(CONFIG_BOOL_TRACE_ENABLE, "Trace.Enable", false);
+    setConfig(CONFIG_UINT32_TRACE_AUTO_DUMP_THRESHOLD, "Trace.AutoDumpThreshold", 0);
+    Trace::SetEnabled(getConfig(CONFIG_BOOL_TRACE_ENABLE));
 
     std::string forceLoadGridOnMaps = sConfig.GetStringDefault("LoadAllGridsOnMaps");
     if (!forceLoadGridOnMaps.empty())
@@ -501,6 +512,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_INTERVAL_SAVE, "PlayerSave.Interval", 15 * MINUTE * IN_MILLISECONDS);
     setConfigMinMax(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, 0, MAX_LEVEL);
     setConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
+    setConfig(CONFIG_BOOL_SAVE_BINARY_NUMBER_LISTS, "PlayerSave.BinaryNumberLists", false);
 
     setConfigMin(CONFIG_UINT32_INTERVAL_GRIDCLEAN, "GridCleanUpDelay", 5 * MINUTE * IN_MILLISECONDS, MIN_GRID_DELAY);
     if (reload)
@@ -622,6 +634,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_MAIL_DELIVERY_DELAY, "MailDeliveryDelay", HOUR);
 
     setConfigMin(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK, "MassMailer.SendPerTick", 10, 1);
+    setConfigMin(CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE, "Mail.ExpireChunkSize", 500, 1);
 
     setConfig(CONFIG_UINT32_UPTIME_UPDATE, "UpdateUptimeInterval", 10);
     if (reload)
@@ -719,6 +732,8 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_FLOAT_LEASH_RADIUS, "LeashRadius", 30.f);
     setConfigMin(CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY, "CreatureRespawnAggroDelay", 5000, 0);
     setConfig(CONFIG_UINT32_CREATURE_PICKPOCKET_RESTOCK_DELAY, "CreaturePickpocketRestockDelay", 600);
+    setConfig(CONFIG_UINT32_CREATURE_IDLE_UPDATE_INTERVAL, "CreatureIdleUpdateInterval", 400);
+    setConfigPos(CONFIG_FLOAT_CREATURE_IDLE_UPDATE_PLAYER_DISTANCE, "CreatureIdleUpdatePlayerDistance", 40.0f);
 
     // always use declined names in the russian client
     if (getConfig(CONFIG_UINT32_REALM_ZONE) == REALM_ZONE_RUSSIAN)
@@ -871,6 +886,8 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
+    setConfig(CONFIG_BOOL_TERRAIN_AREA_CACHE, "vmap.enableAreaCache", true);
+    setConfig(CONFIG_UINT32_VMAP_LOS_CACHE_TTL, "vmap.losCacheTTL", 500);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
 
@@ -890,6 +907,7 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    setConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE, "PathFinder.CacheSize", 512);
 
     setConfig(CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL, "Raf.BonusLevel", 60);
     setConfig(CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE, "Raf.LevelDifference", 4);
@@ -1582,6 +1600,9 @@ void World::DetectDBCLang()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    uint64 const traceTickStart = Trace::Now();
+    BenchmarkTickTimer benchmarkTimer;
+
     m_currentMSTime = WorldTimer::getMSTime();
     m_currentTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     m_currentDiff = diff;
@@ -1649,7 +1670,12 @@ void World::Update(uint32 diff)
 #ifdef BUILD_METRICS
     auto preSessionTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
-    UpdateSessions(diff);
+    benchmarkTimer.Mark(BENCHMARK_PHASE_SESSIONS);
+    {
+        TRACE_SCOPE("World::UpdateSessions");
+        UpdateSessions(diff);
+        sBenchmarkMgr.Update(diff);
+    }
 
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
@@ -1666,13 +1692,16 @@ void World::Update(uint32 diff)
 #ifdef BUILD_METRICS
     auto preMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
+    benchmarkTimer.Mark(BENCHMARK_PHASE_MAPS);
     sMapMgr.Update(diff);
+    benchmarkTimer.Mark(BENCHMARK_PHASE_SINGLETONS);
 #ifdef BUILD_METRICS
     auto postMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
     sBattleGroundMgr.Update(diff);
     sOutdoorPvPMgr.Update(diff);
     sWorldState.Update(diff);
+    benchmarkTimer.Mark(BENCHMARK_PHASE_CLEANUP);
 #ifdef BUILD_METRICS
     auto postSingletonTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
@@ -1726,6 +1755,7 @@ void World::Update(uint32 diff)
     {
         m_timers[WUPDATE_METRICS].Reset();
         GeneratePacketMetrics();
+        GenerateDatabaseMetrics();
     }
 #endif
 
@@ -1758,6 +1788,80 @@ void World::Update(uint32 diff)
     meas.add_field("singletons", std::to_string(singletons));
     meas.add_field("cleanup", std::to_string(cleanup));
 #endif
+
+    benchmarkTimer.Finish();
+
+    bool const traceDumpRequested = Trace::ConsumeDumpRequest();
+    if (Trace::IsEnabled())
+    {
+        uint64 const traceTickEnd = Trace::Now();
+        Trace::Record("World::Update", traceTickStart, traceTickEnd - traceTickStart);
+
+        // a few seconds of history is enough to see what led to a slow tick, and at most one dump per minute
+        uint32 const threshold = getConfig(CONFIG_UINT32_TRACE_AUTO_DUMP_THRESHOLD);
+        if (traceDumpRequested)
+        {
+            std::string const path = DumpTrace(10);
+            if (!path.empty())
+                sLog.outString("Trace dump requested, writing %s", path.c_str());
+            else
+                sLog.outError("Trace dump requested but the previous dump is still being written");
+        }
+        else if (threshold && traceTickEnd - traceTickStart > uint64(threshold) * IN_MILLISECONDS && (!m_lastAutoTraceDump || traceTickEnd - m_lastAutoTraceDump > uint64(MINUTE) * IN_MILLISECONDS * IN_MILLISECONDS))
+        {
+            m_lastAutoTraceDump = traceTickEnd;
+            std::string const path = DumpTrace(5);
+            if (!path.empty())
+                sLog.outString("World tick took " UI64FMTD " ms, writing trace %s", (traceTickEnd - traceTickStart) / IN_MILLISECONDS, path.c_str());
+        }
+    }
+    else if (traceDumpRequested)
+        sLog.outError("Trace dump requested but Trace.Enable is off");
+}
+
+std::string World::DumpTrace(uint32 seconds)
+{
+    // one dump at a time, each one copies the whole trace buffer
+    if (m_traceDumpRunning)
+        return std::string();
+
+    // the previous dump has finished, only its thread is left to be joined
+    if (m_traceDumpThread.joinable())
+        m_traceDumpThread.join();
+
+    // the sequence number keeps two dumps within one second apart
+    static uint32 dumpCounter = 0;
+
+    char timeStr[32];
+    time_t now = time(nullptr);
+    tm nowTm;
+#ifdef _MSC_VER
+    localtime_s(&nowTm, &now);
+#else
+    localtime_r(&now, &nowTm);
+#endif
+    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d_%H-%M-%S", &nowTm);
+
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "trace_%s_%u.json", timeStr, ++dumpCounter);
+
+    std::string path = sConfig.GetStringDefault("LogsDir");
+    if (!path.empty() && path.back() != '/' && path.back() != '\\')
+        path.push_back('/');
+    path += fileName;
+
+    m_traceDumpRunning = true;
+    m_traceDumpThread = std::thread([this, path, seconds]()
+    {
+        uint32 count = Trace::Dump(path, uint64(seconds) * IN_MILLISECONDS * IN_MILLISECONDS);
+        if (count)
+            sLog.outString("Trace written to %s (%u events)", path.c_str(), count);
+        else
+            sLog.outError("Trace could not be written to %s", path.c_str());
+        m_traceDumpRunning = false;
+    });
+
+    return path;
 }
 
 namespace MaNGOS
@@ -2829,6 +2933,33 @@ void World::GeneratePacketMetrics()
         m_opcodeCounters[i] = 0;
     }
 
+    // sampled handler latency, cumulative until reset by .debug performance opcodes reset
+    for (OpcodeLatencyReport const& stats : sOpcodeProfiler.GetReport())
+    {
+        metric::measurement meas("world.metrics.packets.latency", { {"opcode", opcodeTable[stats.opcode].name} });
+        meas.add_field("samples", std::to_string(stats.samples));
+        meas.add_field("total_us", std::to_string(stats.totalTime));
+        meas.add_field("max_us", std::to_string(stats.maxTime));
+        meas.add_field("p50_us", std::to_string(stats.p50));
+        meas.add_field("p99_us", std::to_string(stats.p99));
+    }
+
+    // the sessions spending the most handler time
+    std::vector<WorldSession const*> busySessions;
+    ExecuteForAllSessions([&busySessions](WorldSession const& session)
+    {
+        if (session.GetHandlerTime())
+            busySessions.push_back(&session);
+    });
+    uint32 const busySessionCount = std::min<uint32>(busySessions.size(), 5);
+    std::partial_sort(busySessions.begin(), busySessions.begin() + busySessionCount, busySessions.end(),
+                      [](WorldSession const* a, WorldSession const* b) { return a->GetHandlerTime() > b->GetHandlerTime(); });
+    for (uint32 i = 0; i < busySessionCount; ++i)
+    {
+        metric::measurement meas("world.metrics.sessions.handler_time", { {"account", std::to_string(busySessions[i]->GetAccountId())} });
+        meas.add_field("total_us", std::to_string(busySessions[i]->GetHandlerTime()));
+    }
+
     metric::measurement meas_players("world.metrics.players");
     meas_players.add_field("online", std::to_string(GetActiveSessionCount()));
     meas_players.add_field("unique", std::to_string(GetUniqueSessionCount()));
@@ -2864,6 +2995,24 @@ void World::GeneratePacketMetrics()
     meas_latency.add_field("online", std::to_string(GetAverageLatency()));
 }
 
+void World::GenerateDatabaseMetrics()
+{
+    std::pair<char const*, Database*> const databases[] = { {"world", &WorldDatabase}, {"character", &CharacterDatabase}, {"login", &LoginDatabase}, {"logs", &LogsDatabase} };
+    for (auto const& database : databases)
+    {
+        SqlDelayThreadStats const stats = database.second->GetDelayThreadStats();
+
+        metric::measurement meas("world.metrics.database.async", { {"database", database.first} });
+        meas.add_field("queue_depth", std::to_string(stats.queueDepth));
+        meas.add_field("max_queue_depth", std::to_string(stats.maxQueueDepth));
+        meas.add_field("batches", std::to_string(stats.batches));
+        meas.add_field("avg_batch_size", std::to_string(stats.batches ? stats.batchedStatements / stats.batches : 0));
+        meas.add_field("max_batch_size", std::to_string(stats.maxBatchSize));
+        meas.add_field("avg_commit_us", std::to_string(stats.batches ? stats.commitTimeUs / stats.batches : 0));
+        meas.add_field("max_commit_us", std::to_string(stats.maxCommitTimeUs));
+    }
+}
+
 uint32 World::GetAverageLatency() const
 {
     if (m_sessions.size() == 0)
@@ -149,6 +149,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GM_INVISIBLE_AURA,
     CONFIG_UINT32_MAIL_DELIVERY_DELAY,
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
+    CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE,
+    CONFIG_UINT32_VMAP_LOS_CACHE_TTL,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
@@ -220,10 +222,14 @@ enum eConfigUInt32Values
     CONFIG_UINT32_FOGOFWAR_HEALTH,
     CONFIG_UINT32_FOGOFWAR_STATS,
     CONFIG_UINT32_CREATURE_PICKPOCKET_RESTOCK_DELAY,
+    CONFIG_UINT32_CREATURE_IDLE_UPDATE_INTERVAL,
     CONFIG_UINT32_CHANNEL_STATIC_AUTO_TRESHOLD,
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL,
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE,
     CONFIG_UINT32_SUNSREACH_COUNTER,
+    CONFIG_UINT32_PATH_FIND_CACHE_SIZE,
+    CONFIG_UINT32_OPCODE_PROFILER_SAMPLE_RATE,
+    CONFIG_UINT32_TRACE_AUTO_DUMP_THRESHOLD,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -308,6 +314,7 @@ enum eConfigFloatValues
     CONFIG_FLOAT_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS,
     CONFIG_FLOAT_CREATURE_FAMILY_ASSISTANCE_RADIUS,
     CONFIG_FLOAT_CREATURE_CHECK_FOR_HELP_RADIUS,
+    CONFIG_FLOAT_CREATURE_IDLE_UPDATE_PLAYER_DISTANCE,
     CONFIG_FLOAT_GROUP_XP_DISTANCE,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
@@ -389,6 +396,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_BATTLEFIELD_WG_ENABLED,
     CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET,
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
+    CONFIG_BOOL_SAVE_BINARY_NUMBER_LISTS,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
     CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,
@@ -399,7 +407,9 @@ enum eConfigBoolValues
     CONFIG_BOOL_AUTOLOAD_ACTIVE,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_TERRAIN_AREA_CACHE,
     CONFIG_BOOL_ALWAYS_SHOW_QUEST_GREETING,
+    CONFIG_BOOL_TRACE_ENABLE,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -683,6 +693,10 @@ class World
 
         void IncrementOpcodeCounter(uint32 opcodeId); // thread safe due to atomics
 
+        // writes the trace events of the last seconds to a new file in LogsDir on a background thread, returns the file name
+        // or an empty string while the previous dump is still being written
+        std::string DumpTrace(uint32 seconds);
+
         void LoadWorldSafeLocs() const;
         void LoadGraveyardZones();
         GraveyardManager& GetGraveyardManager() { return m_graveyardManager; }
@@ -715,6 +729,7 @@ class World
 
 #ifdef BUILD_METRICS
         void GeneratePacketMetrics(); // thread safe due to atomics
+        void GenerateDatabaseMetrics();
         uint32 GetAverageLatency() const;
 #endif
 
@@ -811,6 +826,10 @@ class World
 
         Messager<World> m_messager;
 
+        uint64 m_lastAutoTraceDump;                         // trace clock, limits automatic dumps of slow ticks
+        std::thread m_traceDumpThread;
+        std::atomic<bool> m_traceDumpRunning;
+
         // Opcode logging
         std::vector<std::atomic<uint32>> m_opcodeCounters;
         // online count logging
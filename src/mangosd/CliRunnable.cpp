@@ -422,6 +422,128 @@ bool ChatHandler::HandleCharacterDeletedOldCommand(char* args)
     return true;
 }
 
+namespace
+{
+    // number list columns written by AppendUInt32List, see PlayerSave.BinaryNumberLists
+    struct NumberListTable
+    {
+        char const* name;
+        char const* columns[4];
+        uint32 columnCount;
+    };
+
+    NumberListTable const numberListTables[] =
+    {
+        { "characters",    { "taximask", "exploredZones", "equipmentCache", "knownTitles" }, 4 },
+        { "item_instance", { "enchantments" },                                                1 },
+    };
+
+    uint32 const NUMBER_LIST_CONVERT_BATCH = 1000;          // rows per delay thread task, saves run in between
+
+    // rewrites the lists of the rows with guid in [first, first + NUMBER_LIST_CONVERT_BATCH), returns the number of changed rows
+    uint32 ConvertNumberListRows(SqlConnection* conn, NumberListTable const& table, uint32 first, bool binary)
+    {
+        std::ostringstream query;
+        query << "SELECT guid";
+        for (uint32 i = 0; i < table.columnCount; ++i)
+            query << ", " << table.columns[i];
+        query << " FROM " << table.name << " WHERE guid >= " << first << " AND guid < " << uint64(first) + NUMBER_LIST_CONVERT_BATCH;
+
+        std::unique_ptr<QueryResult> result(conn->Query(query.str().c_str()));
+        if (!result)
+            return 0;
+
+        uint32 converted = 0;
+        std::vector<uint32> values;
+        std::string encoded;
+        std::string escaped;
+        do
+        {
+            Field* fields = result->Fetch();
+            std::ostringstream update;
+            for (uint32 i = 0; i < table.columnCount; ++i)
+            {
+                if (fields[i + 1].IsNULL())
+                    continue;
+
+                char const* data = fields[i + 1].GetString();
+                values.resize(ParseUInt32List(data, nullptr, 0));
+                ParseUInt32List(data, values.data(), uint32(values.size()));
+
+                encoded.clear();
+                AppendUInt32List(encoded, values.data(), uint32(values.size()), binary);
+                if (encoded == data)
+                    continue;
+
+                escaped.resize(encoded.size() * 2 + 1);
+                escaped.resize(conn->escape_string(&escaped[0], encoded.c_str(), encoded.size()));
+                update << (update.tellp() > 0 ? ", " : "") << table.columns[i] << " = '" << escaped << "'";
+            }
+
+            if (update.tellp() > 0)
+            {
+                conn->Execute(("UPDATE " + std::string(table.name) + " SET " + update.str() + " WHERE guid = " + std::to_string(fields[0].GetUInt32())).c_str());
+                ++converted;
+            }
+        }
+        while (result->NextRow());
+
+        return converted;
+    }
+}
+
+/**
+ * Handles the '.character convertlists [text|binary]' command, which rewrites the number list columns of all
+ * characters and items in the given format, by default the one of PlayerSave.BinaryNumberLists
+ *
+ * The rows are converted in batches on the character database delay thread, so saves queued before a batch are
+ * in the database when it reads the rows and the ones queued later overwrite its result, online players are safe
+ *
+ * @param args the optional target format
+ */
+bool ChatHandler::HandleCharacterConvertListsCommand(char* args)
+{
+    bool binary = sWorld.getConfig(CONFIG_BOOL_SAVE_BINARY_NUMBER_LISTS);
+    if (char* format = ExtractLiteralArg(&args))
+    {
+        if (strncmp(format, "binary", strlen(format)) == 0)
+            binary = true;
+        else if (strncmp(format, "text", strlen(format)) == 0)
+            binary = false;
+        else
+            return false;
+    }
+
+    std::shared_ptr<uint32> converted = std::make_shared<uint32>(0);
+    uint32 batches = 0;
+    for (NumberListTable const& table : numberListTables)
+    {
+        QueryResult* result = CharacterDatabase.PQuery("SELECT MAX(guid) FROM %s", table.name);
+        uint32 maxGuid = result ? (*result)[0].GetUInt32() : 0;
+        delete result;
+
+        for (uint64 first = 0; first <= maxGuid; first += NUMBER_LIST_CONVERT_BATCH)
+        {
+            NumberListTable const* tablePtr = &table;
+            CharacterDatabase.AsyncTask([tablePtr, first, binary, converted](SqlConnection* conn)
+            {
+                *converted += ConvertNumberListRows(conn, *tablePtr, uint32(first), binary);
+            });
+            ++batches;
+        }
+    }
+
+    CharacterDatabase.AsyncTask([converted, binary](SqlConnection* /*conn*/)
+    {
+        sLog.outString("Number list conversion to %s finished, %u rows changed", binary ? "binary" : "text", *converted);
+    });
+
+    PSendSysMessage("Queued %u batches to convert number lists to %s, see the server log for the result", batches, binary ? "binary" : "text");
+    if (binary)
+        SendSysMessage("Binary lists need the blob columns of the 14081_01_characters_number_list_blobs update");
+    return true;
+}
+
 bool ChatHandler::HandleCharacterEraseCommand(char* args)
 {
     char* nameStr = ExtractLiteralArg(&args);
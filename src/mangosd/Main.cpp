@@ -26,6 +26,7 @@
 #include "Util/ProgressBar.h"
 #include "Log.h"
 #include "Master.h"
+#include "Tools/Benchmark.h"
 #include "SystemConfig.h"
 #include "AuctionHouseBot/AuctionHouseBot.h"
 #include "revision.h"
@@ -68,12 +69,15 @@ uint32 realmID;                                             ///< Id of the realm
 /// Launch the mangos server
 int main(int argc, char* argv[])
 {
-    std::string auctionBotConfig, configFile, playerBotConfig, serviceParameter;
+    std::string auctionBotConfig, configFile, playerBotConfig, serviceParameter, benchmarkScenario;
+    uint32 benchmarkTicks = 0;
 
     boost::program_options::options_description desc("Allowed options");
     desc.add_options()
     ("ahbot,a", boost::program_options::value<std::string>(&auctionBotConfig), "ahbot configuration file")
     ("config,c", boost::program_options::value<std::string>(&configFile)->default_value(_MANGOSD_CONFIG), "configuration file")
+    ("benchmark,b", boost::program_options::value<uint32>(&benchmarkTicks), "run the given number of world ticks, log tick time statistics and exit")
+    ("scenario", boost::program_options::value<std::string>(&benchmarkScenario), "benchmark scenario file with synthetic players")
 #ifdef BUILD_PLAYERBOT
     ("playerbot,p", boost::program_options::value<std::string>(&playerBotConfig)->default_value(_D_PLAYERBOT_CONFIG), "playerbot configuration file")
 #endif
@@ -116,6 +120,12 @@ int main(int argc, char* argv[])
     if (vm.count("ahbot"))
         sAuctionHouseBot.SetConfigFileName(auctionBotConfig);
 
+    if (vm.count("benchmark"))
+    {
+        sBenchmarkMgr.SetTicks(benchmarkTicks);
+        sBenchmarkMgr.SetScenarioFile(benchmarkScenario);
+    }
+
 #ifdef BUILD_PLAYERBOT
     if (vm.count("playerbot"))
         _PLAYERBOT_CONFIG = playerBotConfig;
@@ -31,6 +31,7 @@
 #include "CliRunnable.h"
 #include "RASocket.h"
 #include "Util/Util.h"
+#include "Util/Trace.h"
 #include "revision_sql.h"
 #include "MaNGOSsoap.h"
 #include "Mails/MassMailMgr.h"
@@ -483,6 +484,13 @@ void Master::_OnSignal(int s)
         case SIGINT:
             World::StopNow(RESTART_EXIT_CODE);
             break;
+#ifndef _WIN32
+        case SIGUSR1:
+            // not a termination signal, the world thread writes the trace on its next tick
+            Trace::RequestDump();
+            signal(s, _OnSignal);
+            return;
+#endif
         case SIGTERM:
 #ifdef _WIN32
         case SIGBREAK:
@@ -509,6 +517,8 @@ void Master::_HookSignals()
     signal(SIGTERM, _OnSignal);
 #ifdef _WIN32
     signal(SIGBREAK, _OnSignal);
+#else
+    signal(SIGUSR1, _OnSignal);
 #endif
 }
 
@@ -519,5 +529,7 @@ void Master::_UnhookSignals()
     signal(SIGTERM, nullptr);
 #ifdef _WIN32
     signal(SIGBREAK, nullptr);
+#else
+    signal(SIGUSR1, nullptr);
 #endif
 }
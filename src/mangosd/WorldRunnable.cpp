@@ -25,6 +25,7 @@
 #include "WorldRunnable.h"
 #include "Util/Timer.h"
 #include "Maps/MapManager.h"
+#include "Util/Trace.h"
 
 #include "Database/DatabaseEnv.h"
 
@@ -41,6 +42,7 @@ void WorldRunnable::run()
     ///- Init new SQL thread for the world database
     WorldDatabase.ThreadStart();                            // let thread do safe mySQL requests (one connection call enough)
     sWorld.InitResultQueue();
+    Trace::SetThreadName("world");
 
     uint32 diffTick = WorldTimer::tick(); // initialize world timer vars
     uint32 diffTime = 0; // used to compute real time elapsed in World::Update()
@@ -304,6 +304,26 @@ void AuthSocket::SendProof(Sha1Hash sha)
     }
 }
 
+/// Logon challenge lookups, filled on the login database delay thread
+struct AuthSocket::LogonChallengeData
+{
+    LogonChallengeData() : ipBanned(false) {}
+
+    bool ipBanned;
+    std::unique_ptr<QueryResult> account;
+    std::unique_ptr<QueryResult> accountBan;
+};
+
+struct AuthSocket::RealmListData
+{
+    RealmListData() : accountFound(false), accountId(0), accountSecurityLevel(0) {}
+
+    bool accountFound;
+    uint32 accountId;
+    uint8 accountSecurityLevel;
+    std::map<uint32, uint8> characterCounts;                // realm id -> number of characters of the account
+};
+
 /// Logon Challenge command handler
 bool AuthSocket::_HandleLogonChallenge()
 {
@@ -348,8 +368,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -376,25 +394,51 @@ bool AuthSocket::_HandleLogonChallenge()
     LoginDatabase.escape_string(_safelocale);
     LoginDatabase.escape_string(m_os);
 
-    pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
-    pkt << uint8(0x00);
-
     ///- Verify that this IP is not in the ip_banned table
     // No SQL injection possible (paste the IP address as passed by the socket)
-    std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
-            "WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str()));
+    std::string const ipBanQuery = "SELECT expires_at FROM ip_banned "
+                                   "WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '" + m_address + "'";
+    ///- Get the account details from the account table
+    // No SQL injection (escaped user name)
+    std::string const accountQuery = "SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '" + _safelogin + "'";
+
+    // lookups run on the login database delay thread, the reply is built on this socket's network thread afterwards
+    std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+    return LoginDatabase.AsyncTask([self, ipBanQuery, accountQuery](SqlConnection* conn)
+    {
+        std::shared_ptr<LogonChallengeData> data = std::make_shared<LogonChallengeData>();
+        data->ipBanned = std::unique_ptr<QueryResult>(conn->Query(ipBanQuery.c_str())) != nullptr;
+        if (!data->ipBanned)
+        {
+            data->account.reset(conn->Query(accountQuery.c_str()));
+            if (data->account)
+                data->accountBan.reset(conn->Query(("SELECT banned_at,expires_at FROM account_banned WHERE "
+                                                    "account_id = " + std::to_string((*data->account)[0].GetUInt32()) + " AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)").c_str()));
+        }
+
+        self->Post([self, data]()
+        {
+            if (!self->IsClosed())
+                self->_HandleLogonChallengeResult(*data);
+        });
+    });
+}
 
-    if (ip_banned_result)
+void AuthSocket::_HandleLogonChallengeResult(LogonChallengeData& data)
+{
+    ByteBuffer pkt;
+
+    pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
+
+    if (data.ipBanned)
     {
         pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
         BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", m_address.c_str());
     }
     else
     {
-        ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
-        QueryResult* result = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", _safelogin.c_str());
-        if (result)
+        if (QueryResult* result = data.account.get())
         {
             Field* fields = result->Fetch();
 
@@ -430,9 +474,7 @@ bool AuthSocket::_HandleLogonChallenge()
             if (!locked && !broken)
             {
                 ///- If the account is banned, reject the logon attempt
-                QueryResult* banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                                         "account_id = %u AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)", fields[0].GetUInt32());
-                if (banresult)
+                if (QueryResult* banresult = data.accountBan.get())
                 {
                     if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
                     {
@@ -444,8 +486,6 @@ bool AuthSocket::_HandleLogonChallenge()
                         pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
                         BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
                     }
-
-                    delete banresult;
                 }
                 else
                 {
@@ -501,14 +541,12 @@ bool AuthSocket::_HandleLogonChallenge()
                     _status = STATUS_LOGON_PROOF;
                 }
             }
-            delete result;
         }
         else                                                // no account
             pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
     }
 
     Write((const char*)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Logon Proof command handler
@@ -596,11 +634,24 @@ bool AuthSocket::_HandleLogonProof()
         // No SQL injection (escaped user input) and IP address as received by socket
         const char* K_hex = srp.GetStrongSessionKey().AsHexStr();
         LoginDatabase.PExecute("UPDATE account SET sessionkey = '%s', locale = '%s', failed_logins = 0, os = '%s', platform = '%s' WHERE username = '%s'", K_hex, _safelocale.c_str(), m_os.c_str(), m_platform.c_str(), _safelogin.c_str());
-        std::unique_ptr<QueryResult> loginfail(LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str()));
-        if (loginfail)
-            LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s',NOW(),'%u')", loginfail->Fetch()[0].GetUInt32(), m_address.c_str(), LOGIN_TYPE_REALMD);
         OPENSSL_free((void*)K_hex);
 
+        // the logon record only needs the account id, look it up on the login database delay thread
+        std::string const accountIdQuery = "SELECT id FROM account WHERE username = '" + _safelogin + "'";
+        std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+        LoginDatabase.AsyncTask([self, accountIdQuery](SqlConnection* conn)
+        {
+            std::shared_ptr<QueryResult> result(conn->Query(accountIdQuery.c_str()));
+            if (!result)
+                return;
+
+            uint32 const accountId = result->Fetch()[0].GetUInt32();
+            self->Post([self, accountId]()
+            {
+                LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s',NOW(),'%u')", accountId, self->m_address.c_str(), LOGIN_TYPE_REALMD);
+            });
+        });
+
         ///- Finish SRP6 and send the final result to the client
         Sha1Hash sha;
         srp.Finalize(sha);
@@ -632,42 +683,57 @@ bool AuthSocket::_HandleLogonProof()
             // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
             LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
 
-            if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
+            // the ban check reads the counter back on the login database delay thread, after the update above
+            // no IsClosed() check on the way back, a client dropping the connection must not dodge the autoban
+            std::string const failedLoginsQuery = "SELECT id, failed_logins FROM account WHERE username = '" + _safelogin + "'";
+            std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+            LoginDatabase.AsyncTask([self, failedLoginsQuery, MaxWrongPassCount](SqlConnection* conn)
             {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
+                std::shared_ptr<QueryResult> result(conn->Query(failedLoginsQuery.c_str()));
+                if (!result)
+                    return;
 
-                if (failed_logins >= MaxWrongPassCount)
+                self->Post([self, result, MaxWrongPassCount]()
                 {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
-                                               "VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                               acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = m_address;
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                                               current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
-                delete loginfail;
-            }
+                    self->_HandleLogonProofFailResult(*result, MaxWrongPassCount);
+                });
+            });
         }
     }
     return true;
 }
 
+void AuthSocket::_HandleLogonProofFailResult(QueryResult& result, uint32 maxWrongPassCount)
+{
+    Field* fields = result.Fetch();
+    uint32 failed_logins = fields[1].GetUInt32();
+
+    if (failed_logins >= maxWrongPassCount)
+    {
+        uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+        bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+
+        if (WrongPassBanType)
+        {
+            uint32 acc_id = fields[0].GetUInt32();
+            LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
+                                   "VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
+                                   acc_id, WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                      _login.c_str(), WrongPassBanTime, failed_logins);
+        }
+        else
+        {
+            std::string current_ip = m_address;
+            LoginDatabase.escape_string(current_ip);
+            LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                                   current_ip.c_str(), WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                      current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
+        }
+    }
+}
+
 /// Reconnect Challenge command handler
 bool AuthSocket::_HandleReconnectChallenge()
 {
@@ -711,19 +777,33 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
+    std::string const sessionKeyQuery = "SELECT sessionkey FROM account WHERE username = '" + _safelogin + "'";
+
+    // lookup runs on the login database delay thread, the reply is sent from this socket's network thread afterwards
+    std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+    return LoginDatabase.AsyncTask([self, sessionKeyQuery](SqlConnection* conn)
+    {
+        std::shared_ptr<QueryResult> result(conn->Query(sessionKeyQuery.c_str()));
+        self->Post([self, result]()
+        {
+            if (!self->IsClosed())
+                self->_HandleReconnectChallengeResult(result.get());
+        });
+    });
+}
 
+void AuthSocket::_HandleReconnectChallengeResult(QueryResult* result)
+{
     // Stop if the account is not found
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
         Close();
-        return false;
+        return;
     }
 
     Field* fields = result->Fetch();
     srp.SetStrongSessionKey(fields[0].GetString());
-    delete result;
 
     ///- All good, await client's proof
     _status = STATUS_RECON_PROOF;
@@ -736,7 +816,6 @@ bool AuthSocket::_HandleReconnectChallenge()
     pkt.append(_reconnectProof.AsByteArray(16));        // 16 bytes random
     pkt.append(VersionChallenge.data(), VersionChallenge.size());
     Write((const char*)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Reconnect Proof command handler
@@ -800,27 +879,56 @@ bool AuthSocket::_HandleRealmList()
 
     ReadSkip(5);
 
-    ///- Get the user id (else close the connection)
+    ///- Get the user id and the character count on every realm (else close the connection)
     // No SQL injection (escaped user name)
+    std::string const accountQuery = "SELECT id, gmlevel FROM account WHERE username = '" + _safelogin + "'";
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", _safelogin.c_str());
-    if (!result)
+    // lookups run on the login database delay thread, the realm list is built on this socket's network thread afterwards
+    std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+    return LoginDatabase.AsyncTask([self, accountQuery](SqlConnection* conn)
+    {
+        std::shared_ptr<RealmListData> data = std::make_shared<RealmListData>();
+        if (std::unique_ptr<QueryResult> account = std::unique_ptr<QueryResult>(conn->Query(accountQuery.c_str())))
+        {
+            data->accountFound = true;
+            data->accountId = (*account)[0].GetUInt32();
+            data->accountSecurityLevel = (*account)[1].GetUInt8();
+
+            // one query for all realms instead of one per realm
+            if (std::unique_ptr<QueryResult> chars = std::unique_ptr<QueryResult>(conn->Query(("SELECT realmid, numchars FROM realmcharacters WHERE acctid = " + std::to_string(data->accountId)).c_str())))
+            {
+                do
+                {
+                    Field* fields = chars->Fetch();
+                    data->characterCounts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+                }
+                while (chars->NextRow());
+            }
+        }
+
+        self->Post([self, data]()
+        {
+            if (!self->IsClosed())
+                self->_HandleRealmListResult(*data);
+        });
+    });
+}
+
+void AuthSocket::_HandleRealmListResult(RealmListData& data)
+{
+    if (!data.accountFound)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
         Close();
-        return false;
+        return;
     }
 
-    uint32 id = (*result)[0].GetUInt32();
-    uint8 accountSecurityLevel = (*result)[1].GetUInt8();
-    delete result;
-
     ///- Update realm list if need
     sRealmList.UpdateIfNeed();
 
     ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
-    LoadRealmlist(pkt, id, accountSecurityLevel);
+    LoadRealmlist(pkt, data.characterCounts, data.accountSecurityLevel);
 
     ByteBuffer hdr;
     hdr << (uint8) CMD_REALM_LIST;
@@ -828,10 +936,9 @@ bool AuthSocket::_HandleRealmList()
     hdr.append(pkt);
 
     Write((const char*)hdr.contents(), hdr.size());
-    return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLevel)
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt, std::map<uint32, uint8> const& characterCounts, uint8 securityLevel)
 {
     switch (_build)
     {
@@ -844,18 +951,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
 
             for (const auto& i : sRealmList)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto const count = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = count != characterCounts.end() ? count->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -909,18 +1006,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
 
             for (const auto& i : sRealmList)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto const count = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = count != characterCounts.end() ? count->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -34,6 +34,7 @@
 #include <boost/asio.hpp>
 
 #include <functional>
+#include <map>
 
 #define HMAC_RES_SIZE 20
 
@@ -47,7 +48,7 @@ class AuthSocket : public MaNGOS::Socket
         bool Open() override;
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 accountSecurityLevel = 0);
+        void LoadRealmlist(ByteBuffer& pkt, std::map<uint32, uint8> const& characterCounts, uint8 accountSecurityLevel = 0);
         int32 generateToken(char const* b32key);
 
         uint8 getEligibleRealmCount(uint8 accountSecurityLevel);
@@ -65,6 +66,15 @@ class AuthSocket : public MaNGOS::Socket
         bool _HandleXferAccept();
 
     private:
+        struct LogonChallengeData;
+        struct RealmListData;
+
+        // continue handlers on the network thread once their async account lookups are done
+        void _HandleLogonChallengeResult(LogonChallengeData& data);
+        void _HandleLogonProofFailResult(QueryResult& result, uint32 maxWrongPassCount);
+        void _HandleReconnectChallengeResult(QueryResult* result);
+        void _HandleRealmListResult(RealmListData& data);
+
         enum eStatus
         {
             STATUS_CHALLENGE,
@@ -110,6 +110,8 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     }
 
     m_pingIntervallms = sConfig.GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000);
+    m_batchMaxSize = sConfig.GetIntDefault("DatabaseBatchSize", 100);
+    m_batchMaxDelayms = sConfig.GetIntDefault("DatabaseBatchDelay", 10);
 
     // create DB connections
 
@@ -321,6 +323,14 @@ QueryNamedResult* Database::PQueryNamed(const char* format, ...)
     return QueryNamed(szQuery);
 }
 
+bool Database::AsyncTask(SqlTask::Task&& task)
+{
+    if (!m_pAsyncConn || !m_threadBody)
+        return false;
+
+    return m_threadBody->Delay(new SqlTask(std::move(task)));
+}
+
 bool Database::Execute(const char* sql)
 {
     if (!m_pAsyncConn)
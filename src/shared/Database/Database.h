@@ -177,6 +177,10 @@ class Database
         template<class Class, typename ParamType1>
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1);
 
+        // run task with the async connection on the delay thread, for callers that must not block on the database
+        // unlike AsyncQuery the result is not passed through the result queue (world thread)
+        bool AsyncTask(SqlTask::Task&& task);
+
         bool Execute(const char* sql);
         bool PExecute(const char* format, ...) ATTR_PRINTF(2, 3);
 
@@ -211,6 +215,12 @@ class Database
 
         bool CheckRequiredField(char const* table_name, char const* required_name);
         uint32 GetPingIntervall() const { return m_pingIntervallms; }
+        // async write statements are grouped into transactions of up to this size, waiting at most this long
+        uint32 GetBatchMaxSize() const { return m_batchMaxSize; }
+        uint32 GetBatchMaxDelay() const { return m_batchMaxDelayms; }
+
+        // counters of the async execution thread since previous call
+        SqlDelayThreadStats GetDelayThreadStats() { return m_threadBody ? m_threadBody->CollectStats() : SqlDelayThreadStats(); }
 
         // function to ping database connections
         void Ping();
@@ -224,7 +234,7 @@ class Database
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
             m_threadBody(nullptr), m_delayThread(nullptr), m_allowAsyncTransactions(false),
-            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
+            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0), m_batchMaxSize(0), m_batchMaxDelayms(0)
         {
             m_nQueryCounter = -1;
         }
@@ -285,5 +295,7 @@ class Database
         bool m_logSQL;
         std::string m_logsDir;
         uint32 m_pingIntervallms;
+        uint32 m_batchMaxSize;
+        uint32 m_batchMaxDelayms;
 };
 #endif
@@ -19,8 +19,12 @@
 #include "Database/SqlDelayThread.h"
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
+#include "Util/Trace.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <algorithm>
+#include <chrono>
+
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_queuedReads(0), m_dbEngine(db), m_dbConnection(conn), m_running(true)
 {
 }
 
@@ -36,22 +40,35 @@ void SqlDelayThread::run()
     mysql_thread_init();
 #endif
 
-    const uint32 loopSleepms = 10;
+    Trace::SetThreadName("sql delay");
 
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    // a zero interval would turn the wait below into a busy loop, never ping more often than once a minute
+    std::chrono::milliseconds const pingInterval(std::max(m_dbEngine->GetPingIntervall(), uint32(MINUTE * IN_MILLISECONDS)));
+    std::chrono::milliseconds const batchDelay(m_dbEngine->GetBatchMaxDelay());
+    size_t const batchSize = m_dbEngine->GetBatchMaxSize();
 
-    uint32 loopCounter = 0;
+    auto nextPing = std::chrono::steady_clock::now() + pingInterval;
     while (m_running)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        MaNGOS::Thread::Sleep(loopSleepms);
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            // sleep until something is queued, stop is requested or connection needs a ping
+            m_queueCond.wait_until(lock, nextPing, [this] { return !m_sqlQueue.empty() || !m_running; });
 
+            // let more writes join the batch, but never hold the first one longer than the configured delay
+            // queries and other operations with waiting callbacks are handed over at once
+            if (!m_sqlQueue.empty() && !m_queuedReads && batchSize > 1 && batchDelay.count() > 0)
+                m_queueCond.wait_for(lock, batchDelay, [this, batchSize] { return m_sqlQueue.size() >= batchSize || m_queuedReads || !m_running; });
+        }
+
+        // if the running state gets turned off while waiting
+        // empty the queue before exiting
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextPing)
         {
-            loopCounter = 0;
+            nextPing = now + pingInterval;
             m_dbEngine->Ping();
         }
     }
@@ -63,7 +80,11 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
-    m_running = false;
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_running = false;
+    }
+    m_queueCond.notify_one();
 }
 
 void SqlDelayThread::ProcessRequests()
@@ -75,12 +96,102 @@ void SqlDelayThread::ProcessRequests()
     {
         std::lock_guard<std::mutex> guard(m_queueMutex);
         sqlQueue = std::move(m_sqlQueue);
+        m_queuedReads = 0;
     }
 
+    if (sqlQueue.empty())
+        return;
+
+    TRACE_SCOPE("SqlDelayThread::ProcessRequests");
+
+    {
+        std::lock_guard<std::mutex> guard(m_statsMutex);
+        m_stats.maxQueueDepth = std::max(m_stats.maxQueueDepth, uint32(sqlQueue.size()));
+    }
+
+    size_t const batchSize = m_dbEngine->GetBatchMaxSize();
+
+    SqlBatch batch;
     while (!sqlQueue.empty())
     {
-        auto const s = std::move(sqlQueue.front());
+        auto s = std::move(sqlQueue.front());
         sqlQueue.pop();
+
+        if (batchSize > 1 && s->IsBatchable())
+        {
+            batch.push_back(std::move(s));
+            if (batch.size() >= batchSize)
+                ExecuteBatch(batch);
+            continue;
+        }
+
+        // keep execution order, statements grouped so far must go first
+        ExecuteBatch(batch);
         s->Execute(m_dbConnection);
     }
+
+    ExecuteBatch(batch);
+}
+
+void SqlDelayThread::ExecuteBatch(SqlBatch& batch)
+{
+    if (batch.empty())
+        return;
+
+    if (batch.size() == 1)
+    {
+        batch.front()->Execute(m_dbConnection);
+        batch.clear();
+        return;
+    }
+
+    auto const startTime = std::chrono::steady_clock::now();
+    {
+        SqlConnection::Lock guard(m_dbConnection);
+
+        if (m_dbConnection->BeginTransaction())
+        {
+            // statements were queued independently, one failing must not drop the others
+            // only the failed one is undone, every statement runs exactly once (MyISAM tables ignore rollbacks anyway)
+            for (auto& s : batch)
+            {
+                bool const savepoint = m_dbConnection->Execute("SAVEPOINT batch_statement");
+                if (!s->Execute(m_dbConnection) && savepoint)
+                    m_dbConnection->Execute("ROLLBACK TO SAVEPOINT batch_statement");
+            }
+
+            if (!m_dbConnection->CommitTransaction())
+                m_dbConnection->RollbackTransaction();
+        }
+        else
+        {
+            for (auto& s : batch)
+                s->Execute(m_dbConnection);
+        }
+    }
+    uint64 const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+    {
+        std::lock_guard<std::mutex> guard(m_statsMutex);
+        ++m_stats.batches;
+        m_stats.batchedStatements += uint32(batch.size());
+        m_stats.maxBatchSize = std::max(m_stats.maxBatchSize, uint32(batch.size()));
+        m_stats.commitTimeUs += elapsed;
+        m_stats.maxCommitTimeUs = std::max(m_stats.maxCommitTimeUs, elapsed);
+    }
+
+    batch.clear();
+}
+
+SqlDelayThreadStats SqlDelayThread::CollectStats()
+{
+    SqlDelayThreadStats stats;
+    {
+        std::lock_guard<std::mutex> guard(m_statsMutex);
+        std::swap(stats, m_stats);
+    }
+
+    std::lock_guard<std::mutex> guard(m_queueMutex);
+    stats.queueDepth = uint32(m_sqlQueue.size());
+    return stats;
 }
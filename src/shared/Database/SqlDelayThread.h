@@ -23,25 +23,50 @@
 #include "SqlOperations.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 class Database;
 class SqlOperation;
 class SqlConnection;
 
+// counters of the delay thread, collected and reset by Database::GetDelayThreadStats
+struct SqlDelayThreadStats
+{
+    SqlDelayThreadStats() : queueDepth(0), maxQueueDepth(0), batches(0), batchedStatements(0), maxBatchSize(0), commitTimeUs(0), maxCommitTimeUs(0) {}
+
+    uint32 queueDepth;                                      ///< operations waiting right now
+    uint32 maxQueueDepth;                                   ///< highest queue depth seen since last collect
+    uint32 batches;                                         ///< transactions committed for grouped statements
+    uint32 batchedStatements;                               ///< statements executed inside those transactions
+    uint32 maxBatchSize;
+    uint64 commitTimeUs;                                    ///< total time spent executing grouped statements
+    uint64 maxCommitTimeUs;
+};
+
 class SqlDelayThread : public MaNGOS::Runnable
 {
+    typedef std::vector<std::unique_ptr<SqlOperation>> SqlBatch;
+
     private:
         std::mutex m_queueMutex;
+        std::condition_variable m_queueCond;                    ///< Signaled on enqueue and stop
         std::queue<std::unique_ptr<SqlOperation>> m_sqlQueue;   ///< Queue of SQL statements
+        size_t m_queuedReads;                                   ///< Queued operations that are not batchable writes, someone waits on them
         Database* m_dbEngine;                                   ///< Pointer to used Database engine
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
         std::atomic<bool> m_running;
 
+        std::mutex m_statsMutex;
+        SqlDelayThreadStats m_stats;
+
         // process all enqueued requests
         void ProcessRequests();
+        // execute grouped write statements in one transaction
+        void ExecuteBatch(SqlBatch& batch);
 
     public:
         SqlDelayThread(Database* db, SqlConnection* conn);
@@ -50,11 +75,19 @@ class SqlDelayThread : public MaNGOS::Runnable
         ///< Put sql statement to delay queue
         bool Delay(SqlOperation* sql)
         {
-            std::lock_guard<std::mutex> guard(m_queueMutex);
-            m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
+            {
+                std::lock_guard<std::mutex> guard(m_queueMutex);
+                if (!sql->IsBatchable())
+                    ++m_queuedReads;
+                m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
+            }
+            m_queueCond.notify_one();
             return true;
         }
 
+        // returns counters gathered since the previous call and resets them
+        SqlDelayThreadStats CollectStats();
+
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
 };
@@ -82,6 +82,13 @@ bool SqlPreparedRequest::Execute(SqlConnection* conn)
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+bool SqlTask::Execute(SqlConnection* conn)
+{
+    LOCK_DB_CONN(conn);
+    m_task(conn);
+    return true;
+}
+
 /// ---- ASYNC QUERIES ----
 
 bool SqlQuery::Execute(SqlConnection* conn)
@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Utilities/Callback.h"
 
+#include <functional>
 #include <queue>
 #include <vector>
 #include <mutex>
@@ -39,6 +40,8 @@ class SqlOperation
     public:
         virtual void OnRemove() { delete this; }
         virtual bool Execute(SqlConnection* conn) = 0;
+        // single write statements may be grouped by the delay thread into one transaction
+        virtual bool IsBatchable() const { return false; }
         virtual ~SqlOperation() {}
 };
 
@@ -52,6 +55,7 @@ class SqlPlainRequest : public SqlOperation
         SqlPlainRequest(const char* sql) : m_sql(mangos_strdup(sql)) {}
         ~SqlPlainRequest() { char* tofree = const_cast<char*>(m_sql); delete[] tofree; }
         bool Execute(SqlConnection* conn) override;
+        bool IsBatchable() const override { return true; }
 };
 
 class SqlTransaction : public SqlOperation
@@ -75,12 +79,28 @@ class SqlPreparedRequest : public SqlOperation
         ~SqlPreparedRequest();
 
         bool Execute(SqlConnection* conn) override;
+        bool IsBatchable() const override { return true; }
 
     private:
         const int m_nIndex;
         SqlStmtParameters* m_param;
 };
 
+/// runs arbitrary work on the async connection (several dependent queries at once)
+/// the task is called from the delay thread, it has to hand results over to its own thread
+class SqlTask : public SqlOperation
+{
+    public:
+        typedef std::function<void(SqlConnection*)> Task;
+
+        SqlTask(Task&& task) : m_task(std::move(task)) {}
+
+        bool Execute(SqlConnection* conn) override;
+
+    private:
+        Task m_task;
+};
+
 /// ---- ASYNC QUERIES ----
 
 class SqlQuery;                                             /// contains a single async query
@@ -20,6 +20,7 @@
 #define __NETWORK_THREAD_HPP_
 
 #include "Socket.hpp"
+#include "Util/Trace.h"
 
 #include <boost/asio.hpp>
 
@@ -44,7 +45,7 @@ namespace MaNGOS
             std::thread m_serviceThread;
 
         public:
-            NetworkThread() : m_work(new boost::asio::io_service::work(m_service)), m_serviceThread([this] { boost::system::error_code ec; this->m_service.run(ec); })
+            NetworkThread() : m_work(new boost::asio::io_service::work(m_service)), m_serviceThread([this] { Trace::SetThreadName("network"); boost::system::error_code ec; this->m_service.run(ec); })
             {
             }
 
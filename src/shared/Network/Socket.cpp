@@ -18,6 +18,7 @@
 
 #include "Socket.hpp"
 #include "Log.h"
+#include "Util/Trace.h"
 
 #include <boost/asio.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
@@ -92,6 +93,8 @@ namespace MaNGOS
 
     void Socket::OnRead(const boost::system::error_code& error, size_t length)
     {
+        TRACE_SCOPE("Socket::OnRead");
+
         if (error)
         {
             m_readState = ReadState::Idle;
@@ -114,6 +114,10 @@ namespace MaNGOS
             template <typename T>
             std::shared_ptr<T> shared() { return std::static_pointer_cast<T>(shared_from_this()); }
 
+            // queue handler to run on the network thread serving this socket
+            template <typename Handler>
+            void Post(Handler&& handler) { boost::asio::post(m_socket.get_executor(), std::forward<Handler>(handler)); }
+
             boost::asio::ip::address GetRemoteIpAddress() const { return m_remoteAddress; }
             uint16 GetRemotePort() const { return m_remotePort; }
 
@@ -0,0 +1,120 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _ALIAS_TABLE_H
+#define _ALIAS_TABLE_H
+
+#include "Common.h"
+#include "Util/Util.h"
+
+#include <vector>
+
+// Weighted discrete sampler (Vose's alias method)
+// Build is O(n), every Sample after that is O(1) and uses two random numbers
+class AliasTable
+{
+    public:
+        AliasTable() : m_totalWeight(0.0) {}
+
+        // weights must not be negative, entries with zero weight are never sampled
+        void Build(std::vector<double> const& weights)
+        {
+            Clear();
+
+            uint32 size = uint32(weights.size());
+            for (double weight : weights)
+                m_totalWeight += weight;
+
+            if (!size || m_totalWeight <= 0.0)
+            {
+                m_totalWeight = 0.0;
+                return;
+            }
+
+            m_probability.resize(size);
+            m_alias.resize(size);
+
+            std::vector<double> scaled(size);
+            std::vector<uint32> small, large;
+            small.reserve(size);
+            large.reserve(size);
+
+            for (uint32 i = 0; i < size; ++i)
+            {
+                scaled[i] = weights[i] * size / m_totalWeight;
+                if (scaled[i] < 1.0)
+                    small.push_back(i);
+                else
+                    large.push_back(i);
+            }
+
+            while (!small.empty() && !large.empty())
+            {
+                uint32 less = small.back();
+                small.pop_back();
+                uint32 more = large.back();
+
+                m_probability[less] = scaled[less];
+                m_alias[less] = more;
+
+                scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+                if (scaled[more] < 1.0)
+                {
+                    large.pop_back();
+                    small.push_back(more);
+                }
+            }
+
+            // whatever is left is only off from 1.0 by rounding errors
+            for (uint32 i : large)
+            {
+                m_probability[i] = 1.0;
+                m_alias[i] = i;
+            }
+            for (uint32 i : small)
+            {
+                m_probability[i] = 1.0;
+                m_alias[i] = i;
+            }
+        }
+
+        void Clear()
+        {
+            m_probability.clear();
+            m_alias.clear();
+            m_totalWeight = 0.0;
+        }
+
+        // returns the index of the chosen weight, must not be called on an empty table
+        uint32 Sample() const
+        {
+            uint32 column = urand(0, uint32(m_probability.size()) - 1);
+            return rand_norm() < m_probability[column] ? column : m_alias[column];
+        }
+
+        bool Empty() const { return m_probability.empty(); }
+        uint32 Size() const { return uint32(m_probability.size()); }
+        double GetTotalWeight() const { return m_totalWeight; }
+
+    private:
+        std::vector<double> m_probability;
+        std::vector<uint32> m_alias;
+        double m_totalWeight;
+};
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace
+{
+    namespace
+    {
+        uint32 const EVENTS_PER_THREAD = 16384;
+
+        // fields are atomic so a dump may read while the owner thread keeps writing
+        struct Event
+        {
+            std::atomic<char const*> name;
+            std::atomic<uint64> start;
+            std::atomic<uint64> duration;
+        };
+
+        struct ThreadBuffer
+        {
+            ThreadBuffer(uint32 id) : threadId(id), written(0), writing(0), events(new Event[EVENTS_PER_THREAD]()) {}
+
+            uint32 threadId;
+            std::string threadName;
+            std::atomic<uint64> written;                    // events completely written
+            std::atomic<uint64> writing;                    // events written or being written
+            std::unique_ptr<Event[]> events;
+        };
+
+        std::atomic<bool> s_enabled(false);
+        std::atomic<bool> s_dumpRequested(false);
+        std::chrono::steady_clock::time_point const s_epoch = std::chrono::steady_clock::now();
+
+        // buffers are kept until shutdown, a thread may end while a dump reads its events
+        std::mutex s_buffersLock;
+        std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+
+        // the buffer is only created on the first recorded event, named threads cost nothing while tracing is off
+        thread_local ThreadBuffer* t_buffer = nullptr;
+        thread_local std::string t_threadName;
+
+        ThreadBuffer& GetThreadBuffer()
+        {
+            if (!t_buffer)
+            {
+                std::lock_guard<std::mutex> guard(s_buffersLock);
+                s_buffers.emplace_back(new ThreadBuffer(uint32(s_buffers.size() + 1)));
+                t_buffer = s_buffers.back().get();
+                t_buffer->threadName = t_threadName;
+            }
+            return *t_buffer;
+        }
+
+        void WriteEscaped(FILE* file, char const* str)
+        {
+            for (; *str; ++str)
+            {
+                if (*str == '"' || *str == '\\')
+                    fputc('\\', file);
+                fputc(*str, file);
+            }
+        }
+    }
+
+    void SetEnabled(bool enabled)
+    {
+        s_enabled = enabled;
+    }
+
+    bool IsEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    void SetThreadName(std::string const& name)
+    {
+        t_threadName = name;
+        if (t_buffer)
+        {
+            std::lock_guard<std::mutex> guard(s_buffersLock);
+            t_buffer->threadName = name;
+        }
+    }
+
+    uint64 Now()
+    {
+        return uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_epoch).count());
+    }
+
+    void Record(char const* name, uint64 start, uint64 duration)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        uint64 index = buffer.written.load(std::memory_order_relaxed);
+        buffer.writing.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Event& event = buffer.events[index % EVENTS_PER_THREAD];
+        event.name.store(name, std::memory_order_relaxed);
+        event.start.store(start, std::memory_order_relaxed);
+        event.duration.store(duration, std::memory_order_relaxed);
+        buffer.written.store(index + 1, std::memory_order_release);
+    }
+
+    uint32 Dump(std::string const& fileName, uint64 window)
+    {
+        FILE* file = fopen(fileName.c_str(), "w");
+        if (!file)
+            return 0;
+
+        uint64 since = window && Now() > window ? Now() - window : 0;
+        uint32 count = 0;
+
+        fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+
+        std::lock_guard<std::mutex> guard(s_buffersLock);
+        for (auto const& buffer : s_buffers)
+        {
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", count ? ",\n" : "", buffer->threadId);
+            WriteEscaped(file, buffer->threadName.empty() ? "thread" : buffer->threadName.c_str());
+            fputs("\"}}", file);
+            ++count;
+
+            uint64 end = buffer->written.load(std::memory_order_acquire);
+            uint64 begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+            for (uint64 i = begin; i < end; ++i)
+            {
+                Event const& event = buffer->events[i % EVENTS_PER_THREAD];
+                char const* name = event.name.load(std::memory_order_relaxed);
+                uint64 start = event.start.load(std::memory_order_relaxed);
+                uint64 duration = event.duration.load(std::memory_order_relaxed);
+
+                // the owner thread went on writing and may have overwritten this slot meanwhile
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (buffer->writing.load(std::memory_order_relaxed) - i > EVENTS_PER_THREAD)
+                    continue;
+
+                if (!name || start + duration < since)
+                    continue;
+
+                fputs(",\n{\"name\":\"", file);
+                WriteEscaped(file, name);
+                fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":" UI64FMTD ",\"dur\":" UI64FMTD "}", buffer->threadId, start, duration);
+                ++count;
+            }
+        }
+
+        fputs("\n]}\n", file);
+        fclose(file);
+        return count;
+    }
+
+    void RequestDump()
+    {
+        s_dumpRequested = true;
+    }
+
+    bool ConsumeDumpRequest()
+    {
+        return s_dumpRequested.exchange(false);
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include "Common.h"
+
+#include <string>
+
+// Scoped timeline events kept in a fixed ring buffer per thread and written out on demand as
+// Chrome trace event JSON (chrome://tracing, ui.perfetto.dev)
+// Recording takes no locks, a thread only locks once to create and register its buffer on its first event
+namespace Trace
+{
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    // names the calling thread in dumps
+    void SetThreadName(std::string const& name);
+
+    // microseconds on the trace clock
+    uint64 Now();
+    // name must outlive the dump, string literals only
+    void Record(char const* name, uint64 start, uint64 duration);
+
+    // writes the events of all threads that ended within the last window microseconds (0 - all), returns the event count
+    uint32 Dump(std::string const& fileName, uint64 window = 0);
+
+    // async signal safe, polled by the world thread
+    void RequestDump();
+    bool ConsumeDumpRequest();
+
+    class Scope
+    {
+        public:
+            explicit Scope(char const* name) : m_name(IsEnabled() ? name : nullptr), m_start(m_name ? Now() : 0) {}
+            ~Scope()
+            {
+                if (m_name)
+                    Record(m_name, m_start, Now() - m_start);
+            }
+
+            Scope(Scope const&) = delete;
+            Scope& operator=(Scope const&) = delete;
+
+        private:
+            char const* m_name;
+            uint64 m_start;
+    };
+}
+
+#define TRACE_SCOPE_NAME(line) traceScope ## line
+#define TRACE_SCOPE_LINE(name, line) Trace::Scope TRACE_SCOPE_NAME(line)(name)
+#define TRACE_SCOPE(name) TRACE_SCOPE_LINE(name, __LINE__)
+
+#endif
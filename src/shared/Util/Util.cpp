@@ -23,8 +23,11 @@
 
 #include <boost/asio.hpp>
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <cstdarg>
+#include <limits>
 
 std::mt19937* initRand()
 {
@@ -139,6 +142,120 @@ Tokens StrSplit(const std::string& src, const std::string& sep)
     return r;
 }
 
+// Binary number lists are a sequence of tokens, each stored in 6 bit groups lowest first, one group per byte:
+// 0x80 | (0x40 if another group follows) | group. A token t = 2 * v + 2 is the value v,
+// an odd token t = 2 * n + 1 is a run of n zeros (the dominant value in explored zones and titles)
+static uint8 const NUMBER_LIST_BINARY_FLAG = 0x80;
+static uint8 const NUMBER_LIST_BINARY_MORE = 0x40;
+static uint8 const NUMBER_LIST_BINARY_BITS = 6;
+
+static void AppendNumberListToken(std::string& dest, uint64 token)
+{
+    do
+    {
+        uint8 byte = NUMBER_LIST_BINARY_FLAG | (token & (NUMBER_LIST_BINARY_MORE - 1));
+        token >>= NUMBER_LIST_BINARY_BITS;
+        if (token)
+            byte |= NUMBER_LIST_BINARY_MORE;
+        dest.push_back(char(byte));
+    }
+    while (token);
+}
+
+static uint32 ParseUInt32ListBinary(uint8 const* data, uint32* values, uint32 count)
+{
+    uint32 found = 0;
+    while (*data)
+    {
+        uint64 token = 0;
+        for (uint32 shift = 0;; shift += NUMBER_LIST_BINARY_BITS)
+        {
+            uint8 byte = *data;
+            // text after binary or a token longer than any valid one, count what was read so far
+            if (!(byte & NUMBER_LIST_BINARY_FLAG) || shift > 30)
+                return found;
+            token |= uint64(byte & (NUMBER_LIST_BINARY_MORE - 1)) << shift;
+            ++data;
+            if (!(byte & NUMBER_LIST_BINARY_MORE))
+                break;
+        }
+
+        if (token & 1)
+        {
+            uint64 zeros = token >> 1;
+            for (; zeros && found < count; --zeros)
+                values[found++] = 0;
+            found = uint32(std::min<uint64>(found + zeros, std::numeric_limits<uint32>::max()));
+        }
+        else
+        {
+            if (found < count)
+                values[found] = uint32((token >> 1) - 1);
+            ++found;
+        }
+    }
+    return found;
+}
+
+uint32 ParseUInt32List(char const* data, uint32* values, uint32 count)
+{
+    if (uint8(*data) & NUMBER_LIST_BINARY_FLAG)
+        return ParseUInt32ListBinary(reinterpret_cast<uint8 const*>(data), values, count);
+
+    uint32 found = 0;
+    while (*data)
+    {
+        if (*data == ' ')
+        {
+            ++data;
+            continue;
+        }
+
+        // same result as atol on a token, including wrap around of negative numbers
+        char* end;
+        unsigned long value = strtoul(data, &end, 10);
+        if (found < count)
+            values[found] = uint32(value);
+        ++found;
+
+        data = end;
+        while (*data && *data != ' ')
+            ++data;
+    }
+    return found;
+}
+
+void AppendUInt32List(std::string& dest, uint32 const* values, uint32 count, bool binary)
+{
+    if (binary)
+    {
+        for (uint32 i = 0; i < count;)
+        {
+            uint32 zeros = 0;
+            while (i + zeros < count && !values[i + zeros])
+                ++zeros;
+
+            if (zeros)
+            {
+                AppendNumberListToken(dest, uint64(zeros) * 2 + 1);
+                i += zeros;
+            }
+            else
+                AppendNumberListToken(dest, uint64(values[i++]) * 2 + 2);
+        }
+        return;
+    }
+
+    char buffer[11];
+    dest.reserve(dest.size() + count * 4);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        char* end = std::to_chars(buffer, buffer + sizeof(buffer), values[i]).ptr;
+        *end++ = ' ';
+        dest.append(buffer, end);
+    }
+}
+
 uint32 GetUInt32ValueFromArray(Tokens const& data, uint16 index)
 {
     if (index >= data.size())
@@ -31,6 +31,14 @@ Tokens StrSplit(const std::string& src, const std::string& sep);
 uint32 GetUInt32ValueFromArray(Tokens const& data, uint16 index);
 float GetFloatValueFromArray(Tokens const& data, uint16 index);
 
+// space separated number lists as stored in character and item blob columns, without building a Tokens vector
+// lists in the binary format of AppendUInt32List are detected by their first byte, so a column may hold both
+// stores up to count numbers and returns how many were found
+uint32 ParseUInt32List(char const* data, uint32* values, uint32 count);
+// appends every value followed by a space, or in the compact binary format if binary is set
+// binary lists only use bytes 0x80-0xFF (no null, quote or backslash) but need blob columns
+void AppendUInt32List(std::string& dest, uint32 const* values, uint32 count, bool binary = false);
+
 void stripLineInvisibleChars(std::string& str);
 
 time_t GetLocalHourTimestamp(time_t time, uint8 hour, bool onlyAfterTime = true);
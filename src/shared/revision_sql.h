@@ -2,6 +2,6 @@
 #define __REVISION_SQL_H__
  #define REVISION_DB_REALMD "required_14064_01_realmd_platform"
  #define REVISION_DB_LOGS "required_14039_01_logs_anticheat"
- #define REVISION_DB_CHARACTERS "required_14061_01_characters_fishingSteps"
+ #define REVISION_DB_CHARACTERS "required_14081_01_characters_number_list_blobs"
  #define REVISION_DB_MANGOS "required_14080_01_mangos_pursuit"
 #endif // __REVISION_SQL_H__